@@ -0,0 +1,29 @@
+// i3-ipc++ headers.
+#include "i3_ipc.hpp"
+#include "i3_containers.hpp"
+
+// C++ headers.
+#include <iostream>
+
+int main()
+{
+    // Create IPC object and connect it to running i3 process.
+    i3_ipc i3;
+
+    // Subscribe to window and workspace events. Callbacks aren't called for batched events, so they are left empty.
+    i3.on_window_event([](const i3_containers::window_event&) -> void {});
+    i3.on_workspace_event([](const i3_containers::workspace_event&) -> void {});
+
+    // Handle all available events at once and redraw only once per batch.
+    while (true)
+    {
+        i3.handle_pending_events([](const i3_containers::event_batch& a_batch) -> void
+                                 {
+                                     std::cout << "Redrawing after " << a_batch.window_events.size()
+                                               << " window and " << a_batch.workspace_events.size()
+                                               << " workspace events." << std::endl;
+                                 });
+    }
+
+    return 0;
+}
@@ -0,0 +1,46 @@
+// i3-ipc++ headers.
+#include "i3_ipc.hpp"
+#include "i3_containers.hpp"
+#include "i3_ipc_queue_overflow.hpp"
+
+// C++ headers.
+#include <iostream>
+
+int main()
+{
+    // Create IPC object and connect it to running i3 process.
+    i3_ipc i3;
+
+    // Keep at most 64 events or 1 MiB of their payloads while the workspaces are fetched and drop all of them at once
+    // when limits are reached, since the list of workspaces can be fetched again cheaply.
+    i3.set_event_queue_limits(i3_ipc::event_queue_limits{ 64, 1024 * 1024, i3_ipc::overflow_policy::resync, {} });
+
+    std::size_t workspaces = i3.get_workspaces().size();
+    i3.on_workspace_event([&](const i3_containers::workspace_event& a_event) -> void
+                          {
+                              if (a_event.change == i3_containers::workspace_change::init)
+                              {
+                                  ++workspaces;
+                              }
+                              else if (a_event.change == i3_containers::workspace_change::empty)
+                              {
+                                  --workspaces;
+                              }
+                              std::cout << "There are " << workspaces << " workspaces." << std::endl;
+                          });
+
+    while (true)
+    {
+        try
+        {
+            i3.handle_next_event();
+        }
+        catch (const i3_ipc_queue_overflow&)
+        {
+            // Some events were lost, so the count is fetched again.
+            workspaces = i3.get_workspaces().size();
+        }
+    }
+
+    return 0;
+}
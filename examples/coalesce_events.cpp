@@ -0,0 +1,33 @@
+// i3-ipc++ headers.
+#include "i3_ipc.hpp"
+#include "i3_containers.hpp"
+
+// C++ headers.
+#include <chrono>
+#include <iostream>
+
+int main()
+{
+    // Create IPC object and connect it to running i3 process.
+    i3_ipc i3;
+
+    // Collect events for 50 ms after each received one and keep only the latest title/move event of each window.
+    i3.set_event_coalescing(std::chrono::milliseconds(50));
+
+    // Print the title of windows, at most once per burst of title changes.
+    i3.on_window_event([](const i3_containers::window_event& a_event) -> void
+                       {
+                           if (a_event.change == i3_containers::window_change::title)
+                           {
+                               std::cout << "Window " << a_event.container.id << " is now titled \""
+                                         << a_event.container.name.value_or("") << "\"." << std::endl;
+                           }
+                       });
+
+    while (true)
+    {
+        i3.handle_next_event();
+    }
+
+    return 0;
+}
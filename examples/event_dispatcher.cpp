@@ -0,0 +1,47 @@
+// i3-ipc++ headers.
+#include "i3_containers.hpp"
+#include "i3_event_dispatcher.hpp"
+
+// C++ headers.
+#include <cstddef>
+#include <iostream>
+
+// Handler with one overload for each event type it is interested in.
+struct event_counter
+{
+    void operator()(const i3_containers::workspace_event& a_event)
+    {
+        ++workspace_events;
+        if (a_event.change == i3_containers::workspace_change::focus)
+        {
+            std::cout << "Workspace focused." << std::endl;
+        }
+    }
+
+    void operator()(const i3_containers::window_event& a_event)
+    {
+        ++window_events;
+        std::cout << "Window " << a_event.container.id << " changed." << std::endl;
+    }
+
+    std::size_t workspace_events = 0;
+    std::size_t window_events = 0;
+};
+
+int main()
+{
+    // Connect to running i3 process and subscribe to workspace and window events with single request.
+    i3_event_dispatcher<event_counter, i3_containers::workspace_event, i3_containers::window_event> dispatcher;
+
+    // Handle events, calling the handler directly for each of them.
+    while (true)
+    {
+        dispatcher.handle_next_event();
+
+        const event_counter& counter = dispatcher.get_handler();
+        std::cout << "Handled " << counter.workspace_events << " workspace and " << counter.window_events
+                  << " window events." << std::endl;
+    }
+
+    return 0;
+}
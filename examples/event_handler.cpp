@@ -0,0 +1,42 @@
+// i3-ipc++ headers.
+#include "i3_ipc.hpp"
+#include "i3_containers.hpp"
+
+// C++ headers.
+#include <cstddef>
+#include <iostream>
+#include <functional>
+
+// Handler object whose state is updated on every window event.
+struct title_counter
+{
+    void operator()(const i3_containers::window_event& a_event)
+    {
+        if (a_event.change == i3_containers::window_change::title)
+        {
+            ++title_changes;
+        }
+    }
+
+    std::size_t title_changes = 0;
+};
+
+int main()
+{
+    // Create IPC object and connect it to running i3 process.
+    i3_ipc i3;
+
+    // Register the handler by reference. It is neither copied nor wrapped in std::function, so it must outlive the
+    // subscription.
+    title_counter counter;
+    i3.on_window_event(std::ref(counter));
+
+    // Handle window events and print how many titles were changed so far.
+    while (true)
+    {
+        i3.handle_next_event();
+        std::cout << "Title changes: " << counter.title_changes << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,42 @@
+// i3-ipc++ headers.
+#include "i3_ipc.hpp"
+#include "i3_containers.hpp"
+#include "i3_focus_history.hpp"
+
+// C++ headers.
+#include <cstdint>
+#include <iostream>
+
+int main()
+{
+    // Create IPC object and connect it to running i3 process.
+    i3_ipc i3;
+
+    // Start from the focus order of the current tree.
+    i3_containers::focus_history history(i3.get_tree());
+
+    // Keep the history up to date.
+    i3.on_workspace_event([&history](const i3_containers::workspace_event& a_event) -> void
+                          {
+                              history.handle_event(a_event);
+                          });
+    i3.on_window_event([&history](const i3_containers::window_event& a_event) -> void
+                       {
+                           history.handle_event(a_event);
+                       });
+
+    // Print the order of windows, as alt-tab would show it, after every event.
+    while (true)
+    {
+        i3.handle_next_event();
+
+        std::cout << "Windows, most recently used first:";
+        for (const std::uint64_t id : history.get_order())
+        {
+            std::cout << " " << id;
+        }
+        std::cout << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,52 @@
+// i3-ipc++ headers.
+#include "i3_ipc.hpp"
+#include "i3_containers.hpp"
+#include "i3_compact_node.hpp"
+#include "i3_string_pool.hpp"
+
+// C++ headers.
+#include <memory>
+#include <cstddef>
+#include <iostream>
+
+// Recursively count all nodes in given tree.
+std::size_t count_nodes(const i3_containers::compact_node& a_node)
+{
+    std::size_t count = 1;
+    for (const auto& node : a_node.get_nodes())
+    {
+        count += count_nodes(node);
+    }
+    for (const auto& floating_node : a_node.get_floating_nodes())
+    {
+        count += count_nodes(floating_node);
+    }
+
+    return count;
+}
+
+int main()
+{
+    // Create IPC object and connect it to running i3 process.
+    i3_ipc i3;
+
+    // Share one pool between all compact trees, so that window classes and marks are stored only once.
+    i3.set_string_pool(std::make_shared<i3_containers::string_pool>());
+
+    // Get info about internal node tree in i3, stored as compact nodes.
+    const i3_containers::compact_node tree = i3.get_compact_tree();
+
+    std::cout << "Tree has " << count_nodes(tree) << " nodes." << std::endl;
+    std::cout << "Size of node: " << sizeof(i3_containers::node) << " bytes, size of compact node: "
+              << sizeof(i3_containers::compact_node) << " bytes." << std::endl;
+
+    // Compact node can always be converted back to the regular one.
+    const i3_containers::node root = tree.to_node();
+    std::cout << "Root node has " << root.nodes.size() << " outputs." << std::endl;
+
+    // Strings seen in the previous snapshot are not stored again.
+    const i3_containers::compact_node next_tree = i3.get_compact_tree();
+    std::cout << "Both snapshots share " << i3.get_string_pool()->size() << " distinct strings." << std::endl;
+
+    return 0;
+}
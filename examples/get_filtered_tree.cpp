@@ -0,0 +1,52 @@
+// i3-ipc++ headers.
+#include "i3_ipc.hpp"
+#include "i3_containers.hpp"
+
+// C++ headers.
+#include <string>
+#include <iostream>
+
+// Recursively print names of all nodes in given tree.
+void print_names(const i3_containers::node& a_node, const std::string& a_indent = "")
+{
+    std::cout << a_indent << a_node.name.value_or("<unnamed>") << std::endl;
+
+    for (const auto& node : a_node.nodes)
+    {
+        print_names(node, a_indent + "\t");
+    }
+    for (const auto& floating_node : a_node.floating_nodes)
+    {
+        print_names(floating_node, a_indent + "\t");
+    }
+}
+
+int main()
+{
+    // Create IPC object and connect it to running i3 process.
+    i3_ipc i3;
+
+    // Skip the internal "__i3" output (scratchpad) and dockareas of real outputs.
+    // Rejected subtrees are skipped while the response is parsed, which is cheaper than filtering the tree afterwards.
+    const i3_containers::node tree = i3.get_tree([](const i3_containers::node& a_node,
+                                                    const i3_containers::node&) -> bool
+                                                 {
+                                                     switch (a_node.type)
+                                                     {
+                                                         case i3_containers::node_type::output:
+                                                             return a_node.name != "__i3";
+
+                                                         case i3_containers::node_type::dockarea:
+                                                             return false;
+
+                                                         default:
+                                                             return true;
+                                                     }
+                                                 }
+                                                );
+
+    // Print the pruned tree.
+    print_names(tree);
+
+    return 0;
+}
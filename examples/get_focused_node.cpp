@@ -0,0 +1,37 @@
+// i3-ipc++ headers.
+#include "i3_ipc.hpp"
+#include "i3_containers.hpp"
+
+// C++ headers.
+#include <optional>
+#include <iostream>
+
+int main()
+{
+    // Create IPC object and connect it to running i3 process.
+    i3_ipc i3;
+
+    // Get the focused node and its ancestors without storing the rest of the tree.
+    const std::optional<i3_containers::focus_path> focus_path = i3.get_focused_node();
+    if (!focus_path)
+    {
+        std::cout << "Nothing is focused." << std::endl;
+        return 0;
+    }
+
+    // Print the path from the root node to the focused node.
+    for (const auto& ancestor : focus_path->ancestors)
+    {
+        std::cout << ancestor.name.value_or("<unnamed>") << " > ";
+    }
+    std::cout << focus_path->focused.name.value_or("<unnamed>") << std::endl;
+
+    // Print title of the X11 window, if there is one.
+    const i3_containers::node& focused_node = focus_path->focused;
+    if (focused_node.window_properties && focused_node.window_properties->window_title)
+    {
+        std::cout << "Window title: " << *focused_node.window_properties->window_title << std::endl;
+    }
+
+    return 0;
+}
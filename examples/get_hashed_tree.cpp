@@ -0,0 +1,43 @@
+// i3-ipc++ headers.
+#include "i3_ipc.hpp"
+#include "i3_containers.hpp"
+#include "i3_hashed_tree.hpp"
+
+// C++ headers.
+#include <chrono>
+#include <thread>
+#include <iostream>
+
+int main()
+{
+    // Create IPC object and connect it to running i3 process.
+    i3_ipc i3;
+
+    // Take two hashed snapshots of internal node tree in i3, one second apart.
+    const i3_containers::hashed_tree old_tree = i3.get_hashed_tree();
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    const i3_containers::hashed_tree new_tree = i3.get_hashed_tree();
+
+    if (old_tree.get_hash() == new_tree.get_hash())
+    {
+        std::cout << "Nothing has changed." << std::endl;
+        return 0;
+    }
+
+    // Find workspaces whose subtree changed, comparing one hash per workspace.
+    for (const auto& entry : new_tree.get_entries())
+    {
+        if (entry.tree_node->type != i3_containers::node_type::workspace)
+        {
+            continue;
+        }
+
+        const auto old_position = old_tree.find(entry.tree_node->id);
+        if (!old_position || old_tree.get_entries()[*old_position].hash != entry.hash)
+        {
+            std::cout << "Workspace " << entry.tree_node->name.value_or("") << " changed." << std::endl;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,43 @@
+// i3-ipc++ headers.
+#include "i3_ipc.hpp"
+#include "i3_containers.hpp"
+
+// C++ headers.
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+
+// Recursively count all nodes in given tree.
+std::size_t count_nodes(const i3_containers::node& a_node)
+{
+    std::size_t count = 1;
+    for (const auto& node : a_node.nodes)
+    {
+        count += count_nodes(node);
+    }
+    for (const auto& floating_node : a_node.floating_nodes)
+    {
+        count += count_nodes(floating_node);
+    }
+
+    return count;
+}
+
+int main()
+{
+    // Create IPC object and connect it to running i3 process.
+    i3_ipc i3;
+
+    // Parse workspaces on a pool of worker threads, using all hardware threads.
+    i3.set_tree_parsing_threads(0);
+
+    // Get info about internal node tree in i3 and measure how long it took.
+    const auto start = std::chrono::steady_clock::now();
+    const i3_containers::node tree = i3.get_tree();
+    const auto duration = std::chrono::steady_clock::now() - start;
+
+    std::cout << "Parsed " << count_nodes(tree) << " nodes with " << i3.get_tree_parsing_threads() << " threads in "
+              << std::chrono::duration_cast<std::chrono::microseconds>(duration).count() << " us." << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,46 @@
+// i3-ipc++ headers.
+#include "i3_ipc.hpp"
+#include "i3_pmr_containers.hpp"
+
+// C++ headers.
+#include <cstddef>
+#include <iostream>
+#include <memory_resource>
+
+// Recursively count windows in given tree.
+std::size_t count_windows(const i3_containers::pmr::node& a_node)
+{
+    std::size_t count = a_node.window ? 1 : 0;
+    for (const auto& node : a_node.nodes)
+    {
+        count += count_windows(node);
+    }
+    for (const auto& floating_node : a_node.floating_nodes)
+    {
+        count += count_windows(floating_node);
+    }
+
+    return count;
+}
+
+int main()
+{
+    // Create IPC object and connect it to running i3 process.
+    i3_ipc i3;
+
+    // Reuse one buffer for every refresh, so that the tree doesn't touch the heap once the buffer is big enough.
+    std::pmr::monotonic_buffer_resource arena(1 << 20);
+    for (int refresh = 0; refresh < 3; ++refresh)
+    {
+        {
+            // Every string and container of the tree is allocated from the arena.
+            const i3_containers::pmr::node tree = i3.get_tree(&arena);
+            std::cout << "Refresh " << refresh << ": " << count_windows(tree) << " windows." << std::endl;
+        }
+
+        // Whole tree is dropped at once, without freeing its nodes one by one.
+        arena.release();
+    }
+
+    return 0;
+}
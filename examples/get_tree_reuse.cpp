@@ -0,0 +1,27 @@
+// i3-ipc++ headers.
+#include "i3_ipc.hpp"
+#include "i3_containers.hpp"
+
+// C++ headers.
+#include <chrono>
+#include <thread>
+#include <iostream>
+
+int main()
+{
+    // Create IPC object and connect it to running i3 process.
+    i3_ipc i3;
+
+    // Keep one tree for the whole program and overwrite it on every refresh.
+    // Strings and vectors keep their capacity, so refreshes of unchanged layout don't allocate new nodes.
+    i3_containers::node tree;
+    for (int refresh = 0; refresh < 5; ++refresh)
+    {
+        i3.get_tree(tree);
+        std::cout << "Refresh " << refresh << ": " << tree.nodes.size() << " outputs." << std::endl;
+
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+
+    return 0;
+}
@@ -0,0 +1,26 @@
+// i3-ipc++ headers.
+#include "i3_ipc.hpp"
+#include "i3_containers.hpp"
+
+// C++ headers.
+#include <vector>
+#include <iostream>
+
+int main()
+{
+    // Create IPC object and connect it to running i3 process.
+    i3_ipc i3;
+
+    // Get every window without building the node tree.
+    const std::vector<i3_containers::window_info> windows = i3.get_windows();
+
+    // Print where each window is.
+    for (const auto& window : windows)
+    {
+        std::cout << (window.is_focused ? "* " : "  ") << window.window_class.value_or("?") << " \""
+                  << window.window_title.value_or("") << "\" on workspace " << window.workspace.value_or("-")
+                  << " of output " << window.output << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,43 @@
+// i3-ipc++ headers.
+#include "i3_ipc.hpp"
+#include "i3_containers.hpp"
+#include "i3_tree_iterator.hpp"
+
+// C++ headers.
+#include <string>
+#include <iostream>
+#include <iterator>
+#include <algorithm>
+
+int main()
+{
+    // Create IPC object and connect it to running i3 process.
+    i3_ipc i3;
+
+    // Get info about internal node tree in i3.
+    const i3_containers::node tree = i3.get_tree();
+
+    // Print the tree in pre-order, indented by depth.
+    const i3_containers::tree_range nodes = i3_containers::pre_order(tree);
+    for (auto node = nodes.begin(); node != nodes.end(); ++node)
+    {
+        std::cout << std::string(2 * node.get_depth(), ' ') << node->id << " " << node->name.value_or("") << std::endl;
+    }
+
+    // Ranges work with standard algorithms too.
+    const auto windows = i3_containers::leaf_windows(tree);
+    std::cout << "Windows: " << std::distance(windows.begin(), windows.end()) << std::endl;
+
+    // The most recently focused window is the first window in focus order.
+    const auto by_focus = i3_containers::focus_order(tree);
+    const auto focused = std::find_if(by_focus.begin(), by_focus.end(), [](const i3_containers::node& a_node) -> bool
+                                                                        {
+                                                                            return a_node.window.has_value();
+                                                                        });
+    if (focused != by_focus.end())
+    {
+        std::cout << "Most recently focused window: " << focused->name.value_or("") << std::endl;
+    }
+
+    return 0;
+}
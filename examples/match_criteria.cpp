@@ -0,0 +1,40 @@
+// i3-ipc++ headers.
+#include "i3_ipc.hpp"
+#include "i3_criteria.hpp"
+#include "i3_containers.hpp"
+
+// C++ headers.
+#include <cstdint>
+#include <iostream>
+
+int main(int argc, char* argv[])
+{
+    // Criteria are compiled once and then reused for every tree and event.
+    const i3_containers::criteria rule(argc > 1 ? argv[1] : "[class=\"(?i)firefox\"]");
+
+    // Create IPC object and connect it to running i3 process.
+    i3_ipc i3;
+
+    // Find matching containers in the current tree.
+    for (const std::uint64_t id : rule.find(i3.get_tree()))
+    {
+        std::cout << "Container " << id << " matches." << std::endl;
+    }
+
+    // Check every new window against the same criteria. Event doesn't tell where the window is in the tree, so
+    // criteria "workspace", "floating" and "tiling" are rejected here.
+    i3.on_window_event([&rule](const i3_containers::window_event& a_event) -> void
+                       {
+                           if (a_event.change == i3_containers::window_change::create
+                               && rule.matches(a_event.container))
+                           {
+                               std::cout << "New window " << a_event.container.id << " matches." << std::endl;
+                           }
+                       });
+    while (true)
+    {
+        i3.handle_next_event();
+    }
+
+    return 0;
+}
@@ -0,0 +1,73 @@
+// i3-ipc++ headers.
+#include "i3_ipc.hpp"
+#include "i3_containers.hpp"
+#include "i3_persistent_tree.hpp"
+
+// C++ headers.
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <iostream>
+
+// Recursively count all nodes in given persistent tree.
+std::size_t count_nodes(const i3_containers::persistent_node& a_node)
+{
+    std::size_t count = 1;
+    for (const auto& node : a_node.get_nodes())
+    {
+        count += count_nodes(*node);
+    }
+    for (const auto& floating_node : a_node.get_floating_nodes())
+    {
+        count += count_nodes(*floating_node);
+    }
+
+    return count;
+}
+
+int main()
+{
+    // Create IPC object and connect it to running i3 process.
+    i3_ipc i3;
+
+    // Keep the last three versions of the tree.
+    i3_containers::snapshot_store store(3);
+    store.publish(i3.get_persistent_tree());
+
+    // Readers take the current version without copying it and without waiting for the writer.
+    std::atomic<bool> is_running(true);
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 2; ++i)
+    {
+        readers.emplace_back([&]()
+                             {
+                                 while (is_running)
+                                 {
+                                     const auto snapshot = store.get_current();
+                                     std::cout << count_nodes(*snapshot) << " nodes\n";
+                                     std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                                 }
+                             });
+    }
+
+    // Writer renames the root in a new version, which shares every other node with the previous one.
+    const auto snapshot = store.get_current();
+    store.publish(snapshot->update(snapshot->get_info().id, [](i3_containers::node& a_node)
+                                                            {
+                                                                a_node.name = "renamed root";
+                                                            }));
+    store.publish(i3.get_persistent_tree());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    is_running = false;
+    for (auto& reader : readers)
+    {
+        reader.join();
+    }
+
+    std::cout << "Store keeps " << store.get_history().size() << " versions." << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,55 @@
+// i3-ipc++ headers.
+#include "i3_ipc.hpp"
+#include "i3_containers.hpp"
+#include "i3_tree_diff.hpp"
+
+// C++ headers.
+#include <chrono>
+#include <thread>
+#include <iostream>
+
+int main()
+{
+    // Create IPC object and connect it to running i3 process.
+    i3_ipc i3;
+
+    // Take two snapshots of internal node tree in i3, one second apart.
+    const i3_containers::node old_tree = i3.get_tree();
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    const i3_containers::node new_tree = i3.get_tree();
+
+    // Print what changed in the meantime.
+    for (const auto& change : i3_containers::tree_diff(old_tree, new_tree))
+    {
+        switch (change.kind)
+        {
+            case i3_containers::node_change::type::added:
+                std::cout << "Added node " << change.id << " to " << change.parent_id << std::endl;
+                break;
+
+            case i3_containers::node_change::type::removed:
+                std::cout << "Removed node " << change.id << " from " << change.parent_id << std::endl;
+                break;
+
+            case i3_containers::node_change::type::reparented:
+                std::cout << "Moved node " << change.id << " from " << change.old_parent_id << " to "
+                          << change.parent_id << std::endl;
+                break;
+
+            case i3_containers::node_change::type::changed:
+                std::cout << "Changed node " << change.id;
+                if (change.changed_fields & i3_containers::node_change::name_field)
+                {
+                    std::cout << " (renamed)";
+                }
+                if (change.changed_fields & i3_containers::node_change::rect_field)
+                {
+                    std::cout << " (resized)";
+                }
+                std::cout << std::endl;
+                break;
+        }
+    }
+
+    return 0;
+}
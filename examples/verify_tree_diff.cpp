@@ -0,0 +1,91 @@
+// i3-ipc++ headers.
+#include "i3_ipc.hpp"
+#include "i3_containers.hpp"
+#include "i3_tree_diff.hpp"
+#include "i3_hashed_tree.hpp"
+
+// C++ headers.
+#include <vector>
+#include <utility>
+#include <iostream>
+#include <string_view>
+
+// Find the first tiling container of X11 window and its parent.
+std::pair<i3_containers::node*, std::size_t> find_window(i3_containers::node& a_node)
+{
+    for (std::size_t i = 0; i < a_node.nodes.size(); ++i)
+    {
+        if (a_node.nodes[i].window)
+        {
+            return { &a_node, i };
+        }
+
+        const std::pair<i3_containers::node*, std::size_t> window = find_window(a_node.nodes[i]);
+        if (window.first)
+        {
+            return window;
+        }
+    }
+
+    return { nullptr, 0 };
+}
+
+// Print whether both diffs found the same changes, in the same order.
+bool check_same_changes(std::string_view a_name, const std::vector<i3_containers::node_change>& a_expected,
+                        const std::vector<i3_containers::node_change>& a_changes)
+{
+    bool is_same = a_expected.size() == a_changes.size();
+    for (std::size_t i = 0; is_same && i < a_changes.size(); ++i)
+    {
+        is_same = a_expected[i].kind == a_changes[i].kind && a_expected[i].id == a_changes[i].id &&
+                  a_expected[i].parent_id == a_changes[i].parent_id &&
+                  a_expected[i].old_parent_id == a_changes[i].old_parent_id &&
+                  a_expected[i].changed_fields == a_changes[i].changed_fields;
+    }
+    std::cout << a_name << ": " << (is_same ? "OK" : "FAILED") << " (" << a_expected.size() << " changes)"
+              << std::endl;
+
+    return is_same;
+}
+
+int main()
+{
+    // Create IPC object and connect it to running i3 process.
+    i3_ipc i3;
+
+    // Capture the tree once, so that both diffs compare exactly the same snapshots.
+    const i3_containers::node old_tree = i3.get_tree();
+
+    // Change the captured tree: rename one window and move it to the root, remove the next one and add a new one.
+    i3_containers::node new_tree = old_tree;
+    std::pair<i3_containers::node*, std::size_t> window = find_window(new_tree);
+    if (window.first)
+    {
+        i3_containers::node moved_window = std::move(window.first->nodes[window.second]);
+        window.first->nodes.erase(window.first->nodes.begin() + static_cast<std::ptrdiff_t>(window.second));
+        moved_window.name = "Renamed window";
+
+        i3_containers::node added_window = moved_window;
+        added_window.id = 1;
+        new_tree.nodes.push_back(std::move(moved_window));
+        new_tree.nodes.push_back(std::move(added_window));
+    }
+    window = find_window(new_tree);
+    if (window.first && window.first != &new_tree)
+    {
+        window.first->nodes.erase(window.first->nodes.begin() + static_cast<std::ptrdiff_t>(window.second));
+    }
+
+    // Diff of hashed trees skips unchanged subtrees, but it must find the same changes as diff of regular trees.
+    const i3_containers::hashed_tree old_hashed_tree(old_tree);
+    const i3_containers::hashed_tree new_hashed_tree(new_tree);
+    bool is_ok = true;
+    is_ok &= check_same_changes("Unchanged tree", i3_containers::tree_diff(old_tree, old_tree),
+                                i3_containers::tree_diff(old_hashed_tree, old_hashed_tree));
+    is_ok &= check_same_changes("Changed tree", i3_containers::tree_diff(old_tree, new_tree),
+                                i3_containers::tree_diff(old_hashed_tree, new_hashed_tree));
+    is_ok &= check_same_changes("Reverted tree", i3_containers::tree_diff(new_tree, old_tree),
+                                i3_containers::tree_diff(new_hashed_tree, old_hashed_tree));
+
+    return is_ok ? 0 : 1;
+}
@@ -0,0 +1,50 @@
+// i3-ipc++ headers.
+#include "i3_ipc.hpp"
+#include "i3_containers.hpp"
+#include "i3_tree_diff.hpp"
+
+// C++ headers.
+#include <iostream>
+#include <string_view>
+
+// Print whether two trees are the same, which is when diff finds no changes between them.
+bool check_same_tree(std::string_view a_name, const i3_containers::node& a_expected, const i3_containers::node& a_tree)
+{
+    const std::size_t changes = i3_containers::tree_diff(a_expected, a_tree).size();
+    std::cout << a_name << ": " << (changes == 0 ? "OK" : "FAILED") << " (" << changes << " changes)" << std::endl;
+
+    return changes == 0;
+}
+
+int main()
+{
+    // Create IPC object and connect it to running i3 process.
+    // NOTE: Trees are fetched one after another, so i3 should be idle while this runs.
+    i3_ipc i3;
+
+    // Tree parsed by a single thread while it is read from the socket is the reference.
+    const i3_containers::node tree = i3.get_tree();
+    bool is_ok = true;
+
+    // Workspaces are parsed in parallel by a pool of workers, on every hardware thread.
+    i3.set_tree_parsing_threads(0);
+    is_ok &= check_same_tree("Parallel parse", tree, i3.get_tree());
+    i3.set_tree_parsing_threads(1);
+
+    // Tree is parsed in place of another tree, whose nodes are reused. Its nodes are moved around first, so that
+    // the reused tree differs from the new one.
+    i3_containers::node reused_tree = tree;
+    if (!reused_tree.nodes.empty())
+    {
+        reused_tree.nodes.front().nodes.clear();
+        reused_tree.nodes.push_back(reused_tree.nodes.front());
+    }
+    i3.get_tree(reused_tree);
+    is_ok &= check_same_tree("In-place parse", tree, reused_tree);
+
+    // Same tree is parsed in place again, so every node is reused.
+    i3.get_tree(reused_tree);
+    is_ok &= check_same_tree("Repeated in-place parse", tree, reused_tree);
+
+    return is_ok ? 0 : 1;
+}
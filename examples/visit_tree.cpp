@@ -0,0 +1,53 @@
+// i3-ipc++ headers.
+#include "i3_ipc.hpp"
+#include "i3_tree_visitor.hpp"
+
+// C++ headers.
+#include <map>
+#include <string>
+#include <variant>
+#include <iostream>
+#include <string_view>
+
+// Counts windows per X11 class without storing any node of the tree.
+class window_class_counter : public i3_tree_visitor
+{
+public:
+
+    bool field(std::string_view a_object, std::string_view a_key, const value& a_value) override
+    {
+        if (a_object == "window_properties" && a_key == "class" && std::holds_alternative<std::string_view>(a_value))
+        {
+            ++m_windows[std::string(std::get<std::string_view>(a_value))];
+        }
+
+        return true;
+    }
+
+    const std::map<std::string, unsigned>& windows() const
+    {
+        return m_windows;
+    }
+
+private:
+
+    std::map<std::string, unsigned> m_windows;
+};
+
+int main()
+{
+    // Create IPC object and connect it to running i3 process.
+    i3_ipc i3;
+
+    // Walk through the tree while it is being parsed.
+    window_class_counter counter;
+    i3.visit_tree(counter);
+
+    // Print number of windows for each class.
+    for (const auto& [window_class, count] : counter.windows())
+    {
+        std::cout << window_class << ": " << count << std::endl;
+    }
+
+    return 0;
+}
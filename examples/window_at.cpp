@@ -0,0 +1,37 @@
+// i3-ipc++ headers.
+#include "i3_ipc.hpp"
+#include "i3_containers.hpp"
+#include "i3_spatial_index.hpp"
+
+// C++ headers.
+#include <string>
+#include <cstdint>
+#include <iostream>
+
+int main(int argc, char* argv[])
+{
+    // Point which is looked up, given as command line arguments.
+    const std::uint16_t x = argc > 2 ? static_cast<std::uint16_t>(std::stoul(argv[1])) : 0;
+    const std::uint16_t y = argc > 2 ? static_cast<std::uint16_t>(std::stoul(argv[2])) : 0;
+
+    // Create IPC object and connect it to running i3 process.
+    i3_ipc i3;
+
+    // Index rectangles of every visible window in the current tree.
+    i3_containers::spatial_index index(i3.get_tree());
+    std::cout << "Indexed " << index.size() << " windows." << std::endl;
+
+    // Floating windows can overlap tiling ones, so more than one window can be found.
+    for (const std::uint64_t id : index.find_at(x, y))
+    {
+        std::cout << "Window " << id << " contains point (" << x << ", " << y << ")." << std::endl;
+    }
+
+    // Windows in the top left quarter of 1920x1080 screen.
+    for (const std::uint64_t id : index.find_in(i3_containers::rectangle{ 0, 0, 960, 540 }))
+    {
+        std::cout << "Window " << id << " overlaps the top left quarter." << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,42 @@
+// i3-ipc++ headers.
+#include "i3_ipc.hpp"
+#include "i3_containers.hpp"
+#include "i3_window_index.hpp"
+
+// C++ headers.
+#include <iostream>
+#include <string_view>
+
+// Print the windows most similar to the query.
+void print_matches(const i3_containers::window_index& a_index, std::string_view a_query)
+{
+    for (const auto& match : a_index.search(a_query, 5))
+    {
+        std::cout << "Window " << match.id << " matches with score " << match.score << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const std::string_view query = argc > 1 ? argv[1] : "term";
+
+    // Create IPC object and connect it to running i3 process.
+    i3_ipc i3;
+
+    // Index every window in the current tree and search it.
+    i3_containers::window_index index(i3.get_tree());
+    std::cout << "Indexed " << index.size() << " windows." << std::endl;
+    print_matches(index, query);
+
+    // Keep the index up to date while windows are created, retitled and closed.
+    i3.on_window_event([&](const i3_containers::window_event& a_event) -> void
+                       {
+                           index.handle_event(a_event);
+                       });
+
+    // Search again after the next window event.
+    i3.handle_next_event();
+    print_matches(index, query);
+
+    return 0;
+}
@@ -0,0 +1,49 @@
+// i3-ipc++ headers.
+#include "i3_ipc.hpp"
+#include "i3_containers.hpp"
+#include "i3_workspace_state.hpp"
+
+// C++ headers.
+#include <iostream>
+
+int main()
+{
+    // Create IPC object and connect it to running i3 process.
+    i3_ipc i3;
+
+    // Take one snapshot, then keep it up to date from events.
+    i3_containers::workspace_state state(i3.get_workspaces(), i3.get_outputs());
+
+    // Events which can't be applied incrementally are answered by a new snapshot.
+    bool is_stale = false;
+    i3.on_workspace_event([&](const i3_containers::workspace_event& a_event) -> void
+                          {
+                              is_stale = !state.handle_event(a_event) || is_stale;
+                          });
+    i3.on_output_event([&](const i3_containers::output_event& a_event) -> void
+                       {
+                           is_stale = !state.handle_event(a_event) || is_stale;
+                       });
+
+    while (true)
+    {
+        i3.handle_next_event();
+        if (is_stale)
+        {
+            state.reset(i3.get_workspaces(), i3.get_outputs());
+            is_stale = false;
+        }
+
+        // Print what a bar would show.
+        const i3_containers::workspace* focused = state.get_focused_workspace();
+        std::cout << "Focused: " << (focused ? focused->name : "-") << std::endl;
+        for (const auto& [name, output] : state.get_outputs())
+        {
+            const i3_containers::workspace* visible = state.get_visible_workspace(name);
+            std::cout << "  " << name << ": " << (visible ? visible->name : "-") << std::endl;
+        }
+        std::cout << "Urgent workspaces: " << state.get_urgent_workspaces().size() << std::endl;
+    }
+
+    return 0;
+}
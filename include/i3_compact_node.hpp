@@ -0,0 +1,253 @@
+/*
+    Copyright (C) 2019, Ivan Balević
+
+    This file is part of "i3-ipc++" library.
+
+    "i3-ipc++" is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    "i3-ipc++" is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with "i3-ipc++". If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+ * \file    i3_compact_node.hpp
+ *
+ * \brief   Defines "i3_containers::compact_node" class which stores the same info as "i3_containers::node" in less
+ *          memory.
+ */
+
+#ifndef I3_COMPACT_NODE_HPP
+#define I3_COMPACT_NODE_HPP
+
+// Library headers.
+#include "i3_containers.hpp"
+#include "i3_string_pool.hpp"
+
+// C++ headers.
+#include <memory>
+#include <string>
+#include <vector>
+#include <optional>
+#include <string_view>
+
+// C headers.
+#include <cstdint>
+
+namespace i3_containers
+{
+    /**
+     * \brief   Class used to represent one i3 node/container in as little memory as possible.<br>
+     *          Enumerators and flags are packed into bitfields, presence of optional attributes is tracked in single
+     *          mask and attributes which are usually empty (window_rect, deco_rect, geometry, window_properties and
+     *          marks) are stored out of line, only for nodes which have them.<br>
+     *          X11 window class, instance and role, as well as marks, are interned in "i3_containers::string_pool",
+     *          so they are stored only once for the whole tree (or for every tree that shares the pool), and equal
+     *          strings from the same pool can be compared by their address.
+     */
+    class compact_node
+    {
+
+    public:
+
+        /**
+         * \brief   Constructs empty node.
+         */
+        compact_node();
+
+        /**
+         * \brief                  Constructs compact node (together with its whole subtree) from regular node.
+         *
+         * \param [in] a_node      Node whose info will be copied into compact node.
+         *
+         * \param [in] a_pool      Pool used for interned strings. If it is null, new pool is created for the tree.
+         */
+        explicit compact_node(const node& a_node, std::shared_ptr<string_pool> a_pool = nullptr);
+
+        /**
+         * \brief                  Constructs compact node (together with its whole subtree) from regular node.
+         *
+         * \param [in] a_node      Node whose info will be moved into compact node.
+         *
+         * \param [in] a_pool      Pool used for interned strings. If it is null, new pool is created for the tree.
+         */
+        explicit compact_node(node&& a_node, std::shared_ptr<string_pool> a_pool = nullptr);
+
+        /// \cond DO_NOT_DOCUMENT
+        compact_node(const compact_node& a_node);
+        compact_node(compact_node&& a_node) noexcept;
+        compact_node& operator=(const compact_node& a_node);
+        compact_node& operator=(compact_node&& a_node) noexcept;
+        ~compact_node();
+        /// \endcond
+
+        /**
+         * \brief    Converts compact node (together with its whole subtree) into regular node.
+         *
+         * \return   Regular node with the same info.
+         */
+        node to_node() const;
+
+        // NOTE: Getters and setters mirror the attributes of "i3_containers::node" (see its documentation).
+        //       Absent optional attributes are returned as std::nullopt, absent out-of-line rectangles as zeros.
+        //       Interned strings are set through the pool of the node, which is given to the first setter that
+        //       needs it (or created by it), and every later pool argument is ignored.
+        /// \cond DO_NOT_DOCUMENT
+        std::uint64_t get_id() const                                { return m_id;                                   }
+        std::optional<std::string_view> get_name() const;
+        node_type get_type() const                                  { return static_cast<node_type>(m_type);         }
+        border_style get_border() const                             { return static_cast<border_style>(m_border);    }
+        std::optional<std::uint8_t> get_current_border_width() const;
+        node_layout get_layout() const                              { return static_cast<node_layout>(m_layout);     }
+        std::optional<float> get_percent() const;
+        const rectangle& get_rect() const                           { return m_rect;                                 }
+        rectangle get_window_rect() const;
+        rectangle get_deco_rect() const;
+        rectangle get_geometry() const;
+        std::optional<std::uint64_t> get_window() const;
+        std::optional<x11_window> get_window_properties() const;
+        std::optional<std::string_view> get_window_class() const;
+        std::optional<std::string_view> get_window_instance() const;
+        std::optional<std::string_view> get_window_role() const;
+        bool is_urgent() const                                      { return m_is_urgent;                            }
+        bool is_focused() const                                     { return m_is_focused;                           }
+        const std::vector<std::uint64_t>& get_focus() const         { return m_focus;                                }
+        fullscreen_mode_type get_fullscreen_mode() const;
+        const std::vector<std::string_view>& get_marks() const;
+        const std::vector<compact_node>& get_nodes() const          { return m_nodes;                                }
+        const std::vector<compact_node>& get_floating_nodes() const { return m_floating_nodes;                       }
+
+        std::vector<std::uint64_t>& get_focus()                     { return m_focus;                                }
+        std::vector<compact_node>& get_nodes()                      { return m_nodes;                                }
+        std::vector<compact_node>& get_floating_nodes()             { return m_floating_nodes;                       }
+
+        void set_id(std::uint64_t a_id)                             { m_id = a_id;                                   }
+        void set_name(std::optional<std::string_view> a_name);
+        void set_type(node_type a_type);
+        void set_border(border_style a_border);
+        void set_current_border_width(std::optional<std::uint8_t> a_width);
+        void set_layout(node_layout a_layout);
+        void set_percent(std::optional<float> a_percent);
+        void set_rect(const rectangle& a_rect)                      { m_rect = a_rect;                               }
+        void set_window_rect(const rectangle& a_rect);
+        void set_deco_rect(const rectangle& a_rect);
+        void set_geometry(const rectangle& a_rect);
+        void set_window(std::optional<std::uint64_t> a_window);
+        void set_window_properties(const std::optional<x11_window>& a_window_properties,
+                                   std::shared_ptr<string_pool> a_pool = nullptr);
+        void set_urgent(bool a_is_urgent)                           { m_is_urgent = a_is_urgent;                     }
+        void set_focused(bool a_is_focused)                         { m_is_focused = a_is_focused;                   }
+        void set_fullscreen_mode(fullscreen_mode_type a_mode);
+        void set_marks(const std::vector<std::string>& a_marks, std::shared_ptr<string_pool> a_pool = nullptr);
+        /// \endcond
+
+    private:
+
+        /**
+         * \brief   Bits of the presence mask, one for each optional attribute stored inline.
+         */
+        enum presence_bit : std::uint8_t
+        {
+            name_bit                 = 1 << 0, /**< "name" is present.                 */
+            current_border_width_bit = 1 << 1, /**< "current_border_width" is present. */
+            percent_bit              = 1 << 2, /**< "percent" is present.              */
+            window_bit               = 1 << 3  /**< "window" is present.               */
+        };
+
+        /**
+         * \brief   Structure used to store attributes which are empty for most of the nodes.
+         */
+        struct details
+        {
+            rectangle window_rect;                           /**< Coordinates of container relative to parent.      */
+            rectangle deco_rect;                             /**< Coordinates of window decorations in container.   */
+            rectangle geometry;                              /**< Geometry the window specified when i3 mapped it.  */
+            std::shared_ptr<string_pool> pool;               /**< Pool which owns interned strings of this node.    */
+            bool has_window_properties;                      /**< Whether the window properties are present or not. */
+            std::optional<std::string_view> window_class;    /**< Interned X11 window class.                        */
+            std::optional<std::string_view> window_instance; /**< Interned X11 window class instance.               */
+            std::optional<std::string_view> window_role;     /**< Interned X11 window role.                         */
+            std::optional<std::string> window_title;         /**< X11 window title, which is rarely shared.         */
+            std::optional<std::uint64_t> transient_for;      /**< X11 window ID of the parent window.               */
+            std::vector<std::string_view> marks;             /**< Interned marks assigned to container.             */
+        };
+
+        /**
+         * \brief              Checks whether the optional attribute is present.
+         *
+         * \param [in] a_bit   Bit of the attribute in presence mask.
+         *
+         * \return             True if the attribute is present, false otherwise.
+         */
+        bool has(presence_bit a_bit) const { return (m_presence & a_bit) != 0; }
+
+        /**
+         * \brief              Marks the optional attribute as present or absent.
+         *
+         * \param [in] a_bit   Bit of the attribute in presence mask.
+         *
+         * \param [in] a_has   Whether the attribute is present or not.
+         */
+        void set_presence(presence_bit a_bit, bool a_has);
+
+        /**
+         * \brief                  Copies or moves info from regular node (together with its whole subtree).
+         *
+         * \tparam Node            Type of the regular node (const reference or rvalue reference).
+         *
+         * \param [in] a_node      Node whose info will be copied or moved.
+         *
+         * \param [in] a_pool      Pool used for interned strings of the whole subtree.
+         */
+        template<typename Node>
+        void assign(Node&& a_node, const std::shared_ptr<string_pool>& a_pool);
+
+        /**
+         * \brief                  Interns string in the pool of this node, setting the pool first if needed.
+         *
+         * \param [in] a_string    String to be interned.
+         *
+         * \param [in] a_pool      Pool which will be used if the node doesn't have one yet. If it is null too,
+         *                         new pool is created.
+         *
+         * \return                 View of the interned string.
+         */
+        std::string_view intern(std::string_view a_string, const std::shared_ptr<string_pool>& a_pool);
+
+        /**
+         * \brief    Returns the out-of-line attributes, creating them if they don't exist yet.
+         *
+         * \return   Out-of-line attributes of this node.
+         */
+        details& get_details();
+
+        // NOTE: Members are ordered by their alignment, so that there is no padding between them.
+        std::uint64_t m_id;                         /**< ID of the container.                                     */
+        std::uint64_t m_window;                     /**< X11 window ID, valid if "window_bit" is set.             */
+        std::string m_name;                         /**< Name of the container, valid if "name_bit" is set.       */
+        std::vector<std::uint64_t> m_focus;         /**< List of child node IDs in focus order.                   */
+        std::vector<compact_node> m_nodes;          /**< The tiling child containers of this node.                */
+        std::vector<compact_node> m_floating_nodes; /**< The floating child containers of this node.              */
+        std::unique_ptr<details> m_details;         /**< Attributes that most nodes don't have, or null.          */
+        rectangle m_rect;                           /**< Absolute display coordinates for the container.          */
+        float m_percent;                            /**< Percentage of parent, valid if "percent_bit" is set.     */
+        std::uint8_t m_current_border_width;        /**< Border width, valid if its bit is set.                   */
+        std::uint8_t m_presence;                    /**< Mask of "presence_bit" values of present attributes.     */
+        std::uint8_t m_type : 3;                    /**< Type of the container ("node_type").                     */
+        std::uint8_t m_border : 2;                  /**< Border style of the container ("border_style").          */
+        std::uint8_t m_is_urgent : 1;               /**< Whether the container is (in)directly urgent or not.     */
+        std::uint8_t m_is_focused : 1;              /**< Whether the container is currently focused or not.       */
+        std::uint8_t m_layout : 3;                  /**< Layout of the container ("node_layout").                 */
+        std::uint8_t m_fullscreen_mode : 2;         /**< Fullscreen mode ("fullscreen_mode_type").                */
+    };
+
+} // i3_containers namespace
+
+#endif // I3_COMPACT_NODE_HPP
@@ -163,6 +163,34 @@ namespace i3_containers
         std::vector<node> floating_nodes;                 /**< The floating child containers of this node.            */
     };
 
+    /**
+     * \brief   Structure used to represent one X11 window together with its position in the tree.
+     */
+    struct window_info
+    {
+        std::uint64_t id;                           /**< ID of the window's container.                         */
+        std::uint64_t window;                       /**< X11 window ID.                                        */
+        std::optional<std::string> window_class;    /**< X11 window class (WM_CLASS class).                    */
+        std::optional<std::string> window_instance; /**< X11 window class instance (WM_CLASS instance).        */
+        std::optional<std::string> window_title;    /**< X11 window title in UTF-8 (_NET_WM_NAME).             */
+        rectangle rect;                             /**< Absolute display coordinates for the container.       */
+        std::optional<std::string> workspace;       /**< Name of the workspace, absent for dock windows.       */
+        std::string output;                         /**< Name of the output ("__i3" for scratchpad).           */
+        bool is_focused;                            /**< Whether the container is currently focused or not.    */
+        bool is_urgent;                             /**< Whether the container is urgent or not.               */
+    };
+
+    /**
+     * \brief   Structure used to represent the focused node together with the chain of its ancestors.
+     */
+    // NOTE: Ancestors have only the info that i3 sends before their child nodes, so their "focus" and
+    //       "fullscreen_mode" are not set. None of them has any child nodes.
+    struct focus_path
+    {
+        std::vector<node> ancestors; /**< Ancestors of the focused node, from the root node to its parent. */
+        node focused;                /**< The focused node together with its whole subtree.               */
+    };
+
     /**
      * \brief   Enumerator used to describe the mode of i3 bar.
      */
@@ -403,6 +431,23 @@ namespace i3_containers
                                i3_containers::tick_event
                               >;
 
+    /**
+     * \brief   Structure used to represent several events handled at once, grouped by their type.<br>
+     *          Events of each type are in the order in which i3 sent them.
+     */
+    // NOTE: Keep the members synced with the alternatives of "i3_containers::event".
+    struct event_batch
+    {
+        std::vector<workspace_event> workspace_events;   /**< Changes in workspaces.             */
+        std::vector<output_event> output_events;         /**< Changes in outputs.                */
+        std::vector<mode_event> mode_events;             /**< Changes of binding mode.           */
+        std::vector<window_event> window_events;         /**< Changes in windows.                */
+        std::vector<bar_config_event> bar_config_events; /**< Updates of bar configuration.      */
+        std::vector<binding_event> binding_events;       /**< Triggered bindings.                */
+        std::vector<shutdown_event> shutdown_events;     /**< Restarts/shutdowns of i3.          */
+        std::vector<tick_event> tick_events;             /**< Ticks broadcasted through i3.      */
+    };
+
 } // i3_containers namespace
 
 #endif // I3_CONTAINERS_HPP
@@ -0,0 +1,163 @@
+/*
+    Copyright (C) 2019, Ivan Balević
+
+    This file is part of "i3-ipc++" library.
+
+    "i3-ipc++" is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    "i3-ipc++" is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with "i3-ipc++". If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+ * \file    i3_criteria.hpp
+ *
+ * \brief   Defines "i3_containers::criteria" class used to match containers against i3 command criteria.
+ */
+
+#ifndef I3_CRITERIA_HPP
+#define I3_CRITERIA_HPP
+
+// Library headers.
+#include "i3_containers.hpp"
+
+// C++ headers.
+#include <regex>
+#include <string>
+#include <vector>
+#include <optional>
+#include <string_view>
+
+// C headers.
+#include <cstdint>
+
+namespace i3_containers
+{
+    /**
+     * \brief   Class used to evaluate i3 command criteria (e.g. [class="^Firefox$" con_mark="x"]) client-side.<br>
+     *          Criteria string is parsed only once, on construction: regular expressions are compiled and the tests
+     *          are ordered from the cheapest (numbers and flags) to the most expensive (regular expressions), so
+     *          that matching a container doesn't parse anything and stops at the first failed test.<br>
+     *          Supported criteria are "class", "instance", "window_role", "title", "con_mark", "workspace" (regular
+     *          expressions, "(?i)" prefix makes them case-insensitive), "id", "con_id" (numbers, or "__focused__"
+     *          for "con_id"), "urgent", "floating", "tiling" and "all". As in i3, every criterion other than
+     *          "con_id" and "con_mark" matches only containers of X11 windows.
+     */
+    class criteria
+    {
+
+    public:
+
+        /**
+         * \brief                            Parses and compiles criteria.
+         *
+         * \param [in] a_criteria            Criteria, with or without surrounding brackets.
+         *
+         * \throws i3_ipc_invalid_argument   When criteria are malformed, empty, unsupported or contain invalid
+         *                                   regular expression.
+         *
+         * \throws std::bad_alloc            When bad allocation occurs while compiling the criteria.
+         */
+        explicit criteria(std::string_view a_criteria);
+
+        /**
+         * \brief                            Checks whether single container (e.g. one from
+         *                                   "i3_containers::window_event") matches the criteria.<br>
+         *                                   Position of the container in the tree is unknown, so the criteria which
+         *                                   depend on it ("workspace", "floating" and "tiling") can't be used.
+         *
+         * \param [in] a_container           Container to be checked. Its child containers are not checked.
+         *
+         * \return                           True if the container matches every criterion, false otherwise.
+         *
+         * \throws i3_ipc_invalid_argument   When criteria contain "workspace", "floating" or "tiling".
+         */
+        bool matches(const node& a_container) const;
+
+        /**
+         * \brief                    Finds every container in the tree which matches the criteria, in single pass.
+         *
+         * \param [in] a_tree        Root node of the tree.
+         *
+         * \return                   IDs of the matching containers, in depth-first order.
+         *
+         * \throws std::bad_alloc    When bad allocation occurs while collecting the result.
+         */
+        std::vector<std::uint64_t> find(const node& a_tree) const;
+
+    private:
+
+        /**
+         * \brief   Enumerator used to describe the attribute checked by one test.<br>
+         *          Enumerators are ordered by the cost of the test, which is the order in which tests are run.
+         */
+        enum class field : std::uint8_t
+        {
+            con_id,          /**< ID of the container.                    */
+            focused,         /**< Focus of the container ("__focused__"). */
+            id,              /**< X11 window ID.                          */
+            urgent,          /**< Urgency of the container.               */
+            floating,        /**< Whether the container is floating.      */
+            tiling,          /**< Whether the container is tiling.        */
+            all,             /**< Any window.                             */
+            window_class,    /**< X11 window class.                       */
+            window_instance, /**< X11 window class instance.              */
+            window_role,     /**< X11 window role.                        */
+            window_title,    /**< X11 window title.                       */
+            con_mark,        /**< Any of the marks of the container.      */
+            workspace        /**< Name of the workspace of the container. */
+        };
+
+        /**
+         * \brief   Structure used to represent one compiled criterion.
+         */
+        struct test
+        {
+            field kind;                        /**< Attribute checked by the test.             */
+            std::uint64_t number;              /**< Expected ID, for "con_id" and "id" tests.  */
+            std::optional<std::regex> pattern; /**< Compiled expression, for the string tests. */
+        };
+
+        /**
+         * \brief                  Checks whether the container matches the criteria.
+         *
+         * \param [in] a_container Container to be checked.
+         *
+         * \param [in] a_workspace Name of the workspace which contains the container, or null if unknown.
+         *
+         * \param [in] a_floating  Whether the container is floating, if its position in the tree is known.
+         *
+         * \return                 True if the container matches every criterion, false otherwise.
+         */
+        bool matches(const node& a_container, const std::string* a_workspace, std::optional<bool> a_floating) const;
+
+        /**
+         * \brief                  Recursively collects matching containers of the subtree.
+         *
+         * \param [in] a_node      Root node of the subtree.
+         *
+         * \param [in] a_workspace Name of the workspace which contains the subtree, or null if there is none.
+         *
+         * \param [in] a_floating  Whether the subtree is floating.
+         *
+         * \param [out] a_ids      Vector to which IDs of the matching containers are appended.
+         */
+        void find(const node& a_node, const std::string* a_workspace, bool a_floating,
+                  std::vector<std::uint64_t>& a_ids) const;
+
+        std::vector<test> m_tests; /**< Compiled criteria, ordered by their cost.         */
+        bool m_needs_window;       /**< Whether only containers of X11 windows can match. */
+        bool m_needs_position;     /**< Whether some test needs the position in the tree. */
+    };
+
+} // i3_containers namespace
+
+#endif // I3_CRITERIA_HPP
@@ -0,0 +1,235 @@
+/*
+    Copyright (C) 2019, Ivan Balević
+
+    This file is part of "i3-ipc++" library.
+
+    "i3-ipc++" is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    "i3-ipc++" is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with "i3-ipc++". If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+ * \file    i3_event_dispatcher.hpp
+ *
+ * \brief   Defines "i3_event_dispatcher" class template which dispatches i3 events whose set is known at compile time.
+ */
+
+#ifndef I3_EVENT_DISPATCHER_HPP
+#define I3_EVENT_DISPATCHER_HPP
+
+// Library headers.
+#include "i3_ipc.hpp"
+#include "i3_containers.hpp"
+
+// C++ headers.
+#include <utility>
+#include <variant>
+#include <string_view>
+#include <type_traits>
+
+// C headers.
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * \brief              This class template is used for handling the fixed set of i3 events with single handler.<br>
+ *                     Unlike the callbacks of "i3_ipc", handler is called directly (it can be inlined), events are
+ *                     not stored in any variant and only the parsers of the listed event types are referenced.<br>
+ *                     Dispatcher owns its own connection with i3, which is subscribed to all listed event types with
+ *                     single request on construction.
+ *
+ * \tparam Handler     Type of the handler. It must be callable with constant reference to each of the listed events.
+ *
+ * \tparam Events...   Types of handled events, e.g. "i3_containers::window_event".
+ */
+template<typename Handler, typename... Events>
+class i3_event_dispatcher
+{
+    static_assert(sizeof...(Events) > 0, "At least one event type must be handled!");
+    static_assert((std::is_invocable_v<Handler&, const Events&> && ...), "Handler must accept each of the events!");
+
+public:
+
+    /**
+     * \brief                            Constructor which connects to running i3 and subscribes to listed events.
+     *
+     * \param [in] a_handler             Handler which will be called with each handled event.
+     *
+     * \throws std::bad_alloc            When bad allocation occurs while searching for the path to i3's socket.
+     *
+     * \throws std::system_error         When system error occurs while connecting to i3 or subscribing to events.
+     *
+     * \throws i3_ipc_exception          When unable to find valid path to i3's socket.
+     *
+     * \throws i3_ipc_bad_message        When i3's message is invalid.
+     *
+     * \throws i3_ipc_invalid_argument   When i3 declines subscription request.
+     */
+    explicit i3_event_dispatcher(Handler a_handler = Handler());
+
+    /**
+     * \brief                            Constructor which connects to i3 over given socket path and subscribes to
+     *                                   listed events.
+     *
+     * \param [in] a_i3_socket_path      Path to i3's socket.
+     *
+     * \param [in] a_handler             Handler which will be called with each handled event.
+     *
+     * \throws std::system_error         When system error occurs while connecting to i3 or subscribing to events.
+     *
+     * \throws i3_ipc_bad_message        When i3's message is invalid.
+     *
+     * \throws i3_ipc_invalid_argument   When i3 declines subscription request.
+     */
+    explicit i3_event_dispatcher(std::string_view a_i3_socket_path, Handler a_handler = Handler());
+
+    /**
+     * \brief                       Waits for the next event of listed types and calls the handler with its info.
+     *
+     * \return                      Type of handled event.
+     *
+     * \throws std::system_error    When system error occurs while reading from event socket.
+     *
+     * \throws i3_ipc_bad_message   When read message is invalid.
+     *
+     * \throws i3_ipc_unsupported   When value of some property is unknown to "i3-ipc++" library during parsing.
+     */
+    i3_ipc::event_type handle_next_event();
+
+    /**
+     * \brief    Returns the handler, so that the state it collected can be inspected.
+     *
+     * \return   Handler of the dispatcher.
+     */
+    Handler& get_handler() { return m_handler; }
+
+    /**
+     * \brief    Returns the handler, so that the state it collected can be inspected.
+     *
+     * \return   Handler of the dispatcher.
+     */
+    const Handler& get_handler() const { return m_handler; }
+
+private:
+
+    /**
+     * \brief          Returns the type of given event.
+     *
+     * \tparam Event   Type of the event info, e.g. "i3_containers::window_event".
+     *
+     * \return         Event type of "Event".
+     */
+    template<typename Event>
+    static constexpr i3_ipc::event_type get_event_type();
+
+    /**
+     * \brief                    Returns the index of given type in the list of variant's alternatives.
+     *
+     * \tparam Event             Type whose index is searched for.
+     *
+     * \tparam Alternatives...   Alternatives of the variant.
+     *
+     * \return                   Index of "Event" in "Alternatives...".
+     */
+    template<typename Event, typename... Alternatives>
+    static constexpr std::size_t get_alternative_index(std::variant<Alternatives...>*);
+
+    /**
+     * \brief                Calls the handler with given event if it is of given type.
+     *
+     * \tparam Event         Type of the event info which is checked.
+     *
+     * \param [in] a_event   Received event with unparsed payload.
+     *
+     * \return               True if the event is of given type and it was handled, false otherwise.
+     */
+    template<typename Event>
+    bool dispatch(const i3_ipc::raw_event& a_event);
+
+    i3_ipc m_ipc;      /**< Connection with i3 used only for the listed events. */
+    Handler m_handler; /**< Handler called with each handled event.            */
+};
+
+template<typename Handler, typename... Events>
+i3_event_dispatcher<Handler, Events...>::i3_event_dispatcher(Handler a_handler)
+    : m_ipc(), m_handler(std::move(a_handler))
+{
+    m_ipc.subscribe({ get_event_type<Events>()... });
+}
+
+template<typename Handler, typename... Events>
+i3_event_dispatcher<Handler, Events...>::i3_event_dispatcher(std::string_view a_i3_socket_path, Handler a_handler)
+    : m_ipc(a_i3_socket_path), m_handler(std::move(a_handler))
+{
+    m_ipc.subscribe({ get_event_type<Events>()... });
+}
+
+template<typename Handler, typename... Events>
+i3_ipc::event_type i3_event_dispatcher<Handler, Events...>::handle_next_event()
+{
+    while (true)
+    {
+        const i3_ipc::raw_event event = m_ipc.receive_raw_event();
+
+        // NOTE: Fold expression expands into the chain of comparisons with constant event types, which compiler
+        //       turns into the same code as switch. Events of other types are never sent by i3, but skip them anyway.
+        if ((dispatch<Events>(event) || ...))
+        {
+            return event.type;
+        }
+    }
+}
+
+/// \cond DO_NOT_DOCUMENT
+
+template<typename Handler, typename... Events>
+template<typename Event>
+constexpr i3_ipc::event_type i3_event_dispatcher<Handler, Events...>::get_event_type()
+{
+    // NOTE: Alternatives of "i3_containers::event" are in the same order as the elements of "i3_ipc::event_type".
+    constexpr std::size_t index = get_alternative_index<Event>(static_cast<i3_containers::event*>(nullptr));
+
+    return static_cast<i3_ipc::event_type>(index);
+}
+
+template<typename Handler, typename... Events>
+template<typename Event, typename... Alternatives>
+constexpr std::size_t i3_event_dispatcher<Handler, Events...>::get_alternative_index(std::variant<Alternatives...>*)
+{
+    static_assert((std::is_same_v<Event, Alternatives> || ...), "Event must be a type of i3_containers::event!");
+    constexpr bool is_event[] = { std::is_same_v<Event, Alternatives>... };
+
+    std::size_t index = 0;
+    while (!is_event[index])
+    {
+        ++index;
+    }
+
+    return index;
+}
+
+template<typename Handler, typename... Events>
+template<typename Event>
+bool i3_event_dispatcher<Handler, Events...>::dispatch(const i3_ipc::raw_event& a_event)
+{
+    if (a_event.type != get_event_type<Event>())
+    {
+        return false;
+    }
+
+    m_handler(i3_ipc::parse_event(a_event.payload.c_str(), std::in_place_type<Event>));
+    return true;
+}
+
+/// \endcond
+
+#endif // I3_EVENT_DISPATCHER_HPP
@@ -0,0 +1,175 @@
+/*
+    Copyright (C) 2019, Ivan Balević
+
+    This file is part of "i3-ipc++" library.
+
+    "i3-ipc++" is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    "i3-ipc++" is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with "i3-ipc++". If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+ * \file    i3_focus_history.hpp
+ *
+ * \brief   Defines "i3_containers::focus_history" class which keeps windows in most-recently-used order.
+ */
+
+#ifndef I3_FOCUS_HISTORY_HPP
+#define I3_FOCUS_HISTORY_HPP
+
+// Library headers.
+#include "i3_containers.hpp"
+
+// C++ headers.
+#include <list>
+#include <optional>
+#include <unordered_map>
+
+// C headers.
+#include <cstddef>
+#include <cstdint>
+
+namespace i3_containers
+{
+    /**
+     * \brief   Class used to keep the order in which windows were focused (most recently used first), globally and
+     *          for each workspace, which i3 doesn't provide.<br>
+     *          Order is kept in linked lists, together with the position of each window in them, so every focus
+     *          change is handled in constant time and reading the order needs no request to i3.
+     */
+    class focus_history
+    {
+
+    public:
+
+        /**
+         * \brief   Constructs empty history.
+         */
+        focus_history();
+
+        /**
+         * \brief                    Constructs history from the "focus" lists of the tree.<br>
+         *                           Tree knows only which child of each node was focused most recently, so windows
+         *                           are ordered by the focus order of the tree.
+         *
+         * \param [in] a_tree        Root node of the tree.
+         *
+         * \throws std::bad_alloc    When bad allocation occurs while building the history.
+         */
+        explicit focus_history(const node& a_tree);
+
+        /**
+         * \brief                    Updates the history from window event.<br>
+         *                           Window is moved to the front on "focus" and removed on "close".
+         *
+         * \param [in] a_event       Window event.
+         *
+         * \throws std::bad_alloc    When bad allocation occurs while adding new window.
+         */
+        void handle_event(const window_event& a_event);
+
+        /**
+         * \brief                    Updates the history from workspace event.<br>
+         *                           On "focus" the workspace becomes current, so windows focused later are assigned
+         *                           to it, and windows found in its tree are moved to it if they were moved there.
+         *
+         * \param [in] a_event       Workspace event.
+         *
+         * \throws std::bad_alloc    When bad allocation occurs while adding new window.
+         */
+        void handle_event(const workspace_event& a_event);
+
+        /**
+         * \brief    Returns the order of all windows.
+         *
+         * \return   IDs of the containers of the windows, most recently focused first.
+         */
+        const std::list<std::uint64_t>& get_order() const;
+
+        /**
+         * \brief                  Returns the order of the windows on given workspace.
+         *
+         * \param [in] a_workspace ID of the workspace's container.
+         *
+         * \return                 IDs of the containers of the windows, most recently focused first. Empty if
+         *                         workspace is unknown.
+         */
+        const std::list<std::uint64_t>& get_order(std::uint64_t a_workspace) const;
+
+        /**
+         * \brief    Returns the workspace which was focused most recently.
+         *
+         * \return   ID of the workspace's container, or std::nullopt if it is unknown.
+         */
+        std::optional<std::uint64_t> get_current_workspace() const;
+
+        /**
+         * \brief    Returns the number of windows in the history.
+         *
+         * \return   Number of windows in the history.
+         */
+        std::size_t size() const;
+
+    private:
+
+        /**
+         * \brief   Structure used to represent the position of one window in the lists.
+         */
+        struct entry
+        {
+            std::list<std::uint64_t>::iterator global_position;    /**< Position in the global list.          */
+            std::optional<std::uint64_t> workspace;                /**< Workspace of the window, if known.    */
+            std::list<std::uint64_t>::iterator workspace_position; /**< Position in the list of workspace.    */
+        };
+
+        /**
+         * \brief                  Moves the window to the front of the lists, adding it if it is not there yet.
+         *
+         * \param [in] a_id        ID of the window's container.
+         *
+         * \param [in] a_workspace Workspace of the window, if known.
+         */
+        void touch(std::uint64_t a_id, std::optional<std::uint64_t> a_workspace);
+
+        /**
+         * \brief                  Moves the window to the list of given workspace, keeping its place in the global
+         *                         list. Window is added to the back of both lists if it is not there yet.
+         *
+         * \param [in] a_id        ID of the window's container.
+         *
+         * \param [in] a_workspace Workspace of the window.
+         */
+        void assign(std::uint64_t a_id, std::uint64_t a_workspace);
+
+        /**
+         * \brief                  Removes the window from the list of its workspace.
+         *
+         * \param [in] a_entry     Position of the window.
+         */
+        void leave_workspace(entry& a_entry);
+
+        /**
+         * \brief                  Removes the window from the history.
+         *
+         * \param [in] a_id        ID of the window's container. Unknown IDs are ignored.
+         */
+        void erase(std::uint64_t a_id);
+
+        std::list<std::uint64_t> m_order;                                         /**< All windows.          */
+        std::unordered_map<std::uint64_t, std::list<std::uint64_t>> m_workspaces; /**< Windows of workspace. */
+        std::unordered_map<std::uint64_t, entry> m_entries;                       /**< Position of window.   */
+        std::optional<std::uint64_t> m_current_workspace;                         /**< Focused workspace.    */
+    };
+
+} // i3_containers namespace
+
+#endif // I3_FOCUS_HISTORY_HPP
@@ -0,0 +1,110 @@
+/*
+    Copyright (C) 2019, Ivan Balević
+
+    This file is part of "i3-ipc++" library.
+
+    "i3-ipc++" is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    "i3-ipc++" is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with "i3-ipc++". If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+ * \file    i3_function_ref.hpp
+ *
+ * \brief   Defines "i3_function_ref" class template which refers to callable object without owning it.
+ */
+
+#ifndef I3_FUNCTION_REF_HPP
+#define I3_FUNCTION_REF_HPP
+
+// C++ headers.
+#include <memory>
+#include <utility>
+#include <functional>
+#include <type_traits>
+
+/// \cond DO_NOT_DOCUMENT
+template<typename Signature>
+class i3_function_ref;
+/// \endcond
+
+/**
+ * \brief              This class template is used to pass callable object (e.g. handler object or lambda) as callback
+ *                     without copying it.<br>
+ *                     It stores only the address of the object and the function which calls it, so it never
+ *                     allocates and it is trivially copyable. Since the object is not owned, caller must keep it
+ *                     alive for as long as the callback can be called.
+ *
+ * \tparam Result      Type returned by the callable object.
+ *
+ * \tparam Args...     Types of arguments passed to the callable object.
+ */
+template<typename Result, typename... Args>
+class i3_function_ref<Result(Args...)>
+{
+
+public:
+
+    /**
+     * \brief                  Constructor which refers to given callable object.
+     *
+     * \tparam Callable        Type of the callable object.
+     *
+     * \param [in] a_callable  Object which will be called. It must outlive this reference and all of its copies.
+     */
+    // NOTE: Only lvalues can be referred to, since temporary would be destroyed before the reference is used.
+    template<typename Callable,
+             typename = std::enable_if_t<std::is_object_v<Callable> &&
+                                         !std::is_same_v<std::remove_cv_t<Callable>, i3_function_ref> &&
+                                         std::is_invocable_r_v<Result, Callable&, Args...>>>
+    i3_function_ref(Callable& a_callable) noexcept
+        : m_object(const_cast<void*>(static_cast<const volatile void*>(std::addressof(a_callable)))),
+          m_function(&call<Callable>)
+    {
+    }
+
+    /**
+     * \brief              Calls the referred object with given arguments.
+     *
+     * \param [in] a_args  Arguments passed to the referred object.
+     *
+     * \return             Value returned by the referred object.
+     */
+    Result operator()(Args... a_args) const
+    {
+        return m_function(m_object, std::forward<Args>(a_args)...);
+    }
+
+private:
+
+    /**
+     * \brief                Calls the object of given type with given arguments.
+     *
+     * \tparam Callable      Type of the referred object.
+     *
+     * \param [in] a_object  Address of the referred object.
+     *
+     * \param [in] a_args    Arguments passed to the referred object.
+     *
+     * \return               Value returned by the referred object.
+     */
+    template<typename Callable>
+    static Result call(void* a_object, Args... a_args)
+    {
+        return std::invoke(*static_cast<Callable*>(a_object), std::forward<Args>(a_args)...);
+    }
+
+    void* m_object;                       /**< Address of the referred object.             */
+    Result (*m_function)(void*, Args...); /**< Function which calls the referred object. */
+};
+
+#endif // I3_FUNCTION_REF_HPP
@@ -0,0 +1,129 @@
+/*
+    Copyright (C) 2019, Ivan Balević
+
+    This file is part of "i3-ipc++" library.
+
+    "i3-ipc++" is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    "i3-ipc++" is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with "i3-ipc++". If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+ * \file    i3_hashed_tree.hpp
+ *
+ * \brief   Defines "i3_containers::hashed_tree" class which indexes node tree and hashes each of its subtrees.
+ */
+
+#ifndef I3_HASHED_TREE_HPP
+#define I3_HASHED_TREE_HPP
+
+// Library headers.
+#include "i3_containers.hpp"
+
+// C++ headers.
+#include <memory>
+#include <vector>
+#include <optional>
+#include <unordered_map>
+
+// C headers.
+#include <cstddef>
+#include <cstdint>
+
+namespace i3_containers
+{
+    /**
+     * \brief   Class used to own node tree together with its flat index and the content hash of every subtree.<br>
+     *          Hash of a node covers all of its fields and the hashes of its child nodes (Merkle tree), so two
+     *          subtrees with equal hashes are equal with overwhelming probability, and unchanged subtrees can be
+     *          skipped by comparing single number.
+     */
+    // NOTE: Hashes are computed with 64-bit FNV-1a, so they are the same across processes and library builds.
+    class hashed_tree
+    {
+
+    public:
+
+        /**
+         * \brief   Structure used to represent one node in the flat index of the tree.
+         */
+        struct entry
+        {
+            const node* tree_node;   /**< The node itself.                                                  */
+            std::uint64_t parent_id; /**< ID of the parent node, 0 for the root.                            */
+            std::uint64_t hash;      /**< Hash of the whole subtree of this node.                           */
+            std::size_t subtree_end; /**< Position after the last entry of this subtree in the flat index. */
+        };
+
+        /**
+         * \brief                    Takes the ownership of the tree, indexes it and hashes every subtree.
+         *
+         * \param [in] a_root        Root node of the tree.
+         *
+         * \throws std::bad_alloc    When bad allocation occurs while indexing the tree.
+         */
+        explicit hashed_tree(node a_root);
+
+        /**
+         * \brief    Returns the root node of the tree.
+         *
+         * \return   Root node of the tree.
+         */
+        const node& get_root() const;
+
+        /**
+         * \brief    Returns the hash of the whole tree.
+         *
+         * \return   Hash of the root node.
+         */
+        std::uint64_t get_hash() const;
+
+        /**
+         * \brief    Returns the flat index of the tree.<br>
+         *           Entries are in depth-first order (tiling child nodes before floating ones), so the subtree of
+         *           the entry at position "i" spans the positions from "i" to its "subtree_end".
+         *
+         * \return   Entry of every node in the tree.
+         */
+        const std::vector<entry>& get_entries() const;
+
+        /**
+         * \brief               Finds the node with given ID.
+         *
+         * \param [in] a_id     ID of the node.
+         *
+         * \return              Position of the node in the flat index, or std::nullopt if there is no such node.
+         */
+        std::optional<std::size_t> find(std::uint64_t a_id) const;
+
+    private:
+
+        /**
+         * \brief                   Adds the subtree to the flat index and hashes it.
+         *
+         * \param [in] a_node       Root node of the subtree.
+         *
+         * \param [in] a_parent_id  ID of the parent of "a_node", 0 for the root.
+         *
+         * \return                  Hash of the subtree.
+         */
+        std::uint64_t index_subtree(const node& a_node, std::uint64_t a_parent_id);
+
+        // NOTE: Root is kept on the heap, so the pointers in the index survive the move of the whole object.
+        std::unique_ptr<node> m_root;                           /**< Root node of the owned tree.          */
+        std::vector<entry> m_entries;                           /**< Flat index of the tree.               */
+        std::unordered_map<std::uint64_t, std::size_t> m_index; /**< Position of each node ID in the index. */
+    };
+
+} // i3_containers namespace
+
+#endif // I3_HASHED_TREE_HPP
@@ -28,23 +28,37 @@
 
 // Library headers.
 #include "i3_containers.hpp"
+#include "i3_function_ref.hpp"
+#include "i3_tree_visitor.hpp"
+#include "i3_hashed_tree.hpp"
+#include "i3_compact_node.hpp"
+#include "i3_persistent_tree.hpp"
+#include "i3_string_pool.hpp"
+#include "i3_pmr_containers.hpp"
 
 // C++ headers.
 #include <array>
-#include <queue>
+#include <chrono>
+#include <deque>
+#include <memory>
 #include <vector>
 #include <string>
 #include <variant>
 #include <optional>
+#include <utility>
 #include <exception>
 #include <functional>
 #include <string_view>
+#include <initializer_list>
+#include <memory_resource>
 
 // C headers.
+#include <cstddef>
 #include <cstdint>
 
 // Forward declaration.
-namespace i3_message{enum class type : std::uint32_t;}
+namespace i3_message{enum class type : std::uint32_t; struct header; struct response; class payload_stream;}
+class i3_thread_pool;
 
 /**
  * \brief   This class is used for over-socket communication with running i3 window manager.
@@ -72,6 +86,36 @@ public:
     };
     static constexpr std::uint8_t number_of_event_types = 8; /**< Number of supported event types. */
 
+    /**
+     * \brief   Predicate used to prune the node tree while it is being parsed.<br>
+     *          First argument is the candidate node and second one is its parent. Both of them have all info that
+     *          i3 sends before their child nodes, so "focus" and "fullscreen_mode" are not set yet. Returning false
+     *          drops the candidate node together with its whole subtree, which is skipped without being parsed.
+     */
+    using tree_filter = std::function<bool(const i3_containers::node&, const i3_containers::node&)>;
+
+    /**
+     * \brief   Enumerator used to describe what happens with new events once event queue reaches its limits.
+     */
+    enum class overflow_policy : std::uint8_t
+    {
+        block,        /**< Stop reading events from socket until queued events are handled.        */
+        drop_oldest,  /**< Drop the oldest queued events to make room for the new ones.             */
+        drop_by_type, /**< Drop the oldest queued and all new events of droppable types.            */
+        resync        /**< Drop all queued and new events until "i3_ipc_queue_overflow" is thrown. */
+    };
+
+    /**
+     * \brief   Structure used to bound the memory taken by events which are queued for later handling.
+     */
+    struct event_queue_limits
+    {
+        std::size_t max_events;                        /**< Maximal number of queued events.                  */
+        std::size_t max_bytes;                         /**< Maximal size of JSON payloads of queued events.   */
+        overflow_policy policy;                        /**< What happens with events once limit is reached.   */
+        std::vector<event_type> droppable_event_types; /**< Types dropped by "overflow_policy::drop_by_type". */
+    };
+
     /**
      * \brief                      Constructor which finds the path to i3's socket and establishes connections with it.
      *
@@ -148,6 +192,103 @@ public:
      */
     static std::optional<std::string> find_i3_socket_path();
 
+    /**
+     * \brief    Returns the number of threads used for parsing the node tree.
+     *
+     * \return   Number of threads used for parsing the node tree.
+     */
+    std::size_t get_tree_parsing_threads() const;
+
+    /**
+     * \brief                      Sets the number of threads used for parsing the node tree by "get_tree".<br>
+     *                             With more than one thread, the calling thread reads the response and hands the
+     *                             JSON of every workspace to the pool of worker threads as soon as it is read, so
+     *                             workspaces are parsed in parallel while the rest of the response is still arriving.
+     *                             This pays off only for large trees.
+     *
+     * \param [in] a_threads       Number of threads including the calling one. 1 (default) parses the tree serially,
+     *                             while 0 uses as many threads as there are hardware threads.
+     *
+     * \throws std::system_error   When system error occurs while starting worker threads.
+     */
+    // NOTE: Worker threads are started here and reused by every "get_tree" call, until the number of threads changes.
+    // NOTE: With more than one thread, filter passed to "get_tree" may be called concurrently from several threads,
+    //       and also for nodes inside of the subtrees which are rejected afterwards.
+    void set_tree_parsing_threads(std::size_t a_threads);
+
+    /**
+     * \brief    Returns the pool in which strings of compact trees are interned.
+     *
+     * \return   Pool shared by compact trees or null if every compact tree gets its own pool.
+     */
+    std::shared_ptr<i3_containers::string_pool> get_string_pool() const;
+
+    /**
+     * \brief               Sets the pool in which window classes, instances, roles and marks of every tree returned
+     *                      by "get_compact_tree" are interned.<br>
+     *                      With shared pool, repeated calls don't allocate strings which were already seen, and
+     *                      equal strings from different snapshots point to the same characters.
+     *
+     * \param [in] a_pool   Pool shared by compact trees. If it is null (default), every tree gets its own pool.
+     */
+    // NOTE: Pool never forgets a string, so it grows with the number of distinct strings seen by the connection.
+    // NOTE: Pool is not used by "get_tree" functions and window events, because "i3_containers::node" and
+    //       "i3_containers::x11_window" own their strings. Those still allocate every string on every call.
+    void set_string_pool(std::shared_ptr<i3_containers::string_pool> a_pool);
+
+    /**
+     * \brief    Returns for how long events are collected for coalescing before they are handled.
+     *
+     * \return   Coalescing window or std::nullopt if coalescing is disabled.
+     */
+    std::optional<std::chrono::milliseconds> get_event_coalescing() const;
+
+    /**
+     * \brief                 Enables coalescing of bursty "title" and "move" window events.<br>
+     *                        When the next event has to be read from the socket, every other event that arrives within
+     *                        given window is read too, and only the latest "title"/"move" event of each container is
+     *                        kept. Superseded events are dropped before they are parsed, while every other event is
+     *                        kept in its original order. Callbacks are then called once per burst, instead of once
+     *                        per event.
+     *
+     * \param [in] a_window   How long to wait for more events. Zero takes only the events which can be read without
+     *                        blocking. If it is std::nullopt (default), every event is handled.
+     */
+    // NOTE: Burst also ends after 1024 events (or earlier, at the limits of event queue), so that steady stream of
+    //       events can't keep extending the burst of zero window.
+    // NOTE: Events read while waiting for the response of some request are already parsed, so they are not coalesced.
+    void set_event_coalescing(std::optional<std::chrono::milliseconds> a_window);
+
+    /**
+     * \brief    Returns the limits of event queue.
+     *
+     * \return   Limits of event queue or std::nullopt if event queue is unbounded.
+     */
+    std::optional<event_queue_limits> get_event_queue_limits() const;
+
+    /**
+     * \brief                 Bounds the number and size of events which are queued while waiting for the responses
+     *                        of requests, or read ahead by "handle_pending_events" and event coalescing.<br>
+     *                        Once one of the limits is reached, new events are handled according to the policy:
+     *                        <ul>
+     *                        <li> block: Events are left in the socket, so that i3 waits for them to be read. Events
+     *                             which come before the response of some request still have to be queued, so the
+     *                             limits can be exceeded only while waiting for the response.
+     *                        <li> drop_oldest: Oldest queued events are dropped.
+     *                        <li> drop_by_type: New events of droppable types are dropped, while queued events of
+     *                             droppable types are dropped, oldest first, to make room for the events of other
+     *                             types. If there are no such events, limits are exceeded.
+     *                        <li> resync: All queued and new events are dropped and "i3_ipc_queue_overflow" is thrown
+     *                             from the next call of "handle_next_event" or "handle_pending_events". State kept from
+     *                             previous events is stale at that point and it should be fetched from i3 again.
+     *                        </ul>
+     *                        Subscriptions are never dropped and they don't count towards the limits.
+     *
+     * \param [in] a_limits   Limits of event queue. If it is std::nullopt (default), event queue is unbounded.
+     */
+    // NOTE: Limits are checked only when new event is queued, so events which are already queued are kept.
+    void set_event_queue_limits(std::optional<event_queue_limits> a_limits);
+
     /**
      * \brief                            Tells i3 to execute given command(s).<br>
      *                                   NOTE: "restart" and "exit" are not implemented properly and will always throw.
@@ -197,6 +338,158 @@ public:
      */
     i3_containers::node get_tree() const;
 
+    /**
+     * \brief                       Gets info for internal i3 node tree, without the subtrees rejected by given filter.
+     *
+     * \param [in] a_filter         Predicate which decides whether the node and its subtree should be kept or not.
+     *                              It is called for every node except the root, before its child nodes are parsed.
+     *
+     * \return                      Info about the root node in pruned i3 node tree.
+     *
+     * \throws std::system_error    When system error occurs while communicating through the socket.
+     *
+     * \throws i3_ipc_bad_message   When i3's response message is invalid.
+     *
+     * \throws i3_ipc_unsupported   When value of some node property is unknown to "i3-ipc++" library.
+     */
+    i3_containers::node get_tree(const tree_filter& a_filter) const;
+
+    /**
+     * \brief                       Gets info for internal i3 node tree by overwriting the existing tree.<br>
+     *                              Child nodes are matched by their position, so strings and vectors of "a_tree" keep
+     *                              their capacity wherever the shape of the tree didn't change. Calling this function
+     *                              periodically with the same tree allocates close to nothing in the steady state.
+     *
+     * \param [in,out] a_tree       Tree from the previous call (or any other node), which will be overwritten.
+     *                              If exception is thrown, it is left partially overwritten.
+     *
+     * \throws std::system_error    When system error occurs while communicating through the socket.
+     *
+     * \throws i3_ipc_bad_message   When i3's response message is invalid.
+     *
+     * \throws i3_ipc_unsupported   When value of some node property is unknown to "i3-ipc++" library.
+     */
+    // NOTE: Tree is always parsed by the calling thread, regardless of "set_tree_parsing_threads".
+    void get_tree(i3_containers::node& a_tree) const;
+
+    /**
+     * \brief                       Gets info for internal i3 node tree, allocated from given memory resource.<br>
+     *                              Tree is built while the response is being read, and every string and container
+     *                              in it uses "a_resource", so the whole tree can be released at once together with
+     *                              the resource (e.g. "std::pmr::monotonic_buffer_resource").
+     *
+     * \param [in] a_resource       Memory resource used for the tree. If it is null, default memory resource is used.
+     *
+     * \return                      Info about the root node in i3 node tree.
+     *
+     * \throws std::system_error    When system error occurs while communicating through the socket.
+     *
+     * \throws i3_ipc_bad_message   When i3's response message is invalid.
+     *
+     * \throws i3_ipc_unsupported   When value of some node property is unknown to "i3-ipc++" library.
+     */
+    i3_containers::pmr::node get_tree(std::pmr::memory_resource* a_resource) const;
+
+    /**
+     * \brief                       Gets info for internal i3 node tree, stored as compact nodes.<br>
+     *                              Compact nodes keep the same info in considerably less memory, which is useful when
+     *                              the tree is large or kept around for a long time.
+     *
+     * \return                      Info about the root node in i3 node tree.
+     *
+     * \throws std::system_error    When system error occurs while communicating through the socket.
+     *
+     * \throws i3_ipc_bad_message   When i3's response message is invalid.
+     *
+     * \throws i3_ipc_unsupported   When value of some node property is unknown to "i3-ipc++" library.
+     */
+    i3_containers::compact_node get_compact_tree() const;
+
+    /**
+     * \brief                       Gets info for internal i3 node tree, together with its flat index and the hash of
+     *                              every subtree.<br>
+     *                              Comparing the hashes of successive trees finds unchanged subtrees in constant time
+     *                              (see "i3_containers::tree_diff").
+     *
+     * \return                      Indexed and hashed i3 node tree.
+     *
+     * \throws std::system_error    When system error occurs while communicating through the socket.
+     *
+     * \throws i3_ipc_bad_message   When i3's response message is invalid.
+     *
+     * \throws i3_ipc_unsupported   When value of some node property is unknown to "i3-ipc++" library.
+     */
+    i3_containers::hashed_tree get_hashed_tree() const;
+
+    /**
+     * \brief                       Gets info for internal i3 node tree as immutable, reference-counted tree, which
+     *                              can be shared between threads without copying (see "i3_containers::snapshot_store").
+     *
+     * \return                      Root node of persistent i3 node tree.
+     *
+     * \throws std::system_error    When system error occurs while communicating through the socket.
+     *
+     * \throws i3_ipc_bad_message   When i3's response message is invalid.
+     *
+     * \throws i3_ipc_unsupported   When value of some node property is unknown to "i3-ipc++" library.
+     */
+    i3_containers::persistent_node::pointer get_persistent_tree() const;
+
+    /**
+     * \brief                       Gets info for the focused node in i3 node tree and for its ancestors.
+     *
+     * \return                      Info about the focused node, together with its whole subtree and the chain of
+     *                              its ancestors, or std::nullopt if i3 didn't report any node as focused.
+     *
+     * \throws std::system_error    When system error occurs while communicating through the socket.
+     *
+     * \throws i3_ipc_bad_message   When i3's response message is invalid.
+     *
+     * \throws i3_ipc_unsupported   When value of some node property is unknown to "i3-ipc++" library.
+     */
+    // NOTE: Tree is read as a stream and reading stops as soon as the focused node is complete,
+    //       so no other part of the tree is ever stored.
+    std::optional<i3_containers::focus_path> get_focused_node() const;
+
+    /**
+     * \brief                       Gets info for every X11 window in i3 node tree.<br>
+     *                              This is the fast path for the common case of "get_tree" followed by collecting
+     *                              the leaf windows, since the tree is never built.
+     *
+     * \return                      Info about the windows, in the order of the tree.
+     *
+     * \throws std::system_error    When system error occurs while communicating through the socket.
+     *
+     * \throws i3_ipc_bad_message   When i3's response message is invalid.
+     *
+     * \throws i3_ipc_unsupported   When value of some node property is unknown to "i3-ipc++" library.
+     */
+    // NOTE: Tree is read as a stream and only the chain of nodes from the root to the current node is kept,
+    //       together with the names of its workspace and output.
+    std::vector<i3_containers::window_info> get_windows() const;
+
+    /**
+     * \brief                       Walks through internal i3 node tree with given visitor, while the tree is parsed.
+     *
+     * \param [in] a_visitor        Visitor which receives every node of the tree, in the order of depth-first search.
+     *
+     * \throws std::system_error    When system error occurs while communicating through the socket.
+     *
+     * \throws i3_ipc_bad_message   When i3's response message is invalid.
+     */
+    // NOTE: Nodes are never stored, so it is possible to aggregate data over the huge trees without extracting them.
+    void visit_tree(i3_tree_visitor& a_visitor) const;
+
+    /**
+     * \brief                  Walks through raw payload of i3's event message with given visitor.<br>
+     *                         This is useful for payloads received outside of this object (for example, logged ones).
+     *
+     * \param [in] a_payload   Payload of i3's event message in JSON format.
+     *
+     * \param [in] a_visitor   Visitor which receives attributes of the event and every node inside of it.
+     */
+    static void visit_event(std::string_view a_payload, i3_tree_visitor& a_visitor);
+
     /**
      * \brief                       Gets marks used by i3.
      *
@@ -310,6 +603,25 @@ public:
      */
     void on_workspace_event(const std::function<void(const i3_containers::workspace_event&)>& a_callback) const;
 
+    /**
+     * \brief                            Subscribes to "workspace" event and stores reference to handler for it.<br>
+     *                                   Handler is neither copied nor wrapped in "std::function", so it must outlive
+     *                                   the subscription.
+     *
+     * \tparam Handler                   Type of the handler object.
+     *
+     * \param [in] a_handler             Handler object (e.g. "std::ref(handler)") which will be called once "workspace"
+     *                                   event is triggered.
+     *
+     * \throws std::system_error         When system error occurs while subscribing to i3's event.
+     *
+     * \throws i3_ipc_bad_message        When i3's message is invalid.
+     *
+     * \throws i3_ipc_invalid_argument   When i3 declines subscription request.
+     */
+    template<typename Handler>
+    void on_workspace_event(std::reference_wrapper<Handler> a_handler) const;
+
     /**
      * \brief                            Subscribes to "output" event and stores callback function for it.
      *
@@ -323,6 +635,25 @@ public:
      */
     void on_output_event(const std::function<void(const i3_containers::output_event&)>& a_callback) const;
 
+    /**
+     * \brief                            Subscribes to "output" event and stores reference to handler for it.<br>
+     *                                   Handler is neither copied nor wrapped in "std::function", so it must outlive
+     *                                   the subscription.
+     *
+     * \tparam Handler                   Type of the handler object.
+     *
+     * \param [in] a_handler             Handler object (e.g. "std::ref(handler)") which will be called once "output"
+     *                                   event is triggered.
+     *
+     * \throws std::system_error         When system error occurs while subscribing to i3's event.
+     *
+     * \throws i3_ipc_bad_message        When i3's message is invalid.
+     *
+     * \throws i3_ipc_invalid_argument   When i3 declines subscription request.
+     */
+    template<typename Handler>
+    void on_output_event(std::reference_wrapper<Handler> a_handler) const;
+
     /**
      * \brief                            Subscribes to "mode" event and stores callback function for it.
      *
@@ -336,6 +667,25 @@ public:
      */
     void on_mode_event(const std::function<void(const i3_containers::mode_event&)>& a_callback) const;
 
+    /**
+     * \brief                            Subscribes to "mode" event and stores reference to handler for it.<br>
+     *                                   Handler is neither copied nor wrapped in "std::function", so it must outlive
+     *                                   the subscription.
+     *
+     * \tparam Handler                   Type of the handler object.
+     *
+     * \param [in] a_handler             Handler object (e.g. "std::ref(handler)") which will be called once "mode"
+     *                                   event is triggered.
+     *
+     * \throws std::system_error         When system error occurs while subscribing to i3's event.
+     *
+     * \throws i3_ipc_bad_message        When i3's message is invalid.
+     *
+     * \throws i3_ipc_invalid_argument   When i3 declines subscription request.
+     */
+    template<typename Handler>
+    void on_mode_event(std::reference_wrapper<Handler> a_handler) const;
+
     /**
      * \brief                            Subscribes to "window" event and stores callback function for it.
      *
@@ -349,6 +699,25 @@ public:
      */
     void on_window_event(const std::function<void(const i3_containers::window_event&)>& a_callback) const;
 
+    /**
+     * \brief                            Subscribes to "window" event and stores reference to handler for it.<br>
+     *                                   Handler is neither copied nor wrapped in "std::function", so it must outlive
+     *                                   the subscription.
+     *
+     * \tparam Handler                   Type of the handler object.
+     *
+     * \param [in] a_handler             Handler object (e.g. "std::ref(handler)") which will be called once "window"
+     *                                   event is triggered.
+     *
+     * \throws std::system_error         When system error occurs while subscribing to i3's event.
+     *
+     * \throws i3_ipc_bad_message        When i3's message is invalid.
+     *
+     * \throws i3_ipc_invalid_argument   When i3 declines subscription request.
+     */
+    template<typename Handler>
+    void on_window_event(std::reference_wrapper<Handler> a_handler) const;
+
     /**
      * \brief                            Subscribes to "bar_config" event and stores callback function for it.
      *
@@ -362,6 +731,25 @@ public:
      */
     void on_bar_config_event(const std::function<void(const i3_containers::bar_config&)>& a_callback) const;
 
+    /**
+     * \brief                            Subscribes to "bar_config" event and stores reference to handler for it.<br>
+     *                                   Handler is neither copied nor wrapped in "std::function", so it must outlive
+     *                                   the subscription.
+     *
+     * \tparam Handler                   Type of the handler object.
+     *
+     * \param [in] a_handler             Handler object (e.g. "std::ref(handler)") which will be called once
+     *                                   "bar_config" event is triggered.
+     *
+     * \throws std::system_error         When system error occurs while subscribing to i3's event.
+     *
+     * \throws i3_ipc_bad_message        When i3's message is invalid.
+     *
+     * \throws i3_ipc_invalid_argument   When i3 declines subscription request.
+     */
+    template<typename Handler>
+    void on_bar_config_event(std::reference_wrapper<Handler> a_handler) const;
+
     /**
      * \brief                            Subscribes to "binding" event and stores callback function for it.
      *
@@ -375,6 +763,25 @@ public:
      */
     void on_binding_event(const std::function<void(const i3_containers::binding_event&)>& a_callback) const;
 
+    /**
+     * \brief                            Subscribes to "binding" event and stores reference to handler for it.<br>
+     *                                   Handler is neither copied nor wrapped in "std::function", so it must outlive
+     *                                   the subscription.
+     *
+     * \tparam Handler                   Type of the handler object.
+     *
+     * \param [in] a_handler             Handler object (e.g. "std::ref(handler)") which will be called once "binding"
+     *                                   event is triggered.
+     *
+     * \throws std::system_error         When system error occurs while subscribing to i3's event.
+     *
+     * \throws i3_ipc_bad_message        When i3's message is invalid.
+     *
+     * \throws i3_ipc_invalid_argument   When i3 declines subscription request.
+     */
+    template<typename Handler>
+    void on_binding_event(std::reference_wrapper<Handler> a_handler) const;
+
     /**
      * \brief                            Subscribes to "shutdown" event and stores callback function for it.
      *
@@ -388,6 +795,25 @@ public:
      */
     void on_shutdown_event(const std::function<void(const i3_containers::shutdown_event&)>& a_callback) const;
 
+    /**
+     * \brief                            Subscribes to "shutdown" event and stores reference to handler for it.<br>
+     *                                   Handler is neither copied nor wrapped in "std::function", so it must outlive
+     *                                   the subscription.
+     *
+     * \tparam Handler                   Type of the handler object.
+     *
+     * \param [in] a_handler             Handler object (e.g. "std::ref(handler)") which will be called once "shutdown"
+     *                                   event is triggered.
+     *
+     * \throws std::system_error         When system error occurs while subscribing to i3's event.
+     *
+     * \throws i3_ipc_bad_message        When i3's message is invalid.
+     *
+     * \throws i3_ipc_invalid_argument   When i3 declines subscription request.
+     */
+    template<typename Handler>
+    void on_shutdown_event(std::reference_wrapper<Handler> a_handler) const;
+
     /**
      * \brief                            Subscribes to "tick" event and stores callback function for it.
      *
@@ -402,36 +828,112 @@ public:
     void on_tick_event(const std::function<void(const i3_containers::tick_event&)>& a_callback) const;
 
     /**
-     * \brief                       Handles next event by calling appropriate callback with parsed event info.
+     * \brief                            Subscribes to "tick" event and stores reference to handler for it.<br>
+     *                                   Handler is neither copied nor wrapped in "std::function", so it must outlive
+     *                                   the subscription.
      *
-     * \return                      Type of handled event.
+     * \tparam Handler                   Type of the handler object.
      *
-     * \throws std::system_error    When system error occurs while reading from event socket.
+     * \param [in] a_handler             Handler object (e.g. "std::ref(handler)") which will be called once "tick"
+     *                                   event is triggered.
      *
-     * \throws i3_ipc_bad_message   When read message is invalid.
+     * \throws std::system_error         When system error occurs while subscribing to i3's event.
      *
-     * \throws i3_ipc_unsupported   When value of some property is unknown to "i3-ipc++" library during parsing.
+     * \throws i3_ipc_bad_message        When i3's message is invalid.
+     *
+     * \throws i3_ipc_invalid_argument   When i3 declines subscription request.
+     */
+    template<typename Handler>
+    void on_tick_event(std::reference_wrapper<Handler> a_handler) const;
+
+    /**
+     * \brief                          Handles next event by calling appropriate callback with parsed event info.
+     *
+     * \return                         Type of handled event.
+     *
+     * \throws std::system_error       When system error occurs while reading from event socket.
+     *
+     * \throws i3_ipc_bad_message      When read message is invalid.
+     *
+     * \throws i3_ipc_unsupported      When value of some property is unknown to "i3-ipc++" library during parsing.
+     *
+     * \throws i3_ipc_queue_overflow   When events were dropped by "overflow_policy::resync".
      */
     event_type handle_next_event();
 
+    /**
+     * \brief                          Waits for the next event, then handles it together with every other event
+     *                                 which is available without blocking (queued or already sent by i3) with single
+     *                                 callback. Events which arrive while these are being read are left for the next
+     *                                 call.<br>
+     *                                 Events are grouped by type and passed to "a_callback" at once, so consumers can
+     *                                 apply many changes and react only once. Callbacks of "on_*_event" functions are
+     *                                 not called for these events, but those functions are still used to subscribe to
+     *                                 them.
+     *
+     * \param [in] a_callback          Callback which receives all handled events.
+     *
+     * \return                         Number of handled events.
+     *
+     * \throws std::system_error       When system error occurs while reading from event socket.
+     *
+     * \throws i3_ipc_bad_message      When read message is invalid.
+     *
+     * \throws i3_ipc_unsupported      When value of some property is unknown to "i3-ipc++" library during parsing.
+     *                                 Events which were parsed before the problematic one are passed to "a_callback"
+     *                                 first, and the ones after it are left for the next call.
+     *
+     * \throws i3_ipc_queue_overflow   When events were dropped by "overflow_policy::resync". Events which were queued
+     *                                 before that are passed to "a_callback" first.
+     */
+    std::size_t handle_pending_events(const std::function<void(const i3_containers::event_batch&)>& a_callback);
+
 private:
 
+    /// \cond DO_NOT_DOCUMENT
+    template<typename Handler, typename... Events> friend class i3_event_dispatcher;
+    /// \endcond
+
     /**
-     * \brief   Type used to store the variant of any supported event callback.
+     * \brief   Structure used to represent i3 event whose payload is not parsed yet.
+     */
+    struct raw_event
+    {
+        event_type type;     /**< Type of the event.                */
+        std::string payload; /**< Event info in JSON format from i3. */
+    };
+
+    /**
+     * \brief   Type used to store the variant of any supported event callback.<br>
+     *          Callback is only referred to, so calling it costs single indirect call.
      */
     // NOTE: Keep the size and order of elements synced with "i3_ipc::event_type" and "i3_containers::event".
     using i3_callback = std::variant<
-                                     std::function<void(const i3_containers::workspace_event&)>,
-                                     std::function<void(const i3_containers::output_event&)>,
-                                     std::function<void(const i3_containers::mode_event&)>,
-                                     std::function<void(const i3_containers::window_event&)>,
-                                     std::function<void(const i3_containers::bar_config_event&)>,
-                                     std::function<void(const i3_containers::binding_event&)>,
-                                     std::function<void(const i3_containers::shutdown_event&)>,
-                                     std::function<void(const i3_containers::tick_event&)>
+                                     i3_function_ref<void(const i3_containers::workspace_event&)>,
+                                     i3_function_ref<void(const i3_containers::output_event&)>,
+                                     i3_function_ref<void(const i3_containers::mode_event&)>,
+                                     i3_function_ref<void(const i3_containers::window_event&)>,
+                                     i3_function_ref<void(const i3_containers::bar_config_event&)>,
+                                     i3_function_ref<void(const i3_containers::binding_event&)>,
+                                     i3_function_ref<void(const i3_containers::shutdown_event&)>,
+                                     i3_function_ref<void(const i3_containers::tick_event&)>
                                     >;
     static_assert(std::variant_size_v<i3_callback> == number_of_event_types, "Each event type must have one variant!");
 
+    /**
+     * \brief   Structure used to store callback together with the object which owns it, if library owns it.
+     */
+    struct i3_subscription
+    {
+        i3_callback callback;        /**< Reference to the callback.                                       */
+        std::shared_ptr<void> owner; /**< Owner of "std::function" callback, or null for handler objects. */
+    };
+
+    /**
+     * \brief   Type used to store the callback of each event type, if it is set.
+     */
+    using i3_callbacks = std::array<std::optional<i3_subscription>, number_of_event_types>;
+
     /**
      * \brief   Type used to store any i3 event info or exception that prevented library from getting the info.
      */
@@ -440,7 +942,46 @@ private:
     /**
      * \brief   Type used to store any callback function or any i3 event info.
      */
-    using i3_ipc_event = std::variant<i3_callback, i3_event>;
+    using i3_ipc_event = std::variant<i3_subscription, i3_event>;
+
+    /**
+     * \brief   Structure used to store i3-ipc event in event queue together with the info needed to limit the queue.
+     */
+    struct queued_event
+    {
+        i3_ipc_event event;             /**< Queued subscription or event info.                           */
+        std::optional<event_type> type; /**< Type of the event, or std::nullopt if it can't be dropped.   */
+        std::size_t size;               /**< Size of the event's JSON payload, or 0 if it has no payload. */
+    };
+
+    /**
+     * \brief                   Creates subscription which owns the copy of given callback function.
+     *
+     * \tparam Event            Type of the event info passed to callback.
+     *
+     * \param [in] a_callback   Callback function to be copied.
+     *
+     * \return                  Subscription which refers to the copy of "a_callback".
+     */
+    template<typename Event>
+    static i3_subscription make_subscription(const std::function<void(const Event&)>& a_callback);
+
+    /**
+     * \brief                  Creates subscription which refers to given handler object without owning it.
+     *
+     * \tparam Event           Type of the event info passed to handler.
+     *
+     * \tparam Handler         Type of the handler object.
+     *
+     * \param [in] a_handler   Handler object to be referred to.
+     *
+     * \return                 Subscription which refers to "a_handler".
+     */
+    template<typename Event, typename Handler>
+    static i3_subscription make_subscription(Handler& a_handler)
+    {
+        return i3_subscription{ i3_function_ref<void(const Event&)>(a_handler), nullptr };
+    }
 
     /**
      * \brief                       Sends the specified request to i3 and returns its response.
@@ -457,12 +998,57 @@ private:
      */
     std::string send_request(i3_message::type a_type, const std::optional<std::string_view>& a_payload = std::nullopt) const;
 
+    /**
+     * \brief                       Sends the specified request to i3 and parses its response while it is being read.
+     *
+     * \param [in] a_type           Type of the request.
+     *
+     * \param [in] a_parser         Function which parses the response from given stream. Whatever is left unread
+     *                              after it returns (or throws) is dropped from the socket.
+     *
+     * \param [in] a_payload        Optional content of the message.
+     *
+     * \throws std::system_error    When system error occurs while sending/receiving message through socket.
+     *
+     * \throws i3_ipc_bad_message   When i3's message is invalid.
+     */
+    void send_streamed_request(i3_message::type a_type,
+                               const std::function<void(i3_message::payload_stream&)>& a_parser,
+                               const std::optional<std::string_view>& a_payload = std::nullopt) const;
+
+    /**
+     * \brief                       Reads messages from the socket until the header of requested response is read.<br>
+     *                              Every event read in the meantime is parsed and pushed to event queue.
+     *
+     * \param [in] a_type           Type of the expected response.
+     *
+     * \return                      Header of the response, whose payload is still unread in the socket.
+     *
+     * \throws std::system_error    When system error occurs while receiving message through socket.
+     *
+     * \throws i3_ipc_bad_message   When i3's message is invalid.
+     */
+    i3_message::header receive_response_header(i3_message::type a_type) const;
+
     /**
      * \brief                            Subscribes to i3's event and pushes the provided callback to event queue.
      *
      * \param [in] a_event_type          Type of event for which subscription request will be sent.
      *
-     * \param [in] a_callback            Callback function which will be stored for execution on "a_event_type" event.
+     * \param [in] a_subscription        Callback which will be stored for execution on "a_event_type" event.
+     *
+     * \throws std::system_error         When system error occurs while sending/receiving message through socket.
+     *
+     * \throws i3_ipc_bad_message        When i3's message is invalid.
+     *
+     * \throws i3_ipc_invalid_argument   When i3 declines subscription request.
+     */
+    void subscribe(event_type a_event_type, i3_subscription a_subscription) const;
+
+    /**
+     * \brief                            Subscribes to several i3's events with single request, without any callback.
+     *
+     * \param [in] a_event_types         Types of events for which subscription request will be sent.
      *
      * \throws std::system_error         When system error occurs while sending/receiving message through socket.
      *
@@ -470,14 +1056,46 @@ private:
      *
      * \throws i3_ipc_invalid_argument   When i3 declines subscription request.
      */
-    void subscribe(event_type a_event_type, const i3_callback& a_callback) const;
+    void subscribe(std::initializer_list<event_type> a_event_types) const;
 
     /**
-     * \brief                   Stores provided callback in appropriate element of "m_callbacks".
+     * \brief                       Receives next event from event socket without parsing its payload.
+     *
+     * \return                      Type and unparsed payload of received event.
      *
-     * \param [in] a_callback   Callback to be stored for later use for specific event.
+     * \throws std::system_error    When system error occurs while reading from event socket.
+     *
+     * \throws i3_ipc_bad_message   When read message is invalid or it is not an event.
      */
-    void handle_subscription_event(const i3_callback& a_callback);
+    raw_event receive_raw_event() const;
+
+    // NOTE: Each overload calls only the parser of its own event type, so that code which dispatches on event type
+    //       at compile time references only the parsers it actually needs.
+    /// \cond DO_NOT_DOCUMENT
+    static i3_containers::workspace_event parse_event(const char* a_json_string,
+                                                      std::in_place_type_t<i3_containers::workspace_event>);
+    static i3_containers::output_event parse_event(const char* a_json_string,
+                                                   std::in_place_type_t<i3_containers::output_event>);
+    static i3_containers::mode_event parse_event(const char* a_json_string,
+                                                 std::in_place_type_t<i3_containers::mode_event>);
+    static i3_containers::window_event parse_event(const char* a_json_string,
+                                                   std::in_place_type_t<i3_containers::window_event>);
+    static i3_containers::bar_config_event parse_event(const char* a_json_string,
+                                                       std::in_place_type_t<i3_containers::bar_config_event>);
+    static i3_containers::binding_event parse_event(const char* a_json_string,
+                                                    std::in_place_type_t<i3_containers::binding_event>);
+    static i3_containers::shutdown_event parse_event(const char* a_json_string,
+                                                     std::in_place_type_t<i3_containers::shutdown_event>);
+    static i3_containers::tick_event parse_event(const char* a_json_string,
+                                                 std::in_place_type_t<i3_containers::tick_event>);
+    /// \endcond
+
+    /**
+     * \brief                       Moves provided callback into appropriate element of "m_callbacks".
+     *
+     * \param [in] a_subscription   Callback to be stored for later use for specific event.
+     */
+    void handle_subscription_event(i3_subscription&& a_subscription);
 
     /**
      * \brief                       Handles i3 event by calling appropriate callback with provided data.
@@ -500,7 +1118,7 @@ private:
      *
      * \throws i3_ipc_unsupported   When value of some property is unknown to "i3-ipc++" library during parsing.
      */
-    std::optional<event_type> handle_i3_ipc_event(const i3_ipc_event& a_i3_ipc_event);
+    std::optional<event_type> handle_i3_ipc_event(i3_ipc_event&& a_i3_ipc_event);
 
     /**
      * \brief                       Handles next i3-ipc event from even queue or event socket.
@@ -516,11 +1134,127 @@ private:
      */
     std::optional<event_type> handle_next_i3_ipc_event();
 
-    std::string m_i3_socket_path;                               /**< Path to i3's socket.                      */
-    int m_socket;                                               /**< Socket used for communication with i3.    */
-    std::array<i3_callback, number_of_event_types> m_callbacks; /**< List of callback functions for i3 events. */
-    mutable std::queue<i3_ipc_event> m_event_queue;             /**< Queue of parsed events/subscrpitions.     */
+    /**
+     * \brief                       Reads the burst of events from event socket, coalesces them and pushes the rest
+     *                              of them to event queue.
+     *
+     * \return                      Number of bytes read from event socket.
+     *
+     * \throws std::system_error    When system error occurs while reading from event socket.
+     *
+     * \throws i3_ipc_bad_message   When read message is invalid.
+     */
+    std::size_t receive_coalesced_events() const;
+
+    /**
+     * \brief                       Reads next event (or the burst of events, if coalescing is enabled) from event
+     *                              socket and pushes it to event queue.
+     *
+     * \return                      Number of bytes read from event socket.
+     *
+     * \throws std::system_error    When system error occurs while reading from event socket.
+     *
+     * \throws i3_ipc_bad_message   When read message is invalid.
+     */
+    std::size_t receive_events() const;
+
+    /**
+     * \brief                       Parses given event message and pushes it to event queue.<br>
+     *                              If event can't be parsed, the exception is pushed instead.
+     *
+     * \param [in] a_message        Event message received from i3.
+     *
+     * \throws i3_ipc_bad_message   When message is not an event.
+     */
+    void push_event(const i3_message::response& a_message) const;
+
+    /**
+     * \brief                       Pushes given i3-ipc event to event queue, applying the limits of event queue.
+     *
+     * \param [in] a_queued_event   Event which should be queued.
+     */
+    void push_queued_event(queued_event&& a_queued_event) const;
+
+    /**
+     * \brief    Removes the first i3-ipc event from event queue.
+     *
+     * \return   Removed i3-ipc event.
+     */
+    i3_ipc_event pop_queued_event() const;
+
+    /**
+     * \brief    Checks whether more events can be read from event socket without being forced to queue them past
+     *           the limits of "overflow_policy::block".
+     *
+     * \return   True if events can be read, false otherwise.
+     */
+    bool can_receive_events() const;
+
+    std::string m_i3_socket_path;                                /**< Path to i3's socket.                      */
+    int m_socket;                                                /**< Socket used for communication with i3.    */
+    i3_callbacks m_callbacks;                                    /**< List of callback functions for i3 events. */
+    mutable std::deque<queued_event> m_event_queue;              /**< Queue of parsed events/subscrpitions.     */
+    mutable std::size_t m_queued_events;                         /**< Number of events in event queue.          */
+    mutable std::size_t m_queued_bytes;                          /**< Size of payloads of queued events.        */
+    mutable bool m_is_resync_queued;                             /**< Whether resync is waiting to be handled.  */
+    std::size_t m_tree_parsing_threads;                          /**< Number of threads used for parsing tree.  */
+    std::unique_ptr<i3_thread_pool> m_tree_parsing_pool;         /**< Workers for parsing tree, or null.        */
+    std::shared_ptr<i3_containers::string_pool> m_string_pool;   /**< Pool shared by compact trees, or null.    */
+    std::optional<std::chrono::milliseconds> m_event_coalescing; /**< Coalescing window, or std::nullopt.       */
+    std::optional<event_queue_limits> m_event_queue_limits;      /**< Limits of event queue, or std::nullopt.   */
 
 }; // class i3_ipc
 
+/// \cond DO_NOT_DOCUMENT
+
+template<typename Handler>
+void i3_ipc::on_workspace_event(std::reference_wrapper<Handler> a_handler) const
+{
+    subscribe(event_type::workspace, make_subscription<i3_containers::workspace_event>(a_handler.get()));
+}
+
+template<typename Handler>
+void i3_ipc::on_output_event(std::reference_wrapper<Handler> a_handler) const
+{
+    subscribe(event_type::output, make_subscription<i3_containers::output_event>(a_handler.get()));
+}
+
+template<typename Handler>
+void i3_ipc::on_mode_event(std::reference_wrapper<Handler> a_handler) const
+{
+    subscribe(event_type::mode, make_subscription<i3_containers::mode_event>(a_handler.get()));
+}
+
+template<typename Handler>
+void i3_ipc::on_window_event(std::reference_wrapper<Handler> a_handler) const
+{
+    subscribe(event_type::window, make_subscription<i3_containers::window_event>(a_handler.get()));
+}
+
+template<typename Handler>
+void i3_ipc::on_bar_config_event(std::reference_wrapper<Handler> a_handler) const
+{
+    subscribe(event_type::bar_config_update, make_subscription<i3_containers::bar_config>(a_handler.get()));
+}
+
+template<typename Handler>
+void i3_ipc::on_binding_event(std::reference_wrapper<Handler> a_handler) const
+{
+    subscribe(event_type::binding, make_subscription<i3_containers::binding_event>(a_handler.get()));
+}
+
+template<typename Handler>
+void i3_ipc::on_shutdown_event(std::reference_wrapper<Handler> a_handler) const
+{
+    subscribe(event_type::shutdown, make_subscription<i3_containers::shutdown_event>(a_handler.get()));
+}
+
+template<typename Handler>
+void i3_ipc::on_tick_event(std::reference_wrapper<Handler> a_handler) const
+{
+    subscribe(event_type::tick, make_subscription<i3_containers::tick_event>(a_handler.get()));
+}
+
+/// \endcond
+
 #endif // I3_IPC_HPP
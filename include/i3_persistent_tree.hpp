@@ -0,0 +1,229 @@
+/*
+    Copyright (C) 2019, Ivan Balević
+
+    This file is part of "i3-ipc++" library.
+
+    "i3-ipc++" is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    "i3-ipc++" is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with "i3-ipc++". If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+ * \file    i3_persistent_tree.hpp
+ *
+ * \brief   Defines "i3_containers::persistent_node" and "i3_containers::snapshot_store" classes used for sharing
+ *          immutable tree snapshots between threads.
+ */
+
+#ifndef I3_PERSISTENT_TREE_HPP
+#define I3_PERSISTENT_TREE_HPP
+
+// Library headers.
+#include "i3_containers.hpp"
+
+// C++ headers.
+#include <deque>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <functional>
+
+// C headers.
+#include <cstddef>
+#include <cstdint>
+
+namespace i3_containers
+{
+    /**
+     * \brief   Class used to represent one node of immutable, reference-counted node tree.<br>
+     *          Node is never changed after construction, so it can be read from any number of threads without
+     *          synchronization. Every update returns new root which copies only the nodes on the path from the
+     *          changed node up to the root, while every other subtree is shared with the previous version.
+     */
+    class persistent_node : public std::enable_shared_from_this<persistent_node>
+    {
+
+    public:
+
+        /**
+         * \brief   Type used to refer to the nodes. Node stays alive as long as any version of the tree uses it.
+         */
+        using pointer = std::shared_ptr<const persistent_node>;
+
+        /**
+         * \brief                    Converts regular tree into persistent one.
+         *
+         * \param [in] a_tree        Root node of the tree, whose info is moved into persistent nodes.
+         *
+         * \return                   Root node of persistent tree.
+         *
+         * \throws std::bad_alloc    When bad allocation occurs while creating the nodes.
+         */
+        static pointer make(node a_tree);
+
+        /**
+         * \brief    Returns the info about this node.
+         *
+         * \return   Info about this node. Its "nodes" and "floating_nodes" are always empty, child nodes are
+         *           available through "get_nodes" and "get_floating_nodes".
+         */
+        const node& get_info() const;
+
+        /**
+         * \brief    Returns the tiling child nodes.
+         *
+         * \return   Tiling child nodes of this node.
+         */
+        const std::vector<pointer>& get_nodes() const;
+
+        /**
+         * \brief    Returns the floating child nodes.
+         *
+         * \return   Floating child nodes of this node.
+         */
+        const std::vector<pointer>& get_floating_nodes() const;
+
+        /**
+         * \brief    Converts the subtree of this node into regular tree.
+         *
+         * \return   Deep copy of this subtree.
+         */
+        node to_node() const;
+
+        /**
+         * \brief                    Creates new version of the tree in which the info of one node is updated.
+         *
+         * \param [in] a_id          ID of the node to be updated.
+         *
+         * \param [in] a_update      Function which changes the copy of the node's info. Changes of its "nodes" and
+         *                           "floating_nodes" are ignored.
+         *
+         * \return                   Root of the new version, or this node if there is no node with "a_id".
+         *
+         * \throws std::bad_alloc    When bad allocation occurs while copying the path to the root.
+         */
+        pointer update(std::uint64_t a_id, const std::function<void(node&)>& a_update) const;
+
+        /**
+         * \brief                    Creates new version of the tree in which one subtree is replaced.
+         *
+         * \param [in] a_id          ID of the node whose subtree is replaced.
+         *
+         * \param [in] a_subtree     New subtree. If it is null, the subtree is removed.
+         *
+         * \return                   Root of the new version, or this node if there is no node with "a_id".
+         *                           Null if the root itself is removed.
+         *
+         * \throws std::bad_alloc    When bad allocation occurs while copying the path to the root.
+         */
+        pointer replace(std::uint64_t a_id, pointer a_subtree) const;
+
+        /**
+         * \brief                    Creates new version of the tree in which one subtree is added as the last child.
+         *
+         * \param [in] a_parent_id   ID of the node which receives new child node.
+         *
+         * \param [in] a_subtree     Subtree to be added.
+         *
+         * \param [in] a_floating    Whether the subtree is added to floating child nodes or not.
+         *
+         * \return                   Root of the new version, or this node if there is no node with "a_parent_id".
+         *
+         * \throws std::bad_alloc    When bad allocation occurs while copying the path to the root.
+         */
+        pointer insert(std::uint64_t a_parent_id, pointer a_subtree, bool a_floating = false) const;
+
+    private:
+
+        /**
+         * \brief   Type of function which creates new version of the node that was found.
+         */
+        using transformation = std::function<pointer(const persistent_node&)>;
+
+        /// \cond DO_NOT_DOCUMENT
+        persistent_node(node a_info, std::vector<pointer> a_nodes, std::vector<pointer> a_floating_nodes);
+        /// \endcond
+
+        /**
+         * \brief                    Creates new version of this subtree in which the node with given ID is
+         *                           transformed, copying only the nodes on the path to it.
+         *
+         * \param [in] a_id          ID of the node to be transformed.
+         *
+         * \param [in] a_transform   Function which creates new version of the node (null removes the node).
+         *
+         * \return                   New version of this subtree, or this node if there is no node with "a_id".
+         */
+        pointer rebuild(std::uint64_t a_id, const transformation& a_transform) const;
+
+        node m_info;                           /**< Info about this node, without child nodes. */
+        std::vector<pointer> m_nodes;          /**< The tiling child nodes.                    */
+        std::vector<pointer> m_floating_nodes; /**< The floating child nodes.                  */
+    };
+
+    /**
+     * \brief   Class used to publish the versions of persistent tree to any number of reader threads.<br>
+     *          Publishing is a single atomic swap of the root pointer (RCU-style): readers that already hold the
+     *          previous version keep using it, and it is released when the last of them drops it.
+     */
+    // NOTE: All member functions are thread-safe.
+    class snapshot_store
+    {
+
+    public:
+
+        /**
+         * \brief                   Constructs empty store.
+         *
+         * \param [in] a_history    Number of the latest versions kept alive by the store, including the current one.
+         */
+        explicit snapshot_store(std::size_t a_history = 1);
+
+        /// \cond DO_NOT_DOCUMENT
+        snapshot_store(const snapshot_store& a_store) = delete;
+        snapshot_store& operator=(const snapshot_store& a_store) = delete;
+        /// \endcond
+
+        /**
+         * \brief                   Makes given version the current one.
+         *
+         * \param [in] a_snapshot   Root of the new version.
+         */
+        void publish(persistent_node::pointer a_snapshot);
+
+        /**
+         * \brief    Returns the current version. It never waits for "publish".
+         *
+         * \return   Root of the current version, or null if nothing is published yet.
+         */
+        persistent_node::pointer get_current() const;
+
+        /**
+         * \brief    Returns the latest versions kept by the store.
+         *
+         * \return   Roots of the latest versions, from the oldest to the current one.
+         */
+        std::vector<persistent_node::pointer> get_history() const;
+
+    private:
+
+        // NOTE: Only the current version is accessed atomically, history is guarded by mutex since only the
+        //       writers and "get_history" use it.
+        persistent_node::pointer m_current;             /**< Current version, accessed only atomically.   */
+        const std::size_t m_history_size;               /**< Number of kept versions.                     */
+        mutable std::mutex m_history_mutex;             /**< Mutex which guards "m_history".              */
+        std::deque<persistent_node::pointer> m_history; /**< Latest versions, from the oldest to current. */
+    };
+
+} // i3_containers namespace
+
+#endif // I3_PERSISTENT_TREE_HPP
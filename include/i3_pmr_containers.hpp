@@ -0,0 +1,130 @@
+/*
+    Copyright (C) 2019, Ivan Balević
+
+    This file is part of "i3-ipc++" library.
+
+    "i3-ipc++" is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    "i3-ipc++" is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with "i3-ipc++". If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+ * \file    i3_pmr_containers.hpp
+ *
+ * \brief   Defines "i3_containers::pmr" namespace which provides variants of the containers that allocate all of
+ *          their memory from user-provided memory resource.
+ */
+
+#ifndef I3_PMR_CONTAINERS_HPP
+#define I3_PMR_CONTAINERS_HPP
+
+// Library headers.
+#include "i3_containers.hpp"
+
+// C++ headers.
+#include <string>
+#include <vector>
+#include <optional>
+#include <memory_resource>
+
+// C headers.
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * \brief   Defines allocator-aware variants of the containers whose size depends on the data received from i3.<br>
+ *          They follow the rules of "std::pmr" containers: memory resource is given on construction and it is
+ *          propagated to every nested string and container, but it is not propagated on copy or assignment.
+ */
+namespace i3_containers::pmr
+{
+    /**
+     * \brief   Allocator type used by all containers in this namespace.
+     */
+    using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+    /**
+     * \brief   Structure used to represent X11 window properties.
+     */
+    struct x11_window
+    {
+        /// \cond DO_NOT_DOCUMENT
+        using allocator_type = i3_containers::pmr::allocator_type;
+
+        x11_window() = default;
+        explicit x11_window(const allocator_type& a_allocator);
+        x11_window(const x11_window& a_window);
+        x11_window(const x11_window& a_window, const allocator_type& a_allocator);
+        x11_window(x11_window&& a_window) = default;
+        x11_window(x11_window&& a_window, const allocator_type& a_allocator);
+        x11_window& operator=(const x11_window& a_window);
+        x11_window& operator=(x11_window&& a_window);
+
+        allocator_type get_allocator() const;
+        /// \endcond
+
+        std::optional<std::pmr::string> window_class;    /**< X11 window class (WM_CLASS class).                     */
+        std::optional<std::pmr::string> window_instance; /**< X11 window class instance (WM_CLASS instance).         */
+        std::optional<std::pmr::string> window_role;     /**< X11 window role (WM_WINDOW_ROLE).                      */
+        std::optional<std::pmr::string> window_title;    /**< X11 window title in UTF-8 (_NET_WM_NAME).              */
+        std::optional<std::uint64_t> transient_for;      /**< X11 window ID of the parent window (WM_TRANSIENT_FOR). */
+
+    private:
+
+        allocator_type m_allocator; /**< Allocator used for the strings, since they are stored inside of optionals. */
+    };
+
+    /**
+     * \brief   Structure used to represent one i3 node/container.
+     */
+    struct node
+    {
+        /// \cond DO_NOT_DOCUMENT
+        using allocator_type = i3_containers::pmr::allocator_type;
+
+        node() = default;
+        explicit node(const allocator_type& a_allocator);
+        node(const node& a_node) = default;
+        node(const node& a_node, const allocator_type& a_allocator);
+        node(node&& a_node) = default;
+        node(node&& a_node, const allocator_type& a_allocator);
+        node& operator=(const node& a_node);
+        node& operator=(node&& a_node);
+
+        allocator_type get_allocator() const;
+        /// \endcond
+
+        std::uint64_t id = 0;                             /**< ID of the container.                                   */
+        std::optional<std::pmr::string> name;             /**< Name of the container.                                 */
+        node_type type = node_type::con;                  /**< Type of the container.                                 */
+        border_style border = border_style::normal;       /**< Border style of the container.                         */
+        std::optional<std::uint8_t> current_border_width; /**< Border width of the container.                         */
+        node_layout layout = node_layout::splith;         /**< Layout of the current container.                       */
+        std::optional<float> percent;                     /**< Percentage of surface taken from parent container.     */
+        rectangle rect = { };                             /**< Absolute display coordinates for the container.        */
+        rectangle window_rect = { };                      /**< Coordinates of container relative to parent container. */
+        rectangle deco_rect = { };                        /**< Coordinates of window decorations inside container.    */
+        rectangle geometry = { };                         /**< Geometry the window specified when i3 mapped it.       */
+        std::optional<std::uint64_t> window;              /**< X11 window ID of the client inside the container.      */
+        std::optional<x11_window> window_properties;      /**< X11 properties of the window.                          */
+        bool is_urgent = false;                           /**< Whether the container is (in)directly urgent or not.   */
+        bool is_focused = false;                          /**< Whether the container is currently focused or not.     */
+        std::pmr::vector<std::uint64_t> focus;            /**< List of child node IDs in focus order.                 */
+        fullscreen_mode_type fullscreen_mode = { };       /**< The fullscreen mode of the container.                  */
+        std::pmr::vector<std::pmr::string> marks;         /**< List of marks assigned to container.                   */
+        std::pmr::vector<node> nodes;                     /**< The tiling child containers of this node.              */
+        std::pmr::vector<node> floating_nodes;            /**< The floating child containers of this node.            */
+    };
+
+} // i3_containers::pmr namespace
+
+#endif // I3_PMR_CONTAINERS_HPP
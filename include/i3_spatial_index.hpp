@@ -0,0 +1,173 @@
+/*
+    Copyright (C) 2019, Ivan Balević
+
+    This file is part of "i3-ipc++" library.
+
+    "i3-ipc++" is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    "i3-ipc++" is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with "i3-ipc++". If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+ * \file    i3_spatial_index.hpp
+ *
+ * \brief   Defines "i3_containers::spatial_index" class used to find windows at given point or in given region.
+ */
+
+#ifndef I3_SPATIAL_INDEX_HPP
+#define I3_SPATIAL_INDEX_HPP
+
+// Library headers.
+#include "i3_containers.hpp"
+
+// C++ headers.
+#include <vector>
+#include <unordered_map>
+
+// C headers.
+#include <cstddef>
+#include <cstdint>
+
+namespace i3_containers
+{
+    /**
+     * \brief   Class used to find windows by their position on the screen.<br>
+     *          Screen is divided into uniform grid of square cells and each cell has the list of windows whose
+     *          rectangle ("rect" of the container) overlaps it, so a query checks only the windows in the cells it
+     *          covers, instead of every window in the tree.<br>
+     *          Only visible windows are indexed: windows on hidden workspaces, in the scratchpad and in inactive tabs
+     *          of tabbed or stacked containers keep their last rectangles, but they aren't shown there.
+     */
+    class spatial_index
+    {
+
+    public:
+
+        /**
+         * \brief   Constructs empty index.
+         */
+        spatial_index();
+
+        /**
+         * \brief                    Constructs index of every visible window in given tree.
+         *
+         * \param [in] a_tree        Root node of the tree.
+         *
+         * \throws std::bad_alloc    When bad allocation occurs while indexing the tree.
+         */
+        explicit spatial_index(const node& a_tree);
+
+        /**
+         * \brief                    Adds the window to the index, or updates its rectangle if it is indexed.<br>
+         *                           Window is assumed to be visible.
+         *
+         * \param [in] a_window      Container of the window. Containers without X11 window are ignored.
+         *
+         * \throws std::bad_alloc    When bad allocation occurs while indexing the window.
+         */
+        void insert(const node& a_window);
+
+        /**
+         * \brief                    Removes the window from the index.
+         *
+         * \param [in] a_id          ID of the window's container. Unknown IDs are ignored.
+         */
+        void erase(std::uint64_t a_id);
+
+        /**
+         * \brief                    Updates the index from window event.<br>
+         *                           Windows are added on "create", updated on "move" and "floating" and removed on
+         *                           "close", while other changes don't affect the position of the window.<br>
+         *                           Events don't tell whether the window is visible, so the index has to be rebuilt
+         *                           from new tree after workspace or tab switches, or when windows are moved to
+         *                           hidden workspaces.
+         *
+         * \param [in] a_event       Window event.
+         *
+         * \throws std::bad_alloc    When bad allocation occurs while indexing the window.
+         */
+        void handle_event(const window_event& a_event);
+
+        /**
+         * \brief                    Finds the windows which contain given point.
+         *
+         * \param [in] a_x           X coordinate of the point.
+         *
+         * \param [in] a_y           Y coordinate of the point.
+         *
+         * \return                   IDs of the containers of the windows, in no particular order.
+         *
+         * \throws std::bad_alloc    When bad allocation occurs while collecting the result.
+         */
+        std::vector<std::uint64_t> find_at(std::uint16_t a_x, std::uint16_t a_y) const;
+
+        /**
+         * \brief                    Finds the windows which overlap given region.
+         *
+         * \param [in] a_region      Region of the screen, in absolute display coordinates.
+         *
+         * \return                   IDs of the containers of the windows, in no particular order.
+         *
+         * \throws std::bad_alloc    When bad allocation occurs while collecting the result.
+         */
+        std::vector<std::uint64_t> find_in(const rectangle& a_region) const;
+
+        /**
+         * \brief    Returns the number of indexed windows.
+         *
+         * \return   Number of indexed windows.
+         */
+        std::size_t size() const;
+
+    private:
+
+        /**
+         * \brief   Type used to store the key of one cell: its column in high and its row in low 16 bits.
+         */
+        using cell = std::uint32_t;
+
+        /**
+         * \brief   Binary logarithm of the width and height of a cell in pixels.
+         */
+        static constexpr unsigned cell_size_bits = 8;
+
+        /**
+         * \brief                  Calls given function for every cell which is overlapped by the rectangle.
+         *
+         * \param [in] a_rect      Non-empty rectangle.
+         *
+         * \param [in] a_call      Function which is called with the key of each cell.
+         */
+        template<typename Function>
+        static void for_each_cell(const rectangle& a_rect, const Function& a_call);
+
+        /**
+         * \brief                    Adds every visible window in the subtree of the visible node to the index.
+         *
+         * \param [in] a_node        Visible node.
+         *
+         * \throws std::bad_alloc    When bad allocation occurs while indexing the windows.
+         */
+        void insert_visible(const node& a_node);
+
+        // NOTE: Windows are stored in slots, so that the cells hold only 32-bit slot numbers and query doesn't
+        //       have to look up the rectangle by ID. Slots of removed windows are reused.
+        std::vector<std::uint64_t> m_ids;                             /**< Container ID in each slot.        */
+        std::vector<rectangle> m_rects;                               /**< Rectangle of the window in slot.  */
+        std::vector<std::uint32_t> m_free_slots;                      /**< Slots of removed windows.         */
+        std::unordered_map<std::uint64_t, std::uint32_t> m_slots;     /**< Slot of each container ID.        */
+        std::unordered_map<cell, std::vector<std::uint32_t>> m_cells; /**< Slots overlapping each grid cell. */
+    };
+
+} // i3_containers namespace
+
+#endif // I3_SPATIAL_INDEX_HPP
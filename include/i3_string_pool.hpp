@@ -0,0 +1,90 @@
+/*
+    Copyright (C) 2019, Ivan Balević
+
+    This file is part of "i3-ipc++" library.
+
+    "i3-ipc++" is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    "i3-ipc++" is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with "i3-ipc++". If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+ * \file    i3_string_pool.hpp
+ *
+ * \brief   Defines "i3_containers::string_pool" class used for interning strings that repeat across nodes.
+ */
+
+#ifndef I3_STRING_POOL_HPP
+#define I3_STRING_POOL_HPP
+
+// C++ headers.
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+// C headers.
+#include <cstddef>
+
+namespace i3_containers
+{
+    /**
+     * \brief   Class used to store single copy of each distinct string (e.g. X11 window class or mark).<br>
+     *          Interned strings are never removed, so views returned by the pool stay valid for as long as the pool
+     *          exists, and two views of equal strings from the same pool always point to the same characters.
+     */
+    // NOTE: All member functions are thread-safe.
+    class string_pool
+    {
+
+    public:
+
+        /**
+         * \brief   Constructs empty pool.
+         */
+        string_pool();
+
+        /// \cond DO_NOT_DOCUMENT
+        string_pool(const string_pool& a_pool) = delete;
+        string_pool& operator=(const string_pool& a_pool) = delete;
+        /// \endcond
+
+        /**
+         * \brief                    Returns the copy of given string stored in the pool, adding it if needed.<br>
+         *                           Nothing is allocated if the equal string is already in the pool.
+         *
+         * \param [in] a_string      String to be interned.
+         *
+         * \return                   View of the interned string, valid as long as the pool exists.
+         *
+         * \throws std::bad_alloc    When bad allocation occurs while adding the string.
+         */
+        std::string_view intern(std::string_view a_string);
+
+        /**
+         * \brief    Returns the number of distinct strings in the pool.
+         *
+         * \return   Number of distinct strings in the pool.
+         */
+        std::size_t size() const;
+
+    private:
+
+        mutable std::mutex m_mutex;                   /**< Mutex which guards both containers.                  */
+        std::deque<std::string> m_strings;            /**< Interned strings, which are never moved in memory.   */
+        std::unordered_set<std::string_view> m_index; /**< Views of "m_strings", used for finding equal string. */
+    };
+
+} // i3_containers namespace
+
+#endif // I3_STRING_POOL_HPP
@@ -0,0 +1,127 @@
+/*
+    Copyright (C) 2019, Ivan Balević
+
+    This file is part of "i3-ipc++" library.
+
+    "i3-ipc++" is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    "i3-ipc++" is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with "i3-ipc++". If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+ * \file    i3_tree_diff.hpp
+ *
+ * \brief   Defines "i3_containers::tree_diff" function used for finding changes between two snapshots of node tree.
+ */
+
+#ifndef I3_TREE_DIFF_HPP
+#define I3_TREE_DIFF_HPP
+
+// Library headers.
+#include "i3_containers.hpp"
+#include "i3_hashed_tree.hpp"
+
+// C++ headers.
+#include <vector>
+
+// C headers.
+#include <cstdint>
+
+namespace i3_containers
+{
+    /**
+     * \brief   Structure used to represent the change of one node between two snapshots of node tree.
+     */
+    struct node_change
+    {
+        /**
+         * \brief   Enumeration of all kinds of node changes.
+         */
+        enum class type : std::uint8_t
+        {
+            added,      /**< Node exists only in the new tree.                                           */
+            removed,    /**< Node exists only in the old tree.                                           */
+            reparented, /**< Node has different parent in the new tree (its fields might differ as well). */
+            changed     /**< Node has the same parent, but some of its fields differ.                     */
+        };
+
+        /**
+         * \brief   Flags of node fields, used in "changed_fields" mask.<br>
+         *          Child nodes are not fields, since their changes are reported separately.
+         */
+        enum field : std::uint32_t
+        {
+            name_field                 = 1u << 0,  /**< "name" differs.                 */
+            type_field                 = 1u << 1,  /**< "type" differs.                 */
+            border_field               = 1u << 2,  /**< "border" differs.               */
+            current_border_width_field = 1u << 3,  /**< "current_border_width" differs. */
+            layout_field               = 1u << 4,  /**< "layout" differs.               */
+            percent_field              = 1u << 5,  /**< "percent" differs.              */
+            rect_field                 = 1u << 6,  /**< "rect" differs.                 */
+            window_rect_field          = 1u << 7,  /**< "window_rect" differs.          */
+            deco_rect_field            = 1u << 8,  /**< "deco_rect" differs.            */
+            geometry_field             = 1u << 9,  /**< "geometry" differs.             */
+            window_field               = 1u << 10, /**< "window" differs.               */
+            window_properties_field    = 1u << 11, /**< "window_properties" differs.    */
+            urgent_field               = 1u << 12, /**< "is_urgent" differs.            */
+            focused_field              = 1u << 13, /**< "is_focused" differs.           */
+            focus_field                = 1u << 14, /**< "focus" differs.                */
+            fullscreen_mode_field      = 1u << 15, /**< "fullscreen_mode" differs.      */
+            marks_field                = 1u << 16  /**< "marks" differs.                */
+        };
+
+        type kind;                    /**< Kind of the change.                                                       */
+        std::uint64_t id;             /**< ID of the changed node.                                                   */
+        std::uint64_t parent_id;      /**< ID of the parent in the new tree (old tree for removed), 0 for root.      */
+        std::uint64_t old_parent_id;  /**< ID of the parent in the old tree, set only for reparented nodes.          */
+        std::uint32_t changed_fields; /**< Mask of "field" flags which differ, set for reparented and changed nodes. */
+    };
+
+    /**
+     * \brief                    Finds changes between two snapshots of node tree, matching the nodes by their IDs.<br>
+     *                           Every node of both trees is visited once, so the time is linear in the size of the
+     *                           trees.
+     *
+     * \param [in] a_old         Root node of the old tree.
+     *
+     * \param [in] a_new         Root node of the new tree.
+     *
+     * \return                   Changes of every node which is added, removed, reparented or changed. Added,
+     *                           reparented and changed nodes come first, in depth-first order of the new tree,
+     *                           followed by removed nodes in depth-first order of the old tree. Every node of added
+     *                           (removed) subtree is reported separately.
+     *
+     * \throws std::bad_alloc    When bad allocation occurs while indexing the old tree.
+     */
+    // NOTE: Order of child nodes within the same parent is not compared, only the "focus" field of the parent.
+    std::vector<node_change> tree_diff(const node& a_old, const node& a_new);
+
+    /**
+     * \brief                    Finds changes between two snapshots of node tree, matching the nodes by their IDs and
+     *                           skipping every subtree whose hash didn't change.<br>
+     *                           Result is the same as for the regular trees, but unchanged subtrees (e.g. idle
+     *                           workspaces) cost constant time instead of being walked.
+     *
+     * \param [in] a_old         Old tree.
+     *
+     * \param [in] a_new         New tree.
+     *
+     * \return                   Changes of every node which is added, removed, reparented or changed, in the same
+     *                           order as for the regular trees.
+     *
+     * \throws std::bad_alloc    When bad allocation occurs while creating the list of changes.
+     */
+    std::vector<node_change> tree_diff(const hashed_tree& a_old, const hashed_tree& a_new);
+
+} // i3_containers namespace
+
+#endif // I3_TREE_DIFF_HPP
@@ -0,0 +1,229 @@
+/*
+    Copyright (C) 2019, Ivan Balević
+
+    This file is part of "i3-ipc++" library.
+
+    "i3-ipc++" is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    "i3-ipc++" is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with "i3-ipc++". If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+ * \file    i3_tree_iterator.hpp
+ *
+ * \brief   Defines "i3_containers::tree_iterator" and "i3_containers::tree_range" classes used for iterating through
+ *          node tree in various orders.
+ */
+
+#ifndef I3_TREE_ITERATOR_HPP
+#define I3_TREE_ITERATOR_HPP
+
+// Library headers.
+#include "i3_containers.hpp"
+
+// C++ headers.
+#include <array>
+#include <vector>
+#include <iterator>
+
+// C headers.
+#include <cstddef>
+#include <cstdint>
+
+namespace i3_containers
+{
+    /**
+     * \brief   Enumerator used to describe the order in which nodes of the tree are visited.<br>
+     *          Children of a node are its tiling nodes followed by its floating nodes, unless stated otherwise.
+     */
+    enum class tree_order : std::uint8_t
+    {
+        pre_order,     /**< Node before its children (depth-first).                                              */
+        post_order,    /**< Node after its children (depth-first).                                               */
+        breadth_first, /**< Nodes level by level, each level from left to right.                                 */
+        focus_order,   /**< Node before its children, which are ordered by "focus" list (most recently focused
+                            first). Children missing from the list are visited last.                             */
+        leaf_windows   /**< Only containers of X11 windows, in pre-order.                                        */
+    };
+
+    /**
+     * \brief   Forward iterator over the nodes of the tree, which can be used with standard algorithms.<br>
+     *          Path from the root to the current node is kept in an explicit stack stored inside of the iterator,
+     *          so iteration doesn't recurse and it doesn't allocate any memory unless the tree is deeper than
+     *          "inline_depth" levels.<br>
+     *          Breadth-first order doesn't use a queue either: each level is found by depth-first walk limited to
+     *          that level, which costs a few more visits of upper nodes, since i3 trees are shallow.<br>
+     *          Tree must not be modified while it is being iterated.
+     */
+    class tree_iterator
+    {
+
+    public:
+
+        /// \cond DO_NOT_DOCUMENT
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = node;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const node*;
+        using reference = const node&;
+        /// \endcond
+
+        /**
+         * \brief   Number of levels of the tree which fit into the stack inside of the iterator.
+         */
+        static constexpr std::size_t inline_depth = 16;
+
+        /**
+         * \brief   Constructs iterator past the last node of any tree.
+         */
+        tree_iterator();
+
+        /**
+         * \brief                  Constructs iterator pointing to the first node of the tree in given order.
+         *
+         * \param [in] a_tree      Root node of the tree.
+         *
+         * \param [in] a_order     Order in which the nodes are visited.
+         *
+         * \throws std::bad_alloc  When bad allocation occurs while iterating the tree deeper than "inline_depth".
+         */
+        tree_iterator(const node& a_tree, tree_order a_order);
+
+        /// \cond DO_NOT_DOCUMENT
+        reference operator*() const                            { return *m_current;                        }
+        pointer operator->() const                             { return m_current;                         }
+        tree_iterator& operator++();
+        tree_iterator operator++(int);
+        bool operator==(const tree_iterator& a_iterator) const { return m_current == a_iterator.m_current; }
+        bool operator!=(const tree_iterator& a_iterator) const { return m_current != a_iterator.m_current; }
+        /// \endcond
+
+        /**
+         * \brief    Returns the depth of the current node.
+         *
+         * \return   0 for the root node, 1 for its children and so on.
+         */
+        std::size_t get_depth() const;
+
+    private:
+
+        /**
+         * \brief   Structure used to represent one node on the path from the root to the current node.
+         */
+        struct frame
+        {
+            const node* container;  /**< Node on the path.                            */
+            std::size_t next_child; /**< Position of the next child which is visited. */
+        };
+
+        /**
+         * \brief                  Pushes the node on top of the stack.
+         *
+         * \param [in] a_container Node to be pushed.
+         */
+        void push(const node* a_container);
+
+        /**
+         * \brief   Removes the node on top of the stack.
+         */
+        void pop();
+
+        /**
+         * \brief    Returns the node on top of the stack.
+         *
+         * \return   Frame of the node on top of the stack.
+         */
+        frame& top();
+
+        /**
+         * \brief    Returns the next child of the node on top of the stack, in the order of iteration.
+         *
+         * \return   Next child, or null if every child was already visited.
+         */
+        const node* next_child();
+
+        /**
+         * \brief   Moves to the next node in depth-first pre-order.
+         */
+        void next_pre_order();
+
+        /**
+         * \brief   Moves to the deepest first descendant of the node on top of the stack, which is the next node in
+         *          post-order.
+         */
+        void descend_post_order();
+
+        /**
+         * \brief   Moves to the next node in breadth-first order.
+         */
+        void next_breadth_first();
+
+        // NOTE: Frames beyond "inline_depth" are stored in vector, which stays empty for usual trees.
+        std::array<frame, inline_depth> m_frames; /**< Bottom of the stack.                                     */
+        std::vector<frame> m_deep_frames;         /**< Top of the stack, when it is deeper than "inline_depth".  */
+        std::size_t m_size;                       /**< Number of nodes on the stack.                             */
+        const node* m_current;                    /**< Current node, or null past the last node.                 */
+        const node* m_root;                       /**< Root node of the tree.                                    */
+        std::size_t m_level;                      /**< Depth of the current level, in breadth-first order.       */
+        bool m_has_deeper;                        /**< Whether the next level has any node, in breadth-first.    */
+        tree_order m_order;                       /**< Order in which the nodes are visited.                     */
+    };
+
+    /**
+     * \brief   Range of the nodes of the tree in given order, which can be used in range-based for loops.
+     */
+    class tree_range
+    {
+
+    public:
+
+        /**
+         * \brief                  Constructs range of the nodes of the tree.
+         *
+         * \param [in] a_tree      Root node of the tree, which has to outlive the range.
+         *
+         * \param [in] a_order     Order in which the nodes are visited.
+         */
+        tree_range(const node& a_tree, tree_order a_order);
+
+        /**
+         * \brief    Returns the iterator pointing to the first node.
+         *
+         * \return   Iterator pointing to the first node.
+         */
+        tree_iterator begin() const;
+
+        /**
+         * \brief    Returns the iterator past the last node.
+         *
+         * \return   Iterator past the last node.
+         */
+        tree_iterator end() const;
+
+    private:
+
+        const node* m_tree; /**< Root node of the tree.                */
+        tree_order m_order; /**< Order in which the nodes are visited. */
+    };
+
+    // NOTE: Shortcuts for the ranges of each order.
+    /// \cond DO_NOT_DOCUMENT
+    inline tree_range pre_order(const node& a_tree)     { return tree_range(a_tree, tree_order::pre_order);     }
+    inline tree_range post_order(const node& a_tree)    { return tree_range(a_tree, tree_order::post_order);    }
+    inline tree_range breadth_first(const node& a_tree) { return tree_range(a_tree, tree_order::breadth_first); }
+    inline tree_range focus_order(const node& a_tree)   { return tree_range(a_tree, tree_order::focus_order);   }
+    inline tree_range leaf_windows(const node& a_tree)  { return tree_range(a_tree, tree_order::leaf_windows);  }
+    /// \endcond
+
+} // i3_containers namespace
+
+#endif // I3_TREE_ITERATOR_HPP
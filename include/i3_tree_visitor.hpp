@@ -0,0 +1,94 @@
+/*
+    Copyright (C) 2019, Ivan Balević
+
+    This file is part of "i3-ipc++" library.
+
+    "i3-ipc++" is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    "i3-ipc++" is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with "i3-ipc++". If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+ * \file    i3_tree_visitor.hpp
+ *
+ * \brief   Defines "i3_tree_visitor" class used for walking through i3 nodes while they are being parsed.
+ */
+
+#ifndef I3_TREE_VISITOR_HPP
+#define I3_TREE_VISITOR_HPP
+
+// C++ headers.
+#include <variant>
+#include <string_view>
+
+// C headers.
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * \brief   Base class for user-defined walks through i3 nodes.<br>
+ *          Nodes are reported in the order in which they appear in i3's message, as they are being parsed.
+ *          No node is ever stored by the library, so only the depth of the tree affects memory usage.
+ */
+class i3_tree_visitor
+{
+
+public:
+
+    /**
+     * \brief   Type used to represent any scalar value from i3's message.<br>
+     *          Strings are valid only until the function which received them returns.
+     */
+    using value = std::variant<std::nullptr_t, bool, std::int64_t, std::uint64_t, double, std::string_view>;
+
+    /**
+     * \brief   Virtual destructor which enables destruction of derived classes through the base class.
+     */
+    virtual ~i3_tree_visitor() = default;
+
+    /**
+     * \brief               Called when the new node starts.
+     *
+     * \param [in] a_key    Name of the attribute which holds the node.<br>
+     *                      "nodes" or "floating_nodes" for child nodes, "container", "current" or "old" for nodes in
+     *                      event messages and empty for the root node of the tree.
+     *
+     * \return              False if walk should be stopped, true otherwise.
+     */
+    virtual bool enter_node(std::string_view a_key);
+
+    /**
+     * \brief               Called for every scalar attribute of the current node.<br>
+     *                      Attributes of event messages which are outside of any node are reported the same way.
+     *
+     * \param [in] a_object Name of the nested object which holds the attribute ("rect", "window_properties"...)
+     *                      or empty for attributes of the node itself.
+     *
+     * \param [in] a_key    Name of the attribute. Each element of array attributes ("marks", "focus"...) is reported
+     *                      separately with the name of the array.
+     *
+     * \param [in] a_value  Value of the attribute.
+     *
+     * \return              False if walk should be stopped, true otherwise.
+     */
+    virtual bool field(std::string_view a_object, std::string_view a_key, const value& a_value);
+
+    /**
+     * \brief    Called when the current node ends, after all of its child nodes.
+     *
+     * \return   False if walk should be stopped, true otherwise.
+     */
+    virtual bool leave_node();
+
+}; // class i3_tree_visitor
+
+#endif // I3_TREE_VISITOR_HPP
@@ -0,0 +1,160 @@
+/*
+    Copyright (C) 2019, Ivan Balević
+
+    This file is part of "i3-ipc++" library.
+
+    "i3-ipc++" is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    "i3-ipc++" is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with "i3-ipc++". If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+ * \file    i3_window_index.hpp
+ *
+ * \brief   Defines "i3_containers::window_index" class used for fuzzy search of windows by their title, class and
+ *          name.
+ */
+
+#ifndef I3_WINDOW_INDEX_HPP
+#define I3_WINDOW_INDEX_HPP
+
+// Library headers.
+#include "i3_containers.hpp"
+
+// C++ headers.
+#include <string>
+#include <vector>
+#include <string_view>
+#include <unordered_map>
+
+// C headers.
+#include <cstddef>
+#include <cstdint>
+
+namespace i3_containers
+{
+    /**
+     * \brief   Class used to find windows whose title, class or name is similar to the query.<br>
+     *          Every window is split into trigrams (three consecutive characters, case-insensitive) and each trigram
+     *          has the list of windows which contain it, so the search touches only the windows which share at least
+     *          one trigram with the query. Its cost depends on the total length of the lists of the query's trigrams
+     *          (the number of times those trigrams occur in indexed windows), which are merged by sorting, so the
+     *          queries made of rare trigrams are cheap, while the common ones still visit most of the windows.
+     */
+    // NOTE: Const member functions don't modify the index, so they can be called concurrently from several threads.
+    class window_index
+    {
+
+    public:
+
+        /**
+         * \brief   Structure used to represent one search result.
+         */
+        struct match
+        {
+            std::uint64_t id; /**< ID of the window's container.                                        */
+            float score;      /**< Similarity to the query, from 0 (no common trigram) to 1 (the same). */
+        };
+
+        /**
+         * \brief   Constructs empty index.
+         */
+        window_index();
+
+        /**
+         * \brief                    Constructs index of every window in given tree.
+         *
+         * \param [in] a_tree        Root node of the tree.
+         *
+         * \throws std::bad_alloc    When bad allocation occurs while indexing the tree.
+         */
+        explicit window_index(const node& a_tree);
+
+        /**
+         * \brief                    Adds the window to the index, or updates it if it is already indexed.
+         *
+         * \param [in] a_window      Container of the window. Containers without X11 window are ignored.
+         *
+         * \throws std::bad_alloc    When bad allocation occurs while indexing the window.
+         */
+        void insert(const node& a_window);
+
+        /**
+         * \brief                    Removes the window from the index.
+         *
+         * \param [in] a_id          ID of the window's container. Unknown IDs are ignored.
+         */
+        void erase(std::uint64_t a_id);
+
+        /**
+         * \brief                    Updates the index from window event.<br>
+         *                           Windows are added on "create", updated on "title" and removed on "close", while
+         *                           other changes don't affect the indexed text.
+         *
+         * \param [in] a_event       Window event.
+         *
+         * \throws std::bad_alloc    When bad allocation occurs while indexing the window.
+         */
+        void handle_event(const window_event& a_event);
+
+        /**
+         * \brief                    Finds the windows most similar to the query.<br>
+         *                           Queries shorter than a trigram are matched as substrings of the indexed text,
+         *                           which checks every window.
+         *
+         * \param [in] a_query       Text to search for.
+         *
+         * \param [in] a_limit       Maximum number of results.
+         *
+         * \return                   Matching windows, from the most to the least similar.
+         *
+         * \throws std::bad_alloc    When bad allocation occurs while scoring the windows.
+         */
+        std::vector<match> search(std::string_view a_query, std::size_t a_limit = 10) const;
+
+        /**
+         * \brief    Returns the number of indexed windows.
+         *
+         * \return   Number of indexed windows.
+         */
+        std::size_t size() const;
+
+    private:
+
+        /**
+         * \brief   Type used to store one trigram, packed into an integer.
+         */
+        using trigram = std::uint32_t;
+
+        /**
+         * \brief                  Splits the text into distinct trigrams.
+         *
+         * \param [in] a_text      Lowercase text.
+         *
+         * \return                 Sorted list of distinct trigrams in "a_text".
+         */
+        static std::vector<trigram> split(std::string_view a_text);
+
+        // NOTE: Windows are stored as structure of arrays, indexed by slot, so that the data of each candidate is
+        //       found without hashing. Slots of removed windows are reused.
+        std::vector<std::uint64_t> m_ids;                                   /**< Container ID in each slot.     */
+        std::vector<std::string> m_texts;                                   /**< Lowercase indexed text.        */
+        std::vector<std::vector<trigram>> m_trigrams;                       /**< Distinct trigrams of the text. */
+        std::vector<float> m_trigram_counts;                                /**< Number of distinct trigrams.   */
+        std::vector<std::uint32_t> m_free_slots;                            /**< Slots of removed windows.      */
+        std::unordered_map<std::uint64_t, std::uint32_t> m_slots;           /**< Slot of each container ID.     */
+        std::unordered_map<trigram, std::vector<std::uint32_t>> m_postings; /**< Slots containing each trigram. */
+    };
+
+} // i3_containers namespace
+
+#endif // I3_WINDOW_INDEX_HPP
@@ -0,0 +1,183 @@
+/*
+    Copyright (C) 2019, Ivan Balević
+
+    This file is part of "i3-ipc++" library.
+
+    "i3-ipc++" is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    "i3-ipc++" is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with "i3-ipc++". If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+ * \file    i3_workspace_state.hpp
+ *
+ * \brief   Defines "i3_containers::workspace_state" class which keeps workspaces and outputs up to date from events.
+ */
+
+#ifndef I3_WORKSPACE_STATE_HPP
+#define I3_WORKSPACE_STATE_HPP
+
+// Library headers.
+#include "i3_containers.hpp"
+
+// C++ headers.
+#include <string>
+#include <vector>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+// C headers.
+#include <cstdint>
+
+namespace i3_containers
+{
+    /**
+     * \brief   Class used to keep the state of workspaces and outputs, which is taken from one snapshot and then
+     *          updated from workspace events, so it doesn't have to be requested from i3 again.<br>
+     *          Workspaces are stored by ID, and focused workspace, visible workspace of each output and urgent
+     *          workspaces are tracked separately, so every query takes constant time.
+     */
+    class workspace_state
+    {
+
+    public:
+
+        /**
+         * \brief                    Constructs state from the snapshot.
+         *
+         * \param [in] a_workspaces  Workspaces, as returned by "i3_ipc::get_workspaces".
+         *
+         * \param [in] a_outputs     Outputs, as returned by "i3_ipc::get_outputs".
+         *
+         * \throws std::bad_alloc    When bad allocation occurs while storing the snapshot.
+         */
+        workspace_state(std::vector<workspace> a_workspaces, std::vector<output> a_outputs);
+
+        /**
+         * \brief                    Replaces the whole state with new snapshot.
+         *
+         * \param [in] a_workspaces  Workspaces, as returned by "i3_ipc::get_workspaces".
+         *
+         * \param [in] a_outputs     Outputs, as returned by "i3_ipc::get_outputs".
+         *
+         * \throws std::bad_alloc    When bad allocation occurs while storing the snapshot.
+         */
+        void reset(std::vector<workspace> a_workspaces, std::vector<output> a_outputs);
+
+        /**
+         * \brief                    Applies workspace event to the state.<br>
+         *                           "init", "empty", "focus", "rename", "move" and "urgent" are applied
+         *                           incrementally. Output of new or moved workspace is the output which contains
+         *                           its rectangle. Other changes ("reload", "restored") can't be applied.
+         *
+         * \param [in] a_event       Workspace event.
+         *
+         * \return                   True if the state is up to date, false if it has to be reset from new snapshot.
+         *
+         * \throws std::bad_alloc    When bad allocation occurs while adding new workspace.
+         */
+        bool handle_event(const workspace_event& a_event);
+
+        /**
+         * \brief                    Applies output event to the state.<br>
+         *                           Output event doesn't tell what was changed, so it can't be applied.
+         *
+         * \param [in] a_event       Output event.
+         *
+         * \return                   Always false, since the state has to be reset from new snapshot.
+         */
+        bool handle_event(const output_event& a_event);
+
+        /**
+         * \brief                  Returns the workspace with given ID.
+         *
+         * \param [in] a_id        ID of the workspace.
+         *
+         * \return                 Workspace with given ID, or null if there is no such workspace.
+         */
+        const workspace* get_workspace(std::uint64_t a_id) const;
+
+        /**
+         * \brief    Returns the focused workspace.
+         *
+         * \return   Focused workspace, or null if it is unknown.
+         */
+        const workspace* get_focused_workspace() const;
+
+        /**
+         * \brief                  Returns the workspace which is visible on given output.
+         *
+         * \param [in] a_output    Name of the output.
+         *
+         * \return                 Visible workspace, or null if the output is unknown or shows no known workspace.
+         */
+        const workspace* get_visible_workspace(std::string_view a_output) const;
+
+        /**
+         * \brief    Returns the urgent workspaces.
+         *
+         * \return   IDs of the urgent workspaces.
+         */
+        const std::unordered_set<std::uint64_t>& get_urgent_workspaces() const;
+
+        /**
+         * \brief    Returns every workspace.
+         *
+         * \return   Workspaces by their ID.
+         */
+        const std::unordered_map<std::uint64_t, workspace>& get_workspaces() const;
+
+        /**
+         * \brief    Returns every output.
+         *
+         * \return   Outputs by their name.
+         */
+        const std::unordered_map<std::string, output>& get_outputs() const;
+
+    private:
+
+        /**
+         * \brief                  Finds the output which contains given rectangle.
+         *
+         * \param [in] a_rect      Rectangle of the workspace.
+         *
+         * \return                 Name of the output, or std::nullopt if no active output contains the rectangle.
+         */
+        std::optional<std::string> find_output(const rectangle& a_rect) const;
+
+        /**
+         * \brief                  Makes the workspace visible on its output, hiding the workspace which was
+         *                         visible there before.
+         *
+         * \param [in] a_workspace Workspace which became visible.
+         */
+        void show(workspace& a_workspace);
+
+        /**
+         * \brief                  Stops tracking the workspace as visible on its output.
+         *
+         * \param [in] a_workspace Workspace which is no longer visible there.
+         */
+        void hide(workspace& a_workspace);
+
+        std::unordered_map<std::uint64_t, workspace> m_workspaces; /**< Workspaces by their ID.           */
+        std::unordered_map<std::string, output> m_outputs;         /**< Outputs by their name.            */
+        std::unordered_map<std::string, std::uint64_t> m_visible;  /**< Visible workspace of each output. */
+        std::unordered_set<std::uint64_t> m_urgent;                /**< IDs of the urgent workspaces.     */
+        std::optional<std::uint64_t> m_focused;                    /**< ID of the focused workspace.      */
+    };
+
+} // i3_containers namespace
+
+#endif // I3_WORKSPACE_STATE_HPP
@@ -0,0 +1,419 @@
+/*
+    Copyright (C) 2019, Ivan Balević
+
+    This file is part of "i3-ipc++" library.
+
+    "i3-ipc++" is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    "i3-ipc++" is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with "i3-ipc++". If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+ * \file    i3_compact_node.cpp
+ *
+ * \brief   Defines member functions of "i3_containers::compact_node" class.
+ */
+
+// Library headers.
+#include "i3_compact_node.hpp"
+#include "i3_containers.hpp"
+#include "i3_string_pool.hpp"
+
+// C++ headers.
+#include <memory>
+#include <string>
+#include <vector>
+#include <utility>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+
+// C headers.
+#include <cstdint>
+
+namespace
+{
+    /**
+     * \brief               Checks whether all coordinates of the rectangle are zero.
+     *
+     * \param [in] a_rect   Rectangle to be checked.
+     *
+     * \return              True if the rectangle is all zeros, false otherwise.
+     */
+    bool is_empty(const i3_containers::rectangle& a_rect)
+    {
+        return a_rect.x == 0 && a_rect.y == 0 && a_rect.width == 0 && a_rect.height == 0;
+    }
+} // Unnamed namespace.
+
+namespace i3_containers
+{
+    compact_node::compact_node()
+        : m_id(0), m_window(0), m_name(), m_focus(), m_nodes(), m_floating_nodes(), m_details(), m_rect(),
+          m_percent(0.0f), m_current_border_width(0), m_presence(0),
+          m_type(static_cast<std::uint8_t>(node_type::con)),
+          m_border(static_cast<std::uint8_t>(border_style::normal)),
+          m_is_urgent(false), m_is_focused(false),
+          m_layout(static_cast<std::uint8_t>(node_layout::splith)),
+          m_fullscreen_mode(static_cast<std::uint8_t>(fullscreen_mode_type::no_fullscreen))
+    {
+    }
+
+    compact_node::compact_node(const node& a_node, std::shared_ptr<string_pool> a_pool) : compact_node()
+    {
+        assign(a_node, a_pool ? a_pool : std::make_shared<string_pool>());
+    }
+
+    compact_node::compact_node(node&& a_node, std::shared_ptr<string_pool> a_pool) : compact_node()
+    {
+        assign(std::move(a_node), a_pool ? a_pool : std::make_shared<string_pool>());
+    }
+
+    compact_node::compact_node(const compact_node& a_node)
+        : m_id(a_node.m_id), m_window(a_node.m_window), m_name(a_node.m_name), m_focus(a_node.m_focus),
+          m_nodes(a_node.m_nodes), m_floating_nodes(a_node.m_floating_nodes),
+          m_details(a_node.m_details ? std::make_unique<details>(*a_node.m_details) : nullptr),
+          m_rect(a_node.m_rect), m_percent(a_node.m_percent), m_current_border_width(a_node.m_current_border_width),
+          m_presence(a_node.m_presence), m_type(a_node.m_type), m_border(a_node.m_border),
+          m_is_urgent(a_node.m_is_urgent), m_is_focused(a_node.m_is_focused), m_layout(a_node.m_layout),
+          m_fullscreen_mode(a_node.m_fullscreen_mode)
+    {
+    }
+
+    compact_node::compact_node(compact_node&& a_node) noexcept = default;
+
+    compact_node& compact_node::operator=(const compact_node& a_node)
+    {
+        // Copy-and-swap, so that the node stays unchanged if copying throws.
+        compact_node copy(a_node);
+        return *this = std::move(copy);
+    }
+
+    compact_node& compact_node::operator=(compact_node&& a_node) noexcept = default;
+
+    compact_node::~compact_node() = default;
+
+    node compact_node::to_node() const
+    {
+        node result{ };
+        result.id = m_id;
+        if (has(name_bit))
+        {
+            result.name = m_name;
+        }
+        result.type = get_type();
+        result.border = get_border();
+        result.current_border_width = get_current_border_width();
+        result.layout = get_layout();
+        result.percent = get_percent();
+        result.rect = m_rect;
+        result.window_rect = get_window_rect();
+        result.deco_rect = get_deco_rect();
+        result.geometry = get_geometry();
+        result.window = get_window();
+        result.window_properties = get_window_properties();
+        result.is_urgent = m_is_urgent;
+        result.is_focused = m_is_focused;
+        result.focus = m_focus;
+        result.fullscreen_mode = get_fullscreen_mode();
+        result.marks.assign(get_marks().begin(), get_marks().end());
+
+        result.nodes.reserve(m_nodes.size());
+        for (const auto& child_node : m_nodes)
+        {
+            result.nodes.push_back(child_node.to_node());
+        }
+
+        result.floating_nodes.reserve(m_floating_nodes.size());
+        for (const auto& floating_node : m_floating_nodes)
+        {
+            result.floating_nodes.push_back(floating_node.to_node());
+        }
+
+        return result;
+    }
+
+    std::optional<std::string_view> compact_node::get_name() const
+    {
+        return has(name_bit) ? std::optional<std::string_view>(m_name) : std::nullopt;
+    }
+
+    std::optional<std::uint8_t> compact_node::get_current_border_width() const
+    {
+        return has(current_border_width_bit) ? std::optional<std::uint8_t>(m_current_border_width) : std::nullopt;
+    }
+
+    std::optional<float> compact_node::get_percent() const
+    {
+        return has(percent_bit) ? std::optional<float>(m_percent) : std::nullopt;
+    }
+
+    rectangle compact_node::get_window_rect() const
+    {
+        return m_details ? m_details->window_rect : rectangle();
+    }
+
+    rectangle compact_node::get_deco_rect() const
+    {
+        return m_details ? m_details->deco_rect : rectangle();
+    }
+
+    rectangle compact_node::get_geometry() const
+    {
+        return m_details ? m_details->geometry : rectangle();
+    }
+
+    std::optional<std::uint64_t> compact_node::get_window() const
+    {
+        return has(window_bit) ? std::optional<std::uint64_t>(m_window) : std::nullopt;
+    }
+
+    std::optional<x11_window> compact_node::get_window_properties() const
+    {
+        if (!m_details || !m_details->has_window_properties)
+        {
+            return std::nullopt;
+        }
+
+        const auto to_string = [](const std::optional<std::string_view>& a_string) -> std::optional<std::string>
+        {
+            return a_string ? std::make_optional(std::string(*a_string)) : std::nullopt;
+        };
+
+        return x11_window{ to_string(m_details->window_class),
+                           to_string(m_details->window_instance),
+                           to_string(m_details->window_role),
+                           m_details->window_title,
+                           m_details->transient_for };
+    }
+
+    std::optional<std::string_view> compact_node::get_window_class() const
+    {
+        return m_details ? m_details->window_class : std::nullopt;
+    }
+
+    std::optional<std::string_view> compact_node::get_window_instance() const
+    {
+        return m_details ? m_details->window_instance : std::nullopt;
+    }
+
+    std::optional<std::string_view> compact_node::get_window_role() const
+    {
+        return m_details ? m_details->window_role : std::nullopt;
+    }
+
+    fullscreen_mode_type compact_node::get_fullscreen_mode() const
+    {
+        return static_cast<fullscreen_mode_type>(m_fullscreen_mode);
+    }
+
+    const std::vector<std::string_view>& compact_node::get_marks() const
+    {
+        static const std::vector<std::string_view> no_marks;
+        return m_details ? m_details->marks : no_marks;
+    }
+
+    void compact_node::set_name(std::optional<std::string_view> a_name)
+    {
+        if (a_name)
+        {
+            m_name.assign(a_name->data(), a_name->size());
+        }
+        else
+        {
+            m_name.clear();
+        }
+        set_presence(name_bit, a_name.has_value());
+    }
+
+    // NOTE: Values are masked to the width of their bitfields, so "-Wconversion" can prove that they fit.
+    void compact_node::set_type(node_type a_type)
+    {
+        m_type = static_cast<std::uint8_t>(a_type) & 0x7u;
+    }
+
+    void compact_node::set_border(border_style a_border)
+    {
+        m_border = static_cast<std::uint8_t>(a_border) & 0x3u;
+    }
+
+    void compact_node::set_current_border_width(std::optional<std::uint8_t> a_width)
+    {
+        m_current_border_width = a_width.value_or(0);
+        set_presence(current_border_width_bit, a_width.has_value());
+    }
+
+    void compact_node::set_layout(node_layout a_layout)
+    {
+        m_layout = static_cast<std::uint8_t>(a_layout) & 0x7u;
+    }
+
+    void compact_node::set_percent(std::optional<float> a_percent)
+    {
+        m_percent = a_percent.value_or(0.0f);
+        set_presence(percent_bit, a_percent.has_value());
+    }
+
+    // NOTE: Out-of-line storage is allocated only for non-zero rectangles, since most containers have zeros there.
+    void compact_node::set_window_rect(const rectangle& a_rect)
+    {
+        if (m_details || !is_empty(a_rect))
+        {
+            get_details().window_rect = a_rect;
+        }
+    }
+
+    void compact_node::set_deco_rect(const rectangle& a_rect)
+    {
+        if (m_details || !is_empty(a_rect))
+        {
+            get_details().deco_rect = a_rect;
+        }
+    }
+
+    void compact_node::set_geometry(const rectangle& a_rect)
+    {
+        if (m_details || !is_empty(a_rect))
+        {
+            get_details().geometry = a_rect;
+        }
+    }
+
+    void compact_node::set_window(std::optional<std::uint64_t> a_window)
+    {
+        m_window = a_window.value_or(0);
+        set_presence(window_bit, a_window.has_value());
+    }
+
+    void compact_node::set_window_properties(const std::optional<x11_window>& a_window_properties,
+                                             std::shared_ptr<string_pool> a_pool)
+    {
+        if (!m_details && !a_window_properties)
+        {
+            return;
+        }
+
+        const auto intern_string = [&](const std::optional<std::string>& a_string) -> std::optional<std::string_view>
+        {
+            return a_string ? std::make_optional(intern(*a_string, a_pool)) : std::nullopt;
+        };
+
+        details& node_details = get_details();
+        node_details.has_window_properties = a_window_properties.has_value();
+        if (a_window_properties)
+        {
+            node_details.window_class = intern_string(a_window_properties->window_class);
+            node_details.window_instance = intern_string(a_window_properties->window_instance);
+            node_details.window_role = intern_string(a_window_properties->window_role);
+            node_details.window_title = a_window_properties->window_title;
+            node_details.transient_for = a_window_properties->transient_for;
+        }
+        else
+        {
+            node_details.window_class.reset();
+            node_details.window_instance.reset();
+            node_details.window_role.reset();
+            node_details.window_title.reset();
+            node_details.transient_for.reset();
+        }
+    }
+
+    void compact_node::set_fullscreen_mode(fullscreen_mode_type a_mode)
+    {
+        m_fullscreen_mode = static_cast<std::uint8_t>(a_mode) & 0x3u;
+    }
+
+    void compact_node::set_marks(const std::vector<std::string>& a_marks, std::shared_ptr<string_pool> a_pool)
+    {
+        if (!m_details && a_marks.empty())
+        {
+            return;
+        }
+
+        std::vector<std::string_view>& marks = get_details().marks;
+        marks.clear();
+        marks.reserve(a_marks.size());
+        for (const auto& mark : a_marks)
+        {
+            marks.push_back(intern(mark, a_pool));
+        }
+    }
+
+    template<typename Node>
+    void compact_node::assign(Node&& a_node, const std::shared_ptr<string_pool>& a_pool)
+    {
+        // NOTE: Strings and vectors are stolen from "a_node" only if it is an rvalue.
+        using node_reference = std::conditional_t<std::is_const_v<std::remove_reference_t<Node>>, const node&, node&&>;
+
+        set_id(a_node.id);
+        if (a_node.name)
+        {
+            m_name = static_cast<node_reference>(a_node).name.value();
+            set_presence(name_bit, true);
+        }
+        set_type(a_node.type);
+        set_border(a_node.border);
+        set_current_border_width(a_node.current_border_width);
+        set_layout(a_node.layout);
+        set_percent(a_node.percent);
+        set_rect(a_node.rect);
+        set_window_rect(a_node.window_rect);
+        set_deco_rect(a_node.deco_rect);
+        set_geometry(a_node.geometry);
+        set_window(a_node.window);
+        set_window_properties(a_node.window_properties, a_pool);
+        set_urgent(a_node.is_urgent);
+        set_focused(a_node.is_focused);
+        m_focus = static_cast<node_reference>(a_node).focus;
+        set_fullscreen_mode(a_node.fullscreen_mode);
+        set_marks(a_node.marks, a_pool);
+
+        m_nodes.reserve(a_node.nodes.size());
+        for (auto& child_node : a_node.nodes)
+        {
+            m_nodes.emplace_back(static_cast<node_reference>(child_node), a_pool);
+        }
+
+        m_floating_nodes.reserve(a_node.floating_nodes.size());
+        for (auto& floating_node : a_node.floating_nodes)
+        {
+            m_floating_nodes.emplace_back(static_cast<node_reference>(floating_node), a_pool);
+        }
+    }
+
+    std::string_view compact_node::intern(std::string_view a_string, const std::shared_ptr<string_pool>& a_pool)
+    {
+        details& node_details = get_details();
+        if (!node_details.pool)
+        {
+            node_details.pool = a_pool ? a_pool : std::make_shared<string_pool>();
+        }
+
+        return node_details.pool->intern(a_string);
+    }
+
+    void compact_node::set_presence(presence_bit a_bit, bool a_has)
+    {
+        m_presence = a_has ? static_cast<std::uint8_t>(m_presence | a_bit)
+                           : static_cast<std::uint8_t>(m_presence & ~a_bit);
+    }
+
+    compact_node::details& compact_node::get_details()
+    {
+        if (!m_details)
+        {
+            m_details = std::make_unique<details>();
+        }
+
+        return *m_details;
+    }
+} // i3_containers namespace
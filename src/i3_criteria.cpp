@@ -0,0 +1,437 @@
+/*
+    Copyright (C) 2019, Ivan Balević
+
+    This file is part of "i3-ipc++" library.
+
+    "i3-ipc++" is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    "i3-ipc++" is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with "i3-ipc++". If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+ * \file    i3_criteria.cpp
+ *
+ * \brief   Defines member functions of "i3_containers::criteria" class.
+ */
+
+// Library headers.
+#include "i3_criteria.hpp"
+#include "i3_containers.hpp"
+#include "i3_ipc_invalid_argument.hpp"
+
+// C++ headers.
+#include <regex>
+#include <string>
+#include <vector>
+#include <optional>
+#include <algorithm>
+#include <string_view>
+
+// C headers.
+#include <cctype>
+#include <cstdint>
+
+namespace
+{
+    /**
+     * \brief   Value of "con_id" criterion which matches the focused container.
+     */
+    constexpr std::string_view focused_value = "__focused__";
+
+    /**
+     * \brief   Prefix of regular expression which makes it case-insensitive (PCRE syntax, used by i3).
+     */
+    constexpr std::string_view case_insensitive_prefix = "(?i)";
+
+    /**
+     * \brief                            Parses unsigned decimal number.
+     *
+     * \param [in] a_key                 Name of the criterion, used in error message.
+     *
+     * \param [in] a_value               Value of the criterion.
+     *
+     * \return                           Parsed number.
+     *
+     * \throws i3_ipc_invalid_argument   When value is not a number.
+     */
+    std::uint64_t parse_number(std::string_view a_key, std::string_view a_value)
+    {
+        const auto is_digit = [](char a_character) -> bool
+        {
+            return std::isdigit(static_cast<unsigned char>(a_character)) != 0;
+        };
+        if (a_value.empty() || a_value.size() > 19 || !std::all_of(a_value.begin(), a_value.end(), is_digit))
+        {
+            throw i3_ipc_invalid_argument("Value of criterion \"" + std::string(a_key) + "\" is not a number!");
+        }
+
+        return std::stoull(std::string(a_value));
+    }
+
+    /**
+     * \brief                            Compiles regular expression of the criterion.
+     *
+     * \param [in] a_key                 Name of the criterion, used in error message.
+     *
+     * \param [in] a_value               Regular expression, optionally prefixed by "(?i)".
+     *
+     * \return                           Compiled regular expression.
+     *
+     * \throws i3_ipc_invalid_argument   When regular expression is invalid or it is unsupported "__focused__".
+     */
+    std::regex parse_pattern(std::string_view a_key, std::string_view a_value)
+    {
+        // NOTE: i3 compares such values with the focused window, which is unknown outside of i3.
+        if (a_value == focused_value)
+        {
+            throw i3_ipc_invalid_argument("Value \"__focused__\" of criterion \"" + std::string(a_key)
+                                          + "\" is not supported!");
+        }
+
+        // NOTE: ECMAScript syntax is close enough to PCRE used by i3 for the usual criteria, but it has no inline
+        //       flags, so the case-insensitive prefix is translated into the flag.
+        std::regex::flag_type flags = std::regex::ECMAScript | std::regex::optimize;
+        if (a_value.substr(0, case_insensitive_prefix.size()) == case_insensitive_prefix)
+        {
+            a_value.remove_prefix(case_insensitive_prefix.size());
+            flags |= std::regex::icase;
+        }
+
+        try
+        {
+            return std::regex(a_value.begin(), a_value.end(), flags);
+        }
+        catch (const std::regex_error& error)
+        {
+            throw i3_ipc_invalid_argument("Invalid regular expression of criterion \"" + std::string(a_key) + "\": "
+                                          + error.what());
+        }
+    }
+
+    /**
+     * \brief                   Checks whether optional string matches regular expression.
+     *
+     * \param [in] a_string     String to be checked. Absent string never matches.
+     *
+     * \param [in] a_pattern    Compiled regular expression.
+     *
+     * \return                  True if any part of the string matches, false otherwise.
+     */
+    bool search(const std::optional<std::string>& a_string, const std::regex& a_pattern)
+    {
+        return a_string && std::regex_search(*a_string, a_pattern);
+    }
+} // Unnamed namespace.
+
+namespace i3_containers
+{
+    criteria::criteria(std::string_view a_criteria) : m_tests(), m_needs_window(false), m_needs_position(false)
+    {
+        const auto is_space = [](char a_character) -> bool
+        {
+            return std::isspace(static_cast<unsigned char>(a_character)) != 0;
+        };
+        const auto skip_spaces = [&a_criteria, &is_space]() -> void
+        {
+            while (!a_criteria.empty() && is_space(a_criteria.front()))
+            {
+                a_criteria.remove_prefix(1);
+            }
+        };
+
+        // Brackets are optional, but they have to be paired.
+        skip_spaces();
+        while (!a_criteria.empty() && is_space(a_criteria.back()))
+        {
+            a_criteria.remove_suffix(1);
+        }
+        if (!a_criteria.empty() && a_criteria.front() == '[')
+        {
+            if (a_criteria.back() != ']')
+            {
+                throw i3_ipc_invalid_argument("Criteria are missing closing bracket!");
+            }
+            a_criteria = a_criteria.substr(1, a_criteria.size() - 2);
+        }
+
+        skip_spaces();
+        while (!a_criteria.empty())
+        {
+            // Key is a word, optionally followed by "=" and a value, which is quoted if it contains spaces.
+            std::size_t length = 0;
+            while (length < a_criteria.size()
+                   && (std::isalpha(static_cast<unsigned char>(a_criteria[length])) != 0 || a_criteria[length] == '_'))
+            {
+                ++length;
+            }
+            const std::string_view key = a_criteria.substr(0, length);
+            if (key.empty())
+            {
+                throw i3_ipc_invalid_argument("Unexpected character in criteria: '" + std::string(1, a_criteria[0])
+                                              + "'!");
+            }
+            a_criteria.remove_prefix(length);
+
+            std::optional<std::string> value;
+            if (!a_criteria.empty() && a_criteria.front() == '=')
+            {
+                a_criteria.remove_prefix(1);
+                value.emplace();
+                if (!a_criteria.empty() && a_criteria.front() == '"')
+                {
+                    // NOTE: Only escaped quotes are unescaped, other backslashes belong to the regular expression.
+                    std::size_t position = 1;
+                    for (; position < a_criteria.size() && a_criteria[position] != '"'; ++position)
+                    {
+                        if (a_criteria[position] == '\\' && position + 1 < a_criteria.size()
+                            && a_criteria[position + 1] == '"')
+                        {
+                            ++position;
+                        }
+                        value->push_back(a_criteria[position]);
+                    }
+                    if (position == a_criteria.size())
+                    {
+                        throw i3_ipc_invalid_argument("Value of criterion \"" + std::string(key)
+                                                      + "\" is missing closing quote!");
+                    }
+                    a_criteria.remove_prefix(position + 1);
+                }
+                else
+                {
+                    const auto end = std::find_if(a_criteria.begin(), a_criteria.end(), is_space);
+                    value->assign(a_criteria.begin(), end);
+                    a_criteria.remove_prefix(static_cast<std::size_t>(end - a_criteria.begin()));
+                }
+            }
+
+            const bool needs_value = key != "all" && key != "floating" && key != "tiling";
+            if (needs_value != value.has_value())
+            {
+                throw i3_ipc_invalid_argument("Criterion \"" + std::string(key)
+                                              + (needs_value ? "\" requires a value!" : "\" doesn't take a value!"));
+            }
+
+            test criterion = { field::all, 0, std::nullopt };
+            if (key == "con_id")
+            {
+                if (*value == focused_value)
+                {
+                    criterion.kind = field::focused;
+                }
+                else
+                {
+                    criterion.kind = field::con_id;
+                    criterion.number = parse_number(key, *value);
+                }
+            }
+            else if (key == "id")
+            {
+                criterion.kind = field::id;
+                criterion.number = parse_number(key, *value);
+            }
+            else if (key == "urgent")
+            {
+                // NOTE: Only i3 knows the order in which windows became urgent, so both values match every urgent
+                //       window.
+                if (*value != "latest" && *value != "oldest")
+                {
+                    throw i3_ipc_invalid_argument("Value of criterion \"urgent\" must be \"latest\" or \"oldest\"!");
+                }
+                criterion.kind = field::urgent;
+            }
+            else if (key == "floating")
+            {
+                criterion.kind = field::floating;
+            }
+            else if (key == "tiling")
+            {
+                criterion.kind = field::tiling;
+            }
+            else if (key == "all")
+            {
+                criterion.kind = field::all;
+            }
+            else
+            {
+                if (key == "class")
+                {
+                    criterion.kind = field::window_class;
+                }
+                else if (key == "instance")
+                {
+                    criterion.kind = field::window_instance;
+                }
+                else if (key == "window_role")
+                {
+                    criterion.kind = field::window_role;
+                }
+                else if (key == "title")
+                {
+                    criterion.kind = field::window_title;
+                }
+                else if (key == "con_mark")
+                {
+                    criterion.kind = field::con_mark;
+                }
+                else if (key == "workspace")
+                {
+                    criterion.kind = field::workspace;
+                }
+                else
+                {
+                    throw i3_ipc_invalid_argument("Unknown or unsupported criterion \"" + std::string(key) + "\"!");
+                }
+                criterion.pattern = parse_pattern(key, *value);
+            }
+
+            m_needs_window = m_needs_window || (criterion.kind != field::con_id && criterion.kind != field::focused
+                                                && criterion.kind != field::con_mark);
+            m_needs_position = m_needs_position || criterion.kind == field::floating
+                               || criterion.kind == field::tiling || criterion.kind == field::workspace;
+            m_tests.push_back(std::move(criterion));
+            skip_spaces();
+        }
+
+        if (m_tests.empty())
+        {
+            throw i3_ipc_invalid_argument("Criteria are empty!");
+        }
+
+        std::stable_sort(m_tests.begin(), m_tests.end(), [](const test& a_first, const test& a_second) -> bool
+                                                         {
+                                                             return a_first.kind < a_second.kind;
+                                                         });
+    }
+
+    bool criteria::matches(const node& a_container) const
+    {
+        if (m_needs_position)
+        {
+            throw i3_ipc_invalid_argument("Criteria \"workspace\", \"floating\" and \"tiling\" can't be matched "
+                                          "against single container!");
+        }
+
+        return matches(a_container, nullptr, std::nullopt);
+    }
+
+    std::vector<std::uint64_t> criteria::find(const node& a_tree) const
+    {
+        std::vector<std::uint64_t> ids;
+        find(a_tree, nullptr, false, ids);
+
+        return ids;
+    }
+
+    bool criteria::matches(const node& a_container, const std::string* a_workspace,
+                           std::optional<bool> a_floating) const
+    {
+        if (m_needs_window && !a_container.window)
+        {
+            return false;
+        }
+
+        for (const test& criterion : m_tests)
+        {
+            const std::optional<x11_window>& window = a_container.window_properties;
+            bool is_match = false;
+            switch (criterion.kind)
+            {
+                case field::con_id:
+                    is_match = a_container.id == criterion.number;
+                    break;
+
+                case field::focused:
+                    is_match = a_container.is_focused;
+                    break;
+
+                case field::id:
+                    is_match = a_container.window == criterion.number;
+                    break;
+
+                case field::urgent:
+                    is_match = a_container.is_urgent;
+                    break;
+
+                case field::floating:
+                    is_match = a_floating.value_or(false);
+                    break;
+
+                case field::tiling:
+                    is_match = !a_floating.value_or(true);
+                    break;
+
+                case field::all:
+                    is_match = true;
+                    break;
+
+                case field::window_class:
+                    is_match = window && search(window->window_class, *criterion.pattern);
+                    break;
+
+                case field::window_instance:
+                    is_match = window && search(window->window_instance, *criterion.pattern);
+                    break;
+
+                case field::window_role:
+                    is_match = window && search(window->window_role, *criterion.pattern);
+                    break;
+
+                case field::window_title:
+                    is_match = window && search(window->window_title, *criterion.pattern);
+                    break;
+
+                case field::con_mark:
+                    is_match = std::any_of(a_container.marks.begin(), a_container.marks.end(),
+                                           [&criterion](const std::string& a_mark) -> bool
+                                           {
+                                               return std::regex_search(a_mark, *criterion.pattern);
+                                           });
+                    break;
+
+                case field::workspace:
+                    is_match = a_workspace && std::regex_search(*a_workspace, *criterion.pattern);
+                    break;
+            }
+
+            if (!is_match)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void criteria::find(const node& a_node, const std::string* a_workspace, bool a_floating,
+                        std::vector<std::uint64_t>& a_ids) const
+    {
+        if (a_node.type == node_type::workspace && a_node.name)
+        {
+            a_workspace = &*a_node.name;
+        }
+
+        if (matches(a_node, a_workspace, a_floating))
+        {
+            a_ids.push_back(a_node.id);
+        }
+
+        for (const auto& child_node : a_node.nodes)
+        {
+            find(child_node, a_workspace, a_floating, a_ids);
+        }
+        for (const auto& floating_node : a_node.floating_nodes)
+        {
+            find(floating_node, a_workspace, true, a_ids);
+        }
+    }
+} // i3_containers namespace
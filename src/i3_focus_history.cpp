@@ -0,0 +1,243 @@
+/*
+    Copyright (C) 2019, Ivan Balević
+
+    This file is part of "i3-ipc++" library.
+
+    "i3-ipc++" is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    "i3-ipc++" is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with "i3-ipc++". If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+ * \file    i3_focus_history.cpp
+ *
+ * \brief   Defines member functions of "i3_containers::focus_history" class.
+ */
+
+// Library headers.
+#include "i3_focus_history.hpp"
+#include "i3_containers.hpp"
+#include "i3_tree_iterator.hpp"
+
+// C++ headers.
+#include <list>
+#include <iterator>
+#include <optional>
+
+// C headers.
+#include <cstddef>
+#include <cstdint>
+
+namespace
+{
+    /**
+     * \brief   List returned for unknown workspaces.
+     */
+    const std::list<std::uint64_t> empty_order;
+} // Unnamed namespace.
+
+namespace i3_containers
+{
+    focus_history::focus_history() : m_order(), m_workspaces(), m_entries(), m_current_workspace()
+    {
+    }
+
+    focus_history::focus_history(const node& a_tree) : focus_history()
+    {
+        // NOTE: Workspace is forgotten once the walk leaves its subtree, so that dock windows get none.
+        std::optional<std::uint64_t> workspace;
+        std::size_t workspace_depth = 0;
+        const tree_range nodes = focus_order(a_tree);
+        for (auto container = nodes.begin(); container != nodes.end(); ++container)
+        {
+            if (workspace && container.get_depth() <= workspace_depth)
+            {
+                workspace.reset();
+            }
+            if (container->type == node_type::workspace)
+            {
+                workspace = container->id;
+                workspace_depth = container.get_depth();
+            }
+
+            if (container->is_focused)
+            {
+                m_current_workspace = workspace;
+            }
+            if (!container->window)
+            {
+                continue;
+            }
+
+            // Focus order visits the windows from the most to the least recently focused one.
+            if (workspace)
+            {
+                assign(container->id, *workspace);
+            }
+            else if (m_entries.count(container->id) == 0)
+            {
+                m_order.push_back(container->id);
+                m_entries.emplace(container->id, entry{ std::prev(m_order.end()), std::nullopt, { } });
+            }
+        }
+    }
+
+    void focus_history::handle_event(const window_event& a_event)
+    {
+        switch (a_event.change)
+        {
+            case window_change::focus:
+                touch(a_event.container.id, m_current_workspace);
+                break;
+
+            case window_change::close:
+                erase(a_event.container.id);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    void focus_history::handle_event(const workspace_event& a_event)
+    {
+        if (!a_event.current)
+        {
+            return;
+        }
+
+        const node& workspace = *a_event.current;
+        switch (a_event.change)
+        {
+            case workspace_change::focus:
+                m_current_workspace = workspace.id;
+                for (const node& window : leaf_windows(workspace))
+                {
+                    assign(window.id, workspace.id);
+                }
+                break;
+
+            case workspace_change::empty:
+            {
+                const auto windows = m_workspaces.find(workspace.id);
+                if (windows != m_workspaces.end() && windows->second.empty())
+                {
+                    m_workspaces.erase(windows);
+                }
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+
+    const std::list<std::uint64_t>& focus_history::get_order() const
+    {
+        return m_order;
+    }
+
+    const std::list<std::uint64_t>& focus_history::get_order(std::uint64_t a_workspace) const
+    {
+        const auto windows = m_workspaces.find(a_workspace);
+        return windows == m_workspaces.end() ? empty_order : windows->second;
+    }
+
+    std::optional<std::uint64_t> focus_history::get_current_workspace() const
+    {
+        return m_current_workspace;
+    }
+
+    std::size_t focus_history::size() const
+    {
+        return m_entries.size();
+    }
+
+    void focus_history::touch(std::uint64_t a_id, std::optional<std::uint64_t> a_workspace)
+    {
+        auto position = m_entries.find(a_id);
+        if (position == m_entries.end())
+        {
+            m_order.push_front(a_id);
+            position = m_entries.emplace(a_id, entry{ m_order.begin(), std::nullopt, { } }).first;
+        }
+        else
+        {
+            // NOTE: Splice only relinks the node, so iterators to it stay valid.
+            m_order.splice(m_order.begin(), m_order, position->second.global_position);
+        }
+
+        entry& window = position->second;
+        if (window.workspace == a_workspace)
+        {
+            if (a_workspace)
+            {
+                std::list<std::uint64_t>& windows = m_workspaces[*a_workspace];
+                windows.splice(windows.begin(), windows, window.workspace_position);
+            }
+            return;
+        }
+
+        leave_workspace(window);
+        if (a_workspace)
+        {
+            std::list<std::uint64_t>& windows = m_workspaces[*a_workspace];
+            windows.push_front(a_id);
+            window.workspace = a_workspace;
+            window.workspace_position = windows.begin();
+        }
+    }
+
+    void focus_history::assign(std::uint64_t a_id, std::uint64_t a_workspace)
+    {
+        auto position = m_entries.find(a_id);
+        if (position == m_entries.end())
+        {
+            m_order.push_back(a_id);
+            position = m_entries.emplace(a_id, entry{ std::prev(m_order.end()), std::nullopt, { } }).first;
+        }
+
+        entry& window = position->second;
+        if (window.workspace == a_workspace)
+        {
+            return;
+        }
+
+        leave_workspace(window);
+        std::list<std::uint64_t>& windows = m_workspaces[a_workspace];
+        windows.push_back(a_id);
+        window.workspace = a_workspace;
+        window.workspace_position = std::prev(windows.end());
+    }
+
+    void focus_history::leave_workspace(entry& a_entry)
+    {
+        if (a_entry.workspace)
+        {
+            m_workspaces[*a_entry.workspace].erase(a_entry.workspace_position);
+            a_entry.workspace.reset();
+        }
+    }
+
+    void focus_history::erase(std::uint64_t a_id)
+    {
+        const auto position = m_entries.find(a_id);
+        if (position == m_entries.end())
+        {
+            return;
+        }
+
+        leave_workspace(position->second);
+        m_order.erase(position->second.global_position);
+        m_entries.erase(position);
+    }
+} // i3_containers namespace
@@ -0,0 +1,251 @@
+/*
+    Copyright (C) 2019, Ivan Balević
+
+    This file is part of "i3-ipc++" library.
+
+    "i3-ipc++" is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    "i3-ipc++" is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with "i3-ipc++". If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+ * \file    i3_hashed_tree.cpp
+ *
+ * \brief   Defines member functions of "i3_containers::hashed_tree" class.
+ */
+
+// Library headers.
+#include "i3_hashed_tree.hpp"
+#include "i3_containers.hpp"
+
+// C++ headers.
+#include <memory>
+#include <string>
+#include <vector>
+#include <utility>
+#include <optional>
+#include <type_traits>
+
+// C headers.
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace
+{
+    /**
+     * \brief   Class used to compute 64-bit FNV-1a hash of the fields of one node.
+     */
+    class fnv1a_hasher
+    {
+
+    public:
+
+        /**
+         * \brief   Starts the hash with FNV offset basis.
+         */
+        fnv1a_hasher() : m_hash(14695981039346656037ull)
+        {
+        }
+
+        /**
+         * \brief               Adds the bytes of trivially copyable value to the hash.
+         *
+         * \tparam T            Type of the value.
+         *
+         * \param [in] a_value  Value to be hashed.
+         */
+        template<typename T>
+        void add(const T& a_value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be hashed bytewise.");
+
+            unsigned char bytes[sizeof(T)];
+            std::memcpy(bytes, &a_value, sizeof(T));
+            add_bytes(bytes, sizeof(T));
+        }
+
+        /**
+         * \brief                Adds the string to the hash, together with its length.
+         *
+         * \param [in] a_string  String to be hashed.
+         */
+        void add(const std::string& a_string)
+        {
+            add(a_string.size());
+            add_bytes(reinterpret_cast<const unsigned char*>(a_string.data()), a_string.size());
+        }
+
+        /**
+         * \brief                  Adds the optional value to the hash, so that absent value differs from any other.
+         *
+         * \tparam T               Type of the value.
+         *
+         * \param [in] a_optional  Optional value to be hashed.
+         */
+        template<typename T>
+        void add(const std::optional<T>& a_optional)
+        {
+            add(a_optional.has_value());
+            if (a_optional)
+            {
+                add(*a_optional);
+            }
+        }
+
+        /**
+         * \brief                Adds all elements of the vector to the hash, together with its size.
+         *
+         * \tparam T             Type of the elements.
+         *
+         * \param [in] a_vector  Vector to be hashed.
+         */
+        template<typename T>
+        void add(const std::vector<T>& a_vector)
+        {
+            add(a_vector.size());
+            for (const auto& element : a_vector)
+            {
+                add(element);
+            }
+        }
+
+        /**
+         * \brief    Returns the hash of all values added so far.
+         *
+         * \return   Hash of all added values.
+         */
+        std::uint64_t get() const
+        {
+            return m_hash;
+        }
+
+    private:
+
+        /**
+         * \brief               Adds raw bytes to the hash.
+         *
+         * \param [in] a_bytes  Bytes to be hashed.
+         *
+         * \param [in] a_size   Number of bytes.
+         */
+        void add_bytes(const unsigned char* a_bytes, std::size_t a_size)
+        {
+            for (std::size_t i = 0; i < a_size; ++i)
+            {
+                m_hash ^= a_bytes[i];
+                m_hash *= 1099511628211ull;
+            }
+        }
+
+        std::uint64_t m_hash; /**< Hash of all values added so far. */
+    };
+
+    /**
+     * \brief               Adds the rectangle to the hash, field by field so that padding is never hashed.
+     *
+     * \param [in] a_rect   Rectangle to be hashed.
+     *
+     * \param [in] a_hasher Hasher to which the rectangle is added.
+     */
+    void add_rectangle(const i3_containers::rectangle& a_rect, fnv1a_hasher& a_hasher)
+    {
+        a_hasher.add(a_rect.x);
+        a_hasher.add(a_rect.y);
+        a_hasher.add(a_rect.width);
+        a_hasher.add(a_rect.height);
+    }
+} // Unnamed namespace.
+
+namespace i3_containers
+{
+    hashed_tree::hashed_tree(node a_root)
+        : m_root(std::make_unique<node>(std::move(a_root))), m_entries(), m_index()
+    {
+        index_subtree(*m_root, 0);
+    }
+
+    const node& hashed_tree::get_root() const
+    {
+        return *m_root;
+    }
+
+    std::uint64_t hashed_tree::get_hash() const
+    {
+        return m_entries.front().hash;
+    }
+
+    const std::vector<hashed_tree::entry>& hashed_tree::get_entries() const
+    {
+        return m_entries;
+    }
+
+    std::optional<std::size_t> hashed_tree::find(std::uint64_t a_id) const
+    {
+        const auto position = m_index.find(a_id);
+        return position != m_index.end() ? std::make_optional(position->second) : std::nullopt;
+    }
+
+    std::uint64_t hashed_tree::index_subtree(const node& a_node, std::uint64_t a_parent_id)
+    {
+        // NOTE: Only the first of nodes with duplicate IDs is in the index.
+        const std::size_t position = m_entries.size();
+        m_entries.push_back(entry{ &a_node, a_parent_id, 0, 0 });
+        m_index.emplace(a_node.id, position);
+
+        fnv1a_hasher hasher;
+        hasher.add(a_node.id);
+        hasher.add(a_node.name);
+        hasher.add(a_node.type);
+        hasher.add(a_node.border);
+        hasher.add(a_node.current_border_width);
+        hasher.add(a_node.layout);
+        hasher.add(a_node.percent);
+        add_rectangle(a_node.rect, hasher);
+        add_rectangle(a_node.window_rect, hasher);
+        add_rectangle(a_node.deco_rect, hasher);
+        add_rectangle(a_node.geometry, hasher);
+        hasher.add(a_node.window);
+        hasher.add(a_node.window_properties.has_value());
+        if (a_node.window_properties)
+        {
+            hasher.add(a_node.window_properties->window_class);
+            hasher.add(a_node.window_properties->window_instance);
+            hasher.add(a_node.window_properties->window_role);
+            hasher.add(a_node.window_properties->window_title);
+            hasher.add(a_node.window_properties->transient_for);
+        }
+        hasher.add(a_node.is_urgent);
+        hasher.add(a_node.is_focused);
+        hasher.add(a_node.focus);
+        hasher.add(a_node.fullscreen_mode);
+        hasher.add(a_node.marks);
+
+        // Child hashes are added in order, with the number of tiling nodes, so that moving a node between the
+        // lists or within a list changes the hash as well.
+        hasher.add(a_node.nodes.size());
+        for (const auto& child_node : a_node.nodes)
+        {
+            hasher.add(index_subtree(child_node, a_node.id));
+        }
+        hasher.add(a_node.floating_nodes.size());
+        for (const auto& floating_node : a_node.floating_nodes)
+        {
+            hasher.add(index_subtree(floating_node, a_node.id));
+        }
+
+        // NOTE: Entry is accessed by position, since the vector could have been reallocated in the meantime.
+        m_entries[position].hash = hasher.get();
+        m_entries[position].subtree_end = m_entries.size();
+        return m_entries[position].hash;
+    }
+} // i3_containers namespace
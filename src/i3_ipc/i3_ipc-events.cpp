@@ -27,102 +27,314 @@
 #include "i3_ipc.hpp"
 #include "i3_message.hpp"
 #include "i3_containers.hpp"
+#include "i3_function_ref.hpp"
 #include "i3_json_parser.hpp"
+#include "i3_ipc_bad_message.hpp"
+#include "i3_ipc_queue_overflow.hpp"
 
 // C++ headers.
+#include <deque>
+#include <chrono>
+#include <memory>
 #include <string>
+#include <vector>
+#include <utility>
 #include <variant>
 #include <optional>
 #include <exception>
+#include <limits>
+#include <algorithm>
 #include <functional>
 #include <type_traits>
+#include <unordered_set>
+#include <initializer_list>
 
 // C headers.
+#include <cstddef>
 #include <cstdint>
 #include <cassert>
 
 namespace
 {
     /**
-     * \brief                     Creates string in JSON format for given event type.
+     * \brief   Maximum number of events read in one burst for coalescing, even if event queue is unbounded.
+     */
+    constexpr std::size_t max_burst_events = 1024;
+
+    /**
+     * \brief                     Returns the name of given event type used in i3's subscription requests.
      *
      * \param [in] a_event_type   Event type for subscription.
      *
-     * \return                    String in JSON format representing the subscription request for i3.
+     * \return                    Name of the event type in i3's IPC protocol.
      */
-    const char* create_json_subscription_request(i3_ipc::event_type a_event_type)
+    const char* get_event_name(i3_ipc::event_type a_event_type)
     {
         switch (a_event_type)
         {
-            case i3_ipc::event_type::workspace:         return "[\"workspace\"]";
-            case i3_ipc::event_type::output:            return "[\"output\"]";
-            case i3_ipc::event_type::mode:              return "[\"mode\"]";
-            case i3_ipc::event_type::window:            return "[\"window\"]";
-            case i3_ipc::event_type::bar_config_update: return "[\"barconfig_update\"]";
-            case i3_ipc::event_type::binding:           return "[\"binding\"]";
-            case i3_ipc::event_type::shutdown:          return "[\"shutdown\"]";
-            case i3_ipc::event_type::tick:              return "[\"tick\"]";
+            case i3_ipc::event_type::workspace:         return "workspace";
+            case i3_ipc::event_type::output:            return "output";
+            case i3_ipc::event_type::mode:              return "mode";
+            case i3_ipc::event_type::window:            return "window";
+            case i3_ipc::event_type::bar_config_update: return "barconfig_update";
+            case i3_ipc::event_type::binding:           return "binding";
+            case i3_ipc::event_type::shutdown:          return "shutdown";
+            case i3_ipc::event_type::tick:              return "tick";
 
             default:
                 assert("Unhandled type of i3_event!" && 0);
                 return nullptr;
         }
     }
+
+    /**
+     * \brief                      Creates string in JSON format for given event types.
+     *
+     * \param [in] a_event_types   Event types for subscription.
+     *
+     * \return                     String in JSON format representing the subscription request for i3.
+     */
+    std::string create_json_subscription_request(std::initializer_list<i3_ipc::event_type> a_event_types)
+    {
+        std::string subscription_request = "[";
+        for (const i3_ipc::event_type event_type : a_event_types)
+        {
+            if (subscription_request.size() > 1)
+            {
+                subscription_request += ',';
+            }
+            subscription_request += '"';
+            subscription_request += get_event_name(event_type);
+            subscription_request += '"';
+        }
+        subscription_request += ']';
+
+        return subscription_request;
+    }
+
+    /**
+     * \brief                       Converts type of i3's message into type of i3 event.
+     *
+     * \param [in] a_message_type   Type of received message.
+     *
+     * \return                      Type of the event carried by the message.
+     *
+     * \throws i3_ipc_bad_message   When message is not an event.
+     */
+    i3_ipc::event_type get_event_type(i3_message::type a_message_type)
+    {
+        switch (a_message_type)
+        {
+            case i3_message::type::workspace_event:  return i3_ipc::event_type::workspace;
+            case i3_message::type::output_event:     return i3_ipc::event_type::output;
+            case i3_message::type::mode_event:       return i3_ipc::event_type::mode;
+            case i3_message::type::window_event:     return i3_ipc::event_type::window;
+            case i3_message::type::bar_config_event: return i3_ipc::event_type::bar_config_update;
+            case i3_message::type::binding_event:    return i3_ipc::event_type::binding;
+            case i3_message::type::shutdown_event:   return i3_ipc::event_type::shutdown;
+            case i3_message::type::tick_event:       return i3_ipc::event_type::tick;
+
+            default:
+                using enum_underlying_type = std::underlying_type_t<decltype(a_message_type)>;
+                const std::string message_type = std::to_string(static_cast<enum_underlying_type>(a_message_type));
+                throw i3_ipc_bad_message("Received unexpected message of type: " + message_type);
+        }
+    }
+
+    /**
+     * \brief   Type used to identify coalescable window event, by its change and the ID of its container.
+     */
+    using window_event_key = std::pair<i3_containers::window_change, std::uint64_t>;
+
+    /**
+     * \brief   Hash function of "window_event_key".
+     */
+    struct window_event_key_hash
+    {
+        /**
+         * \brief              Calculates the hash of given key.
+         *
+         * \param [in] a_key   Key of window event.
+         *
+         * \return             Hash of "a_key".
+         */
+        std::size_t operator()(const window_event_key& a_key) const
+        {
+            // NOTE: Only "title" and "move" events are coalesced, so the change fits into the lowest bit.
+            const bool is_move = a_key.first == i3_containers::window_change::move;
+            return std::hash<std::uint64_t>()(a_key.second << 1 | static_cast<std::uint64_t>(is_move));
+        }
+    };
+
+    /// \cond DO_NOT_DOCUMENT
+    // NOTE: Each overload appends the event to the member of the batch which holds events of its type.
+    void add_to_batch(i3_containers::event_batch& a_batch, i3_containers::workspace_event&& a_event)
+    {
+        a_batch.workspace_events.push_back(std::move(a_event));
+    }
+
+    void add_to_batch(i3_containers::event_batch& a_batch, i3_containers::output_event&& a_event)
+    {
+        a_batch.output_events.push_back(std::move(a_event));
+    }
+
+    void add_to_batch(i3_containers::event_batch& a_batch, i3_containers::mode_event&& a_event)
+    {
+        a_batch.mode_events.push_back(std::move(a_event));
+    }
+
+    void add_to_batch(i3_containers::event_batch& a_batch, i3_containers::window_event&& a_event)
+    {
+        a_batch.window_events.push_back(std::move(a_event));
+    }
+
+    void add_to_batch(i3_containers::event_batch& a_batch, i3_containers::bar_config_event&& a_event)
+    {
+        a_batch.bar_config_events.push_back(std::move(a_event));
+    }
+
+    void add_to_batch(i3_containers::event_batch& a_batch, i3_containers::binding_event&& a_event)
+    {
+        a_batch.binding_events.push_back(std::move(a_event));
+    }
+
+    void add_to_batch(i3_containers::event_batch& a_batch, i3_containers::shutdown_event&& a_event)
+    {
+        a_batch.shutdown_events.push_back(std::move(a_event));
+    }
+
+    void add_to_batch(i3_containers::event_batch& a_batch, i3_containers::tick_event&& a_event)
+    {
+        a_batch.tick_events.push_back(std::move(a_event));
+    }
+    /// \endcond
 } // Unnamed namespace.
 
-void i3_ipc::subscribe(event_type a_event_type, const i3_callback& a_callback) const
+template<typename Event>
+i3_ipc::i3_subscription i3_ipc::make_subscription(const std::function<void(const Event&)>& a_callback)
+{
+    // NOTE: Copy is kept on heap, so that the reference to it stays valid when subscription is moved.
+    auto owner = std::make_shared<std::function<void(const Event&)>>(a_callback);
+    const i3_function_ref<void(const Event&)> callback(*owner);
+
+    return i3_subscription{ callback, std::move(owner) };
+}
+
+void i3_ipc::subscribe(event_type a_event_type, i3_subscription a_subscription) const
 {
     // Subscription request should be sent to i3 even when we are already subscribed!
     // This is done to ensure that ONLY the events that happend before subscription
     // will end up in event queue before the new callback function is set.
-    const char* subscription_request = create_json_subscription_request(a_event_type);
+    subscribe({ a_event_type });
+
+    // Once the subscription is successful, push the callback to event queue to be used at appropriate time.
+    push_queued_event(queued_event{ std::move(a_subscription), std::nullopt, 0 });
+}
+
+void i3_ipc::subscribe(std::initializer_list<event_type> a_event_types) const
+{
+    const std::string subscription_request = create_json_subscription_request(a_event_types);
     const std::string subscription_response = send_request(i3_message::type::subscribe, subscription_request);
 
     // Throw i3_ipc_invalid_argument if i3 declined subscription.
     i3_json_parser::parse_subscribe_response(subscription_response.c_str());
+}
 
-    // Once the subscription is successful, push the callback to event queue to be used at appropriate time.
-    m_event_queue.push(a_callback);
+i3_ipc::raw_event i3_ipc::receive_raw_event() const
+{
+    // NOTE: Raw events are received only on connections without callbacks, whose event queue is always empty.
+    assert(m_event_queue.empty());
+
+    i3_message::response response = i3_message::receive(m_socket);
+    return raw_event{ get_event_type(response.message_type), std::move(response.payload) };
+}
+
+i3_containers::workspace_event i3_ipc::parse_event(const char* a_json_string,
+                                                   std::in_place_type_t<i3_containers::workspace_event>)
+{
+    return i3_json_parser::parse_workspace_event(a_json_string);
+}
+
+i3_containers::output_event i3_ipc::parse_event(const char* a_json_string,
+                                                std::in_place_type_t<i3_containers::output_event>)
+{
+    return i3_json_parser::parse_output_event(a_json_string);
+}
+
+i3_containers::mode_event i3_ipc::parse_event(const char* a_json_string,
+                                              std::in_place_type_t<i3_containers::mode_event>)
+{
+    return i3_json_parser::parse_mode_event(a_json_string);
+}
+
+i3_containers::window_event i3_ipc::parse_event(const char* a_json_string,
+                                                std::in_place_type_t<i3_containers::window_event>)
+{
+    return i3_json_parser::parse_window_event(a_json_string);
+}
+
+i3_containers::bar_config_event i3_ipc::parse_event(const char* a_json_string,
+                                                    std::in_place_type_t<i3_containers::bar_config_event>)
+{
+    return i3_json_parser::parse_bar_config(a_json_string);
+}
+
+i3_containers::binding_event i3_ipc::parse_event(const char* a_json_string,
+                                                 std::in_place_type_t<i3_containers::binding_event>)
+{
+    return i3_json_parser::parse_binding_event(a_json_string);
+}
+
+i3_containers::shutdown_event i3_ipc::parse_event(const char* a_json_string,
+                                                  std::in_place_type_t<i3_containers::shutdown_event>)
+{
+    return i3_json_parser::parse_shutdown_event(a_json_string);
+}
+
+i3_containers::tick_event i3_ipc::parse_event(const char* a_json_string,
+                                              std::in_place_type_t<i3_containers::tick_event>)
+{
+    return i3_json_parser::parse_tick_event(a_json_string);
 }
 
 void i3_ipc::on_workspace_event(const std::function<void(const i3_containers::workspace_event&)>& a_callback) const
 {
-    subscribe(event_type::workspace, a_callback);
+    subscribe(event_type::workspace, make_subscription(a_callback));
 }
 
 void i3_ipc::on_output_event(const std::function<void(const i3_containers::output_event&)>& a_callback) const
 {
-    subscribe(event_type::output, a_callback);
+    subscribe(event_type::output, make_subscription(a_callback));
 }
 
 void i3_ipc::on_mode_event(const std::function<void(const i3_containers::mode_event&)>& a_callback) const
 {
-    subscribe(event_type::mode, a_callback);
+    subscribe(event_type::mode, make_subscription(a_callback));
 }
 
 void i3_ipc::on_window_event(const std::function<void(const i3_containers::window_event&)>& a_callback) const
 {
-    subscribe(event_type::window, a_callback);
+    subscribe(event_type::window, make_subscription(a_callback));
 }
 
 void i3_ipc::on_bar_config_event(const std::function<void(const i3_containers::bar_config&)>& a_callback) const
 {
-    subscribe(event_type::bar_config_update, a_callback);
+    subscribe(event_type::bar_config_update, make_subscription(a_callback));
 }
 
 void i3_ipc::on_binding_event(const std::function<void(const i3_containers::binding_event&)>& a_callback) const
 {
-    subscribe(event_type::binding, a_callback);
+    subscribe(event_type::binding, make_subscription(a_callback));
 }
 
 void i3_ipc::on_shutdown_event(const std::function<void(const i3_containers::shutdown_event&)>& a_callback) const
 {
-    subscribe(event_type::shutdown, a_callback);
+    subscribe(event_type::shutdown, make_subscription(a_callback));
 }
 
 void i3_ipc::on_tick_event(const std::function<void(const i3_containers::tick_event&)>& a_callback) const
 {
-    subscribe(event_type::tick, a_callback);
+    subscribe(event_type::tick, make_subscription(a_callback));
 }
 
 /// \cond DO_NOT_DOCUMENT
@@ -176,15 +388,10 @@ template<typename T, typename V> constexpr std::uint8_t get_index_v = get_index<
 
 /// \endcond
 
-void i3_ipc::handle_subscription_event(const i3_callback& a_callback)
+void i3_ipc::handle_subscription_event(i3_subscription&& a_subscription)
 {
-    std::visit([&](const auto& callback) -> void
-               {
-                   using callback_type = std::decay_t<decltype(callback)>;
-                   constexpr std::uint8_t index = get_index_v<callback_type, i3_callback>;
-                   m_callbacks[index] = callback;
-               },
-               a_callback);
+    const std::size_t index = a_subscription.callback.index();
+    m_callbacks[index] = std::move(a_subscription);
 }
 
 i3_ipc::event_type i3_ipc::handle_i3_event(const i3_event& a_i3_event) const
@@ -199,7 +406,13 @@ i3_ipc::event_type i3_ipc::handle_i3_event(const i3_event& a_i3_event) const
                                                     using i3_event_type = std::decay_t<decltype(i3_event_info)>;
                                                     constexpr std::uint8_t index = get_index_v<i3_event_type,
                                                                                                i3_containers::event>;
-                                                    std::get<index>(m_callbacks[index])(i3_event_info);
+                                                    // NOTE: Missing callback is reported in the same way as the
+                                                    //       call of empty "std::function".
+                                                    if (!m_callbacks[index])
+                                                    {
+                                                        throw std::bad_function_call();
+                                                    }
+                                                    std::get<index>(m_callbacks[index]->callback)(i3_event_info);
                                                     return static_cast<event_type>(index);
                                                 },
                                                 event);
@@ -216,14 +429,14 @@ i3_ipc::event_type i3_ipc::handle_i3_event(const i3_event& a_i3_event) const
                       a_i3_event);
 }
 
-std::optional<i3_ipc::event_type> i3_ipc::handle_i3_ipc_event(const i3_ipc_event& a_i3_ipc_event)
+std::optional<i3_ipc::event_type> i3_ipc::handle_i3_ipc_event(i3_ipc_event&& a_i3_ipc_event)
 {
-    return std::visit([&](const auto& event) -> std::optional<event_type>
+    return std::visit([&](auto& event) -> std::optional<event_type>
                       {
                           using i3_ipc_event_type = std::decay_t<decltype(event)>;
-                          if constexpr (std::is_same_v<i3_ipc_event_type, i3_callback>)
+                          if constexpr (std::is_same_v<i3_ipc_event_type, i3_subscription>)
                           {
-                               handle_subscription_event(event);
+                               handle_subscription_event(std::move(event));
                                return std::nullopt;
                           }
                           else if constexpr (std::is_same_v<i3_ipc_event_type, i3_event>)
@@ -238,8 +451,211 @@ std::optional<i3_ipc::event_type> i3_ipc::handle_i3_ipc_event(const i3_ipc_event
                       a_i3_ipc_event);
 }
 
+std::size_t i3_ipc::receive_coalesced_events() const
+{
+    assert(m_event_coalescing);
+    const std::chrono::milliseconds window = *m_event_coalescing;
+    const auto deadline = std::chrono::steady_clock::now() + window;
+
+    // Wait for the first event as usual, then read every event that arrives within the window.
+    // With zero window, only the events which are already in the socket are read.
+    // NOTE: Burst is bounded by "max_burst_events", so that steady stream of events can't extend it forever, and
+    //       also by the limits of event queue, since all of its events could end up queued.
+    const std::size_t max_events = m_event_queue_limits ? std::min(m_event_queue_limits->max_events, max_burst_events)
+                                                        : max_burst_events;
+    const std::size_t max_bytes = m_event_queue_limits ? m_event_queue_limits->max_bytes
+                                                       : std::numeric_limits<std::size_t>::max();
+    std::vector<i3_message::response> burst;
+    burst.push_back(i3_message::receive(m_socket));
+    std::size_t burst_bytes = burst.back().payload.size();
+    std::size_t received_bytes = sizeof(i3_ipc_header_t) + burst.back().payload.size();
+    while (burst.size() < max_events && burst_bytes < max_bytes)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(std::max(deadline, now) - now);
+        if ((window.count() != 0 && remaining.count() == 0) || !i3_message::wait_readable(m_socket, remaining))
+        {
+            break;
+        }
+
+        burst.push_back(i3_message::receive(m_socket));
+        burst_bytes += burst.back().payload.size();
+        received_bytes += sizeof(i3_ipc_header_t) + burst.back().payload.size();
+    }
+
+    // Walk the burst backwards, so that the latest event of each container is kept and the earlier ones are dropped.
+    std::vector<bool> is_superseded(burst.size(), false);
+    std::unordered_set<window_event_key, window_event_key_hash> seen_keys;
+    for (std::size_t i = burst.size(); i-- > 0;)
+    {
+        if (burst[i].message_type != i3_message::type::window_event)
+        {
+            continue;
+        }
+
+        const std::optional<window_event_key> key = i3_json_parser::parse_window_event_key(burst[i].payload);
+        is_superseded[i] = key && !seen_keys.insert(*key).second;
+    }
+
+    // Only the events which were kept are parsed.
+    for (std::size_t i = 0; i < burst.size(); ++i)
+    {
+        if (is_superseded[i])
+        {
+            continue;
+        }
+
+        push_event(burst[i]);
+    }
+
+    return received_bytes;
+}
+
+std::size_t i3_ipc::receive_events() const
+{
+    if (m_event_coalescing)
+    {
+        return receive_coalesced_events();
+    }
+
+    const i3_message::response message = i3_message::receive(m_socket);
+    push_event(message);
+
+    return sizeof(i3_ipc_header_t) + message.payload.size();
+}
+
+void i3_ipc::push_event(const i3_message::response& a_message) const
+{
+    const event_type type = get_event_type(a_message.message_type);
+
+    i3_event event;
+    try
+    {
+        event = i3_json_parser::parse_event(a_message.message_type, a_message.payload.c_str());
+    }
+    catch(const i3_ipc_bad_message&)
+    {
+        throw;
+    }
+    catch(...)
+    {
+        event = std::current_exception();
+    }
+    push_queued_event(queued_event{ std::move(event), type, a_message.payload.size() });
+}
+
+void i3_ipc::push_queued_event(queued_event&& a_queued_event) const
+{
+    // Subscriptions are needed for handling every event after them, so they are never limited.
+    if (!a_queued_event.type || !m_event_queue_limits)
+    {
+        m_event_queue.push_back(std::move(a_queued_event));
+        return;
+    }
+
+    // Once resync is needed, no event is useful until it is handled.
+    if (m_is_resync_queued)
+    {
+        return;
+    }
+
+    const event_queue_limits& limits = *m_event_queue_limits;
+    const auto is_droppable = [&](const std::optional<event_type>& a_type) -> bool
+                              {
+                                  return a_type && std::find(limits.droppable_event_types.begin(),
+                                                             limits.droppable_event_types.end(),
+                                                             *a_type) != limits.droppable_event_types.end();
+                              };
+    const auto is_event = [](const queued_event& a_event) -> bool { return a_event.type.has_value(); };
+    const auto is_droppable_event = [&](const queued_event& a_event) -> bool { return is_droppable(a_event.type); };
+
+    while (m_queued_events + 1 > limits.max_events || m_queued_bytes + a_queued_event.size > limits.max_bytes)
+    {
+        auto dropped_event = m_event_queue.end();
+        switch (limits.policy)
+        {
+            case overflow_policy::block:
+                // NOTE: Event was already read from the socket (it came before some response), so it must be kept.
+                break;
+
+            case overflow_policy::drop_oldest:
+                dropped_event = std::find_if(m_event_queue.begin(), m_event_queue.end(), is_event);
+                break;
+
+            case overflow_policy::drop_by_type:
+                if (is_droppable(a_queued_event.type))
+                {
+                    return;
+                }
+                dropped_event = std::find_if(m_event_queue.begin(), m_event_queue.end(), is_droppable_event);
+                break;
+
+            case overflow_policy::resync:
+            {
+                // Keep only subscriptions and replace all events with single marker.
+                const i3_ipc_queue_overflow resync_exception("Event queue overflowed and events were dropped, "
+                                                             "state should be fetched from i3 again!");
+                m_event_queue.erase(std::remove_if(m_event_queue.begin(), m_event_queue.end(), is_event),
+                                    m_event_queue.end());
+                m_queued_events = 0;
+                m_queued_bytes = 0;
+
+                m_event_queue.push_back(queued_event{ i3_event(std::make_exception_ptr(resync_exception)),
+                                                      std::nullopt,
+                                                      0 });
+                m_is_resync_queued = true;
+                return;
+            }
+        }
+
+        if (dropped_event == m_event_queue.end())
+        {
+            break;
+        }
+
+        --m_queued_events;
+        m_queued_bytes -= dropped_event->size;
+        m_event_queue.erase(dropped_event);
+    }
+
+    ++m_queued_events;
+    m_queued_bytes += a_queued_event.size;
+    m_event_queue.push_back(std::move(a_queued_event));
+}
+
+i3_ipc::i3_ipc_event i3_ipc::pop_queued_event() const
+{
+    // NOTE: Queued event is moved out, since its copy would copy the whole event info (or the owner of callback).
+    queued_event front_event = std::move(m_event_queue.front());
+    m_event_queue.pop_front();
+
+    if (front_event.type)
+    {
+        --m_queued_events;
+        m_queued_bytes -= front_event.size;
+    }
+    else if (std::holds_alternative<i3_event>(front_event.event))
+    {
+        // Resync marker is the only event without type.
+        m_is_resync_queued = false;
+    }
+
+    return std::move(front_event.event);
+}
+
+bool i3_ipc::can_receive_events() const
+{
+    return !m_event_queue_limits || m_event_queue_limits->policy != overflow_policy::block ||
+           (m_queued_events < m_event_queue_limits->max_events && m_queued_bytes < m_event_queue_limits->max_bytes);
+}
+
 std::optional<i3_ipc::event_type> i3_ipc::handle_next_i3_ipc_event()
 {
+    if (m_event_queue.empty() && m_event_coalescing)
+    {
+        receive_coalesced_events();
+    }
+
     if (m_event_queue.empty())
     {
         const i3_message::response response = i3_message::receive(m_socket);
@@ -247,10 +663,7 @@ std::optional<i3_ipc::event_type> i3_ipc::handle_next_i3_ipc_event()
         return handle_i3_event(event);
     }
 
-    const i3_ipc_event event = m_event_queue.front();
-    m_event_queue.pop();
-
-    return handle_i3_ipc_event(event);
+    return handle_i3_ipc_event(pop_queued_event());
 }
 
 i3_ipc::event_type i3_ipc::handle_next_event()
@@ -263,3 +676,58 @@ i3_ipc::event_type i3_ipc::handle_next_event()
 
     return *handled_event_type;
 }
+
+std::size_t i3_ipc::handle_pending_events(const std::function<void(const i3_containers::event_batch&)>& a_callback)
+{
+    i3_containers::event_batch batch;
+    std::size_t batch_size = 0;
+    std::exception_ptr exception;
+
+    // NOTE: Queue may hold only subscriptions, so reading is repeated until there is at least one event to handle.
+    while (batch_size == 0 && !exception)
+    {
+        // Wait for the next event only if nothing is queued, then take everything else that is already available.
+        // NOTE: Only the bytes which were already received at this point are read, so that steady stream of events
+        //       can't keep the call from returning. Message cut by the end of them is still read whole.
+        if (m_event_queue.empty())
+        {
+            receive_events();
+        }
+        std::size_t unread_bytes = i3_message::readable_bytes(m_socket);
+        while (unread_bytes != 0 && can_receive_events())
+        {
+            unread_bytes -= std::min(unread_bytes, receive_events());
+        }
+
+        while (!m_event_queue.empty() && !exception)
+        {
+            i3_ipc_event event = pop_queued_event();
+
+            if (auto* subscription = std::get_if<i3_subscription>(&event))
+            {
+                handle_subscription_event(std::move(*subscription));
+            }
+            else if (auto* i3_event_info = std::get_if<i3_containers::event>(&std::get<i3_event>(event)))
+            {
+                std::visit([&](auto& a_event) -> void { add_to_batch(batch, std::move(a_event)); }, *i3_event_info);
+                ++batch_size;
+            }
+            else
+            {
+                exception = std::get<std::exception_ptr>(std::get<i3_event>(event));
+            }
+        }
+    }
+
+    // Events parsed before the failure are still handled, the rest of them stay queued.
+    if (batch_size != 0)
+    {
+        a_callback(batch);
+    }
+    if (exception)
+    {
+        std::rethrow_exception(exception);
+    }
+
+    return batch_size;
+}
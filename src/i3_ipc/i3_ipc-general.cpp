@@ -25,15 +25,23 @@
 
 // Library headers.
 #include "i3_ipc.hpp"
+#include "i3_thread_pool.hpp"
+#include "i3_string_pool.hpp"
 #include "i3_ipc_exception.hpp"
 
 // C++ headers.
+#include <chrono>
+#include <memory>
 #include <string>
+#include <thread>
 #include <optional>
+#include <utility>
+#include <algorithm>
 #include <string_view>
 #include <system_error>
 
 // C headers.
+#include <cstddef>
 #include <cstdio>
 #include <cerrno>
 #include <cstring>
@@ -140,21 +148,45 @@ namespace
 i3_ipc::i3_ipc() : m_i3_socket_path(::find_i3_socket_path()),
                    m_socket(connect_to_i3(m_i3_socket_path)),
                    m_callbacks(),
-                   m_event_queue()
+                   m_event_queue(),
+                   m_queued_events(0),
+                   m_queued_bytes(0),
+                   m_is_resync_queued(false),
+                   m_tree_parsing_threads(1),
+                   m_tree_parsing_pool(),
+                   m_string_pool(),
+                   m_event_coalescing(),
+                   m_event_queue_limits()
 {
 }
 
 i3_ipc::i3_ipc(std::string_view a_i3_socket_path) : m_i3_socket_path(a_i3_socket_path),
                                                     m_socket(connect_to_i3(m_i3_socket_path)),
                                                     m_callbacks(),
-                                                    m_event_queue()
+                                                    m_event_queue(),
+                                                    m_queued_events(0),
+                                                    m_queued_bytes(0),
+                                                    m_is_resync_queued(false),
+                                                    m_tree_parsing_threads(1),
+                                                    m_tree_parsing_pool(),
+                                                    m_string_pool(),
+                                                    m_event_coalescing(),
+                                                    m_event_queue_limits()
 {
 }
 
 i3_ipc::i3_ipc(i3_ipc&& a_ipc) : m_i3_socket_path(std::move(a_ipc.m_i3_socket_path)),
                                  m_socket(std::move(a_ipc.m_socket)),
                                  m_callbacks(std::move(a_ipc.m_callbacks)),
-                                 m_event_queue(std::move(a_ipc.m_event_queue))
+                                 m_event_queue(std::move(a_ipc.m_event_queue)),
+                                 m_queued_events(a_ipc.m_queued_events),
+                                 m_queued_bytes(a_ipc.m_queued_bytes),
+                                 m_is_resync_queued(a_ipc.m_is_resync_queued),
+                                 m_tree_parsing_threads(a_ipc.m_tree_parsing_threads),
+                                 m_tree_parsing_pool(std::move(a_ipc.m_tree_parsing_pool)),
+                                 m_string_pool(std::move(a_ipc.m_string_pool)),
+                                 m_event_coalescing(a_ipc.m_event_coalescing),
+                                 m_event_queue_limits(std::move(a_ipc.m_event_queue_limits))
 {
     // Make sure that "a_ipc" doesn't close socket upon destruction.
     a_ipc.m_socket = 0;
@@ -191,8 +223,18 @@ std::string i3_ipc::get_i3_socket_path() const
 
 void i3_ipc::set_i3_socket_path(std::string_view a_i3_socket_path)
 {
+    const std::size_t tree_parsing_threads = m_tree_parsing_threads;
+    std::unique_ptr<i3_thread_pool> tree_parsing_pool = std::move(m_tree_parsing_pool);
+    std::shared_ptr<i3_containers::string_pool> string_pool = std::move(m_string_pool);
+    const std::optional<std::chrono::milliseconds> event_coalescing = m_event_coalescing;
+    const std::optional<event_queue_limits> queue_limits = m_event_queue_limits;
     this->~i3_ipc();
     new(this) i3_ipc(a_i3_socket_path);
+    m_tree_parsing_threads = tree_parsing_threads;
+    m_tree_parsing_pool = std::move(tree_parsing_pool);
+    m_string_pool = std::move(string_pool);
+    m_event_coalescing = event_coalescing;
+    m_event_queue_limits = queue_limits;
 }
 
 std::optional<std::string> i3_ipc::find_i3_socket_path()
@@ -206,3 +248,58 @@ std::optional<std::string> i3_ipc::find_i3_socket_path()
         return std::nullopt;
     }
 }
+
+std::size_t i3_ipc::get_tree_parsing_threads() const
+{
+    return m_tree_parsing_threads;
+}
+
+void i3_ipc::set_tree_parsing_threads(std::size_t a_threads)
+{
+    // NOTE: "hardware_concurrency" is allowed to return 0 when the number of hardware threads is unknown.
+    const std::size_t threads = a_threads != 0 ? a_threads : std::max(1u, std::thread::hardware_concurrency());
+    if (threads == m_tree_parsing_threads)
+    {
+        return;
+    }
+
+    // Old workers are joined first. If new ones can't be started, tree is parsed serially.
+    m_tree_parsing_pool.reset();
+    m_tree_parsing_threads = 1;
+    if (threads > 1)
+    {
+        // Calling thread is one of the threads, so the pool has one worker less.
+        m_tree_parsing_pool = std::make_unique<i3_thread_pool>(threads - 1);
+        m_tree_parsing_threads = threads;
+    }
+}
+
+std::shared_ptr<i3_containers::string_pool> i3_ipc::get_string_pool() const
+{
+    return m_string_pool;
+}
+
+void i3_ipc::set_string_pool(std::shared_ptr<i3_containers::string_pool> a_pool)
+{
+    m_string_pool = std::move(a_pool);
+}
+
+std::optional<std::chrono::milliseconds> i3_ipc::get_event_coalescing() const
+{
+    return m_event_coalescing;
+}
+
+void i3_ipc::set_event_coalescing(std::optional<std::chrono::milliseconds> a_window)
+{
+    m_event_coalescing = a_window;
+}
+
+std::optional<i3_ipc::event_queue_limits> i3_ipc::get_event_queue_limits() const
+{
+    return m_event_queue_limits;
+}
+
+void i3_ipc::set_event_queue_limits(std::optional<event_queue_limits> a_limits)
+{
+    m_event_queue_limits = std::move(a_limits);
+}
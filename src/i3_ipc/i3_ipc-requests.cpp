@@ -28,47 +28,73 @@
 #include "i3_message.hpp"
 #include "i3_containers.hpp"
 #include "i3_json_parser.hpp"
+#include "i3_tree_visitor.hpp"
+#include "i3_hashed_tree.hpp"
+#include "i3_compact_node.hpp"
+#include "i3_persistent_tree.hpp"
+#include "i3_string_pool.hpp"
+#include "i3_pmr_containers.hpp"
 #include "i3_ipc_bad_message.hpp"
 #include "i3_ipc_invalid_argument.hpp"
 
 // C++ headers.
+#include <memory>
 #include <string>
 #include <vector>
 #include <optional>
 #include <exception>
+#include <functional>
 #include <string_view>
+#include <memory_resource>
 
 // C headers.
 #include <cstdint>
 
-std::string i3_ipc::send_request(i3_message::type a_type, const std::optional<std::string_view>& a_payload) const
+i3_message::header i3_ipc::receive_response_header(i3_message::type a_type) const
 {
-    i3_message::send(m_socket, a_type, a_payload);
-
     // Read messages from socket until response is read.
     // Every event read in the meantime should be parsed and pushed to event queue for later handling.
-    i3_message::response response = i3_message::receive(m_socket);
-    while (response.message_type != a_type)
+    // NOTE: Limits of event queue are applied while pushing, since the response can't be read before these events.
+    i3_message::header header = i3_message::receive_header(m_socket);
+    while (header.message_type != a_type)
     {
-        i3_event event;
-        try
-        {
-            event = i3_json_parser::parse_event(response.message_type, response.payload.c_str());
-        }
-        catch(const i3_ipc_bad_message&)
-        {
-            throw;
-        }
-        catch(...)
-        {
-            event = std::current_exception();
-        }
-        m_event_queue.push(event);
-
-        response = i3_message::receive(m_socket);
+        push_event(i3_message::response{ header.message_type,
+                                         i3_message::receive_payload(m_socket, header.payload_size) });
+
+        header = i3_message::receive_header(m_socket);
     }
 
-    return response.payload;
+    return header;
+}
+
+std::string i3_ipc::send_request(i3_message::type a_type, const std::optional<std::string_view>& a_payload) const
+{
+    i3_message::send(m_socket, a_type, a_payload);
+
+    const i3_message::header header = receive_response_header(a_type);
+    return i3_message::receive_payload(m_socket, header.payload_size);
+}
+
+void i3_ipc::send_streamed_request(i3_message::type a_type,
+                                   const std::function<void(i3_message::payload_stream&)>& a_parser,
+                                   const std::optional<std::string_view>& a_payload) const
+{
+    i3_message::send(m_socket, a_type, a_payload);
+
+    // Response is parsed while it is being read, so it is never stored as a whole.
+    const i3_message::header header = receive_response_header(a_type);
+    i3_message::payload_stream stream(m_socket, header.payload_size);
+    try
+    {
+        a_parser(stream);
+    }
+    catch(...)
+    {
+        // Keep the socket usable for the next message, even when parsing failed.
+        stream.discard();
+        throw;
+    }
+    stream.discard();
 }
 
 void i3_ipc::execute_commands(std::string_view a_commands) const
@@ -96,8 +122,101 @@ std::vector<i3_containers::output> i3_ipc::get_outputs() const
 
 i3_containers::node i3_ipc::get_tree() const
 {
-    const std::string response = send_request(i3_message::type::tree);
-    return i3_json_parser::parse_tree(response.c_str());
+    i3_containers::node tree;
+    send_streamed_request(i3_message::type::tree, [&](i3_message::payload_stream& a_stream) -> void
+                                                  {
+                                                      tree = i3_json_parser::parse_tree(a_stream, nullptr,
+                                                                                        m_tree_parsing_pool.get());
+                                                  });
+    return tree;
+}
+
+i3_containers::node i3_ipc::get_tree(const tree_filter& a_filter) const
+{
+    i3_containers::node tree;
+    send_streamed_request(i3_message::type::tree, [&](i3_message::payload_stream& a_stream) -> void
+                                                  {
+                                                      tree = i3_json_parser::parse_tree(a_stream, a_filter,
+                                                                                        m_tree_parsing_pool.get());
+                                                  });
+    return tree;
+}
+
+void i3_ipc::get_tree(i3_containers::node& a_tree) const
+{
+    send_streamed_request(i3_message::type::tree, [&](i3_message::payload_stream& a_stream) -> void
+                                                  {
+                                                      i3_json_parser::parse_tree(a_stream, a_tree);
+                                                  });
+}
+
+i3_containers::pmr::node i3_ipc::get_tree(std::pmr::memory_resource* a_resource) const
+{
+    std::pmr::memory_resource* const resource = a_resource ? a_resource : std::pmr::get_default_resource();
+
+    i3_containers::pmr::node tree(resource);
+    send_streamed_request(i3_message::type::tree, [&](i3_message::payload_stream& a_stream) -> void
+                                                  {
+                                                      tree = i3_json_parser::parse_tree(a_stream, resource);
+                                                  });
+    return tree;
+}
+
+i3_containers::compact_node i3_ipc::get_compact_tree() const
+{
+    const i3_json_parser::string_pool_pointer pool = m_string_pool ? m_string_pool
+                                                                   : std::make_shared<i3_containers::string_pool>();
+
+    i3_containers::compact_node tree;
+    send_streamed_request(i3_message::type::tree, [&](i3_message::payload_stream& a_stream) -> void
+                                                  {
+                                                      tree = i3_json_parser::parse_compact_tree(a_stream, pool);
+                                                  });
+    return tree;
+}
+
+i3_containers::hashed_tree i3_ipc::get_hashed_tree() const
+{
+    // NOTE: Hashes are computed in a single pass after parsing, which respects "set_tree_parsing_threads".
+    return i3_containers::hashed_tree(get_tree());
+}
+
+i3_containers::persistent_node::pointer i3_ipc::get_persistent_tree() const
+{
+    return i3_containers::persistent_node::make(get_tree());
+}
+
+std::optional<i3_containers::focus_path> i3_ipc::get_focused_node() const
+{
+    std::optional<i3_containers::focus_path> focused_node;
+    send_streamed_request(i3_message::type::tree, [&](i3_message::payload_stream& a_stream) -> void
+                                                  {
+                                                      focused_node = i3_json_parser::parse_focused_node(a_stream);
+                                                  });
+    return focused_node;
+}
+
+std::vector<i3_containers::window_info> i3_ipc::get_windows() const
+{
+    std::vector<i3_containers::window_info> windows;
+    send_streamed_request(i3_message::type::tree, [&](i3_message::payload_stream& a_stream) -> void
+                                                  {
+                                                      windows = i3_json_parser::parse_windows(a_stream);
+                                                  });
+    return windows;
+}
+
+void i3_ipc::visit_tree(i3_tree_visitor& a_visitor) const
+{
+    send_streamed_request(i3_message::type::tree, [&](i3_message::payload_stream& a_stream) -> void
+                                                  {
+                                                      i3_json_parser::visit_tree(a_stream, a_visitor);
+                                                  });
+}
+
+void i3_ipc::visit_event(std::string_view a_payload, i3_tree_visitor& a_visitor)
+{
+    i3_json_parser::visit_event(a_payload, a_visitor);
 }
 
 std::vector<std::string> i3_ipc::get_marks() const
@@ -141,8 +260,12 @@ std::vector<std::string> i3_ipc::get_binding_modes() const
 
 std::string i3_ipc::get_config() const
 {
-    const std::string response = send_request(i3_message::type::config);
-    return i3_json_parser::parse_config(response.c_str());
+    std::string config;
+    send_streamed_request(i3_message::type::config, [&](i3_message::payload_stream& a_stream) -> void
+                                                    {
+                                                        config = i3_json_parser::parse_config(a_stream);
+                                                    });
+    return config;
 }
 
 void i3_ipc::send_tick(const std::optional<std::string_view>& a_payload) const
@@ -0,0 +1,152 @@
+/*
+    Copyright (C) 2019, Ivan Balević
+
+    This file is part of "i3-ipc++" library.
+
+    "i3-ipc++" is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    "i3-ipc++" is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with "i3-ipc++". If not, see <https://www.gnu.org/licenses/>.
+*/
+/**
+ * \file    i3_json_backend-rapidjson.hpp
+ *
+ * \brief   Defines "rapidjson_backend" class which provides access to JSON documents parsed by "RapidJSON".
+ */
+
+#ifndef I3_JSON_BACKEND_RAPIDJSON_HPP
+#define I3_JSON_BACKEND_RAPIDJSON_HPP
+
+// Library headers.
+#include "i3_message.hpp"
+
+// External library headers.
+#include <rapidjson/document.h>
+
+// C++ headers.
+#include <string_view>
+
+// C headers.
+#include <cstddef>
+#include <cassert>
+
+/**
+ * \brief   JSON backend which parses JSON into "RapidJSON" document.
+ */
+// NOTE: This class is abstract and is intended to be used as a namespace.
+// NOTE: Every JSON backend must provide the same set of types and static member functions as this one.
+class rapidjson_backend
+{
+
+public:
+
+    // Make class abstract.
+    virtual ~rapidjson_backend() = 0;
+
+    /**
+     * \brief   Type of parsed JSON document which owns all of its values.
+     */
+    using document = rapidjson::Document;
+
+    /**
+     * \brief   Type used to access one JSON value inside of the document. It is cheap to copy.
+     */
+    using value = const rapidjson::Value&;
+
+    /**
+     * \brief                      Parses JSON string into JSON document.
+     *
+     * \param [in] a_json_string   JSON string to be parsed.
+     *
+     * \return                     JSON document.
+     */
+    static document parse(const char* a_json_string)
+    {
+        document json_document;
+        json_document.Parse(a_json_string);
+        assert(!json_document.HasParseError());
+
+        return json_document;
+    }
+
+    /**
+     * \brief               Parses part of the larger JSON string into JSON document.
+     *
+     * \param [in] a_json   JSON to be parsed. It doesn't have to be null-terminated.
+     *
+     * \return              JSON document.
+     */
+    static document parse(std::string_view a_json)
+    {
+        document json_document;
+        json_document.Parse(a_json.data(), a_json.size());
+        assert(!json_document.HasParseError());
+
+        return json_document;
+    }
+
+    /**
+     * \brief                       Parses JSON read from the stream into JSON document, while it is being read.
+     *
+     * \param [in] a_stream         Stream from which JSON is read.
+     *
+     * \return                      JSON document.
+     *
+     * \throws std::system_error    When system error occurs while reading from the stream.
+     *
+     * \throws i3_ipc_bad_message   When stream ends before the whole JSON is read.
+     */
+    static document parse(i3_message::payload_stream& a_stream)
+    {
+        document json_document;
+        json_document.ParseStream(a_stream);
+        assert(!json_document.HasParseError());
+
+        return json_document;
+    }
+
+    /// \cond DO_NOT_DOCUMENT
+    static bool is_null(value a_value)   { return a_value.IsNull();   }
+    static bool is_object(value a_value) { return a_value.IsObject(); }
+    static bool is_array(value a_value)  { return a_value.IsArray();  }
+    static bool is_string(value a_value) { return a_value.IsString(); }
+
+    static bool has_member(value a_object, const char* a_name)
+    {
+        assert(a_object.IsObject());
+        return a_object.HasMember(a_name);
+    }
+
+    static value member(value a_object, const char* a_name)
+    {
+        assert(has_member(a_object, a_name));
+        return a_object[a_name];
+    }
+
+    static auto elements(value a_array)
+    {
+        assert(a_array.IsArray());
+        return a_array.GetArray();
+    }
+
+    static std::size_t size(value a_array)
+    {
+        assert(a_array.IsArray());
+        return a_array.Size();
+    }
+
+    template<typename T> static bool is(value a_value) { return a_value.template Is<T>();  }
+    template<typename T> static T get(value a_value)   { return a_value.template Get<T>(); }
+    /// \endcond
+
+}; // class rapidjson_backend
+
+#endif // I3_JSON_BACKEND_RAPIDJSON_HPP
@@ -0,0 +1,239 @@
+/*
+    Copyright (C) 2019, Ivan Balević
+
+    This file is part of "i3-ipc++" library.
+
+    "i3-ipc++" is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    "i3-ipc++" is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with "i3-ipc++". If not, see <https://www.gnu.org/licenses/>.
+*/
+/**
+ * \file    i3_json_backend-simdjson.hpp
+ *
+ * \brief   Defines "simdjson_backend" class which provides access to JSON documents parsed by "simdjson".
+ */
+
+#ifndef I3_JSON_BACKEND_SIMDJSON_HPP
+#define I3_JSON_BACKEND_SIMDJSON_HPP
+
+// Library headers.
+#include "i3_message.hpp"
+
+// External library headers.
+#include <simdjson.h>
+
+// C++ headers.
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <string_view>
+
+// C headers.
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cassert>
+
+/**
+ * \brief   JSON backend which parses JSON into "simdjson" DOM.
+ */
+// NOTE: This class is abstract and is intended to be used as a namespace.
+// NOTE: "simdjson" needs the whole input at once, so streamed messages are read completely before they are parsed.
+// NOTE: On-Demand API is not used, since it allows each value to be read only once and in document order,
+//       while the extraction functions look up the attributes of JSON objects in arbitrary order.
+class simdjson_backend
+{
+
+public:
+
+    // Make class abstract.
+    virtual ~simdjson_backend() = 0;
+
+    /**
+     * \brief   Type of parsed JSON document which owns all of its values.<br>
+     *          It can be used wherever single JSON value is expected, in which case it represents its root value.
+     */
+    class document
+    {
+
+    public:
+
+        /// \cond DO_NOT_DOCUMENT
+        operator simdjson::dom::element() const
+        {
+            // Root is taken from the parser each time, since elements refer to the address of parsed document.
+            return m_parser.doc.root();
+        }
+        /// \endcond
+
+    private:
+
+        friend class simdjson_backend;
+
+        simdjson::dom::parser m_parser; /**< Parser which owns the parsed document. */
+
+    }; // class document
+
+    /**
+     * \brief   Type used to access one JSON value inside of the document. It is cheap to copy.
+     */
+    using value = simdjson::dom::element;
+
+    /**
+     * \brief                      Parses JSON string into JSON document.
+     *
+     * \param [in] a_json_string   JSON string to be parsed.
+     *
+     * \return                     JSON document.
+     */
+    static document parse(const char* a_json_string)
+    {
+        document json_document;
+        [[maybe_unused]] const simdjson::error_code error = json_document.m_parser.parse(a_json_string,
+                                                                                       std::strlen(a_json_string))
+                                                                                .error();
+        assert(!error);
+
+        return json_document;
+    }
+
+    /**
+     * \brief               Parses part of the larger JSON string into JSON document.
+     *
+     * \param [in] a_json   JSON to be parsed. It doesn't have to be null-terminated.
+     *
+     * \return              JSON document.
+     */
+    static document parse(std::string_view a_json)
+    {
+        document json_document;
+        [[maybe_unused]] const simdjson::error_code error = json_document.m_parser.parse(a_json.data(), a_json.size())
+                                                                                .error();
+        assert(!error);
+
+        return json_document;
+    }
+
+    /**
+     * \brief                       Reads whole JSON from the stream and parses it into JSON document.
+     *
+     * \param [in] a_stream         Stream from which JSON is read.
+     *
+     * \return                      JSON document.
+     *
+     * \throws std::system_error    When system error occurs while reading from the stream.
+     *
+     * \throws i3_ipc_bad_message   When stream ends before the whole JSON is read.
+     */
+    static document parse(i3_message::payload_stream& a_stream)
+    {
+        // Padding is reserved up front, so the payload is parsed in place instead of being copied once more.
+        const std::string json_string = a_stream.read_rest(SIMDJSON_PADDING);
+        assert(json_string.capacity() >= json_string.size() + SIMDJSON_PADDING);
+
+        document json_document;
+        [[maybe_unused]] const simdjson::error_code error = json_document.m_parser.parse(json_string.data(),
+                                                                                       json_string.size(),
+                                                                                       false)
+                                                                                .error();
+        assert(!error);
+
+        return json_document;
+    }
+
+    /// \cond DO_NOT_DOCUMENT
+    static bool is_null(value a_value)   { return a_value.is_null();   }
+    static bool is_object(value a_value) { return a_value.is_object(); }
+    static bool is_array(value a_value)  { return a_value.is_array();  }
+    static bool is_string(value a_value) { return a_value.is_string(); }
+
+    static bool has_member(value a_object, const char* a_name)
+    {
+        assert(a_object.is_object());
+        return a_object.at_key(a_name).error() == simdjson::SUCCESS;
+    }
+
+    static value member(value a_object, const char* a_name)
+    {
+        value member_value;
+        [[maybe_unused]] const simdjson::error_code error = a_object.at_key(a_name).get(member_value);
+        assert(!error);
+
+        return member_value;
+    }
+
+    static simdjson::dom::array elements(value a_array)
+    {
+        simdjson::dom::array array;
+        [[maybe_unused]] const simdjson::error_code error = a_array.get_array().get(array);
+        assert(!error);
+
+        return array;
+    }
+
+    static std::size_t size(value a_array)
+    {
+        return elements(a_array).size();
+    }
+
+    template<typename T>
+    static bool is(value a_value)
+    {
+        // "simdjson" stores only 64-bit numbers, so narrower types are checked against their limits.
+        if constexpr (std::is_same_v<T, int>)
+        {
+            std::int64_t number = 0;
+            return a_value.get_int64().get(number) == simdjson::SUCCESS
+                   && number >= std::numeric_limits<int>::min() && number <= std::numeric_limits<int>::max();
+        }
+        else if constexpr (std::is_same_v<T, unsigned>)
+        {
+            std::uint64_t number = 0;
+            return a_value.get_uint64().get(number) == simdjson::SUCCESS
+                   && number <= std::numeric_limits<unsigned>::max();
+        }
+        else if constexpr (std::is_same_v<T, float>)
+        {
+            return a_value.is<double>();
+        }
+        else
+        {
+            return a_value.is<T>();
+        }
+    }
+
+    template<typename T>
+    static T get(value a_value)
+    {
+        assert(is<T>(a_value));
+        if constexpr (std::is_same_v<T, int>)
+        {
+            return static_cast<int>(a_value.get_int64().value_unsafe());
+        }
+        else if constexpr (std::is_same_v<T, unsigned>)
+        {
+            return static_cast<unsigned>(a_value.get_uint64().value_unsafe());
+        }
+        else if constexpr (std::is_same_v<T, float>)
+        {
+            return static_cast<float>(a_value.get_double().value_unsafe());
+        }
+        else
+        {
+            return a_value.get<T>().value_unsafe();
+        }
+    }
+    /// \endcond
+
+}; // class simdjson_backend
+
+#endif // I3_JSON_BACKEND_SIMDJSON_HPP
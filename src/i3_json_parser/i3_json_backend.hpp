@@ -0,0 +1,52 @@
+/*
+    Copyright (C) 2019, Ivan Balević
+
+    This file is part of "i3-ipc++" library.
+
+    "i3-ipc++" is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    "i3-ipc++" is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with "i3-ipc++". If not, see <https://www.gnu.org/licenses/>.
+*/
+/**
+ * \file    i3_json_backend.hpp
+ *
+ * \brief   Selects the JSON backend used by "i3_json_parser" class for parsing JSON into DOM.
+ */
+
+#ifndef I3_JSON_BACKEND_HPP
+#define I3_JSON_BACKEND_HPP
+
+// NOTE: Backend is chosen at build time. "RapidJSON" is used by default and "simdjson" is used when the library is
+//       configured with "use_simdjson" option. Streaming parsers ("i3_json_parser-sax.inl") always use "RapidJSON".
+#ifdef I3_IPC_USE_SIMDJSON
+
+// Library headers.
+#include "i3_json_backend-simdjson.hpp"
+
+/**
+ * \brief   JSON backend used for parsing JSON into DOM.
+ */
+using i3_json_backend = simdjson_backend;
+
+#else
+
+// Library headers.
+#include "i3_json_backend-rapidjson.hpp"
+
+/**
+ * \brief   JSON backend used for parsing JSON into DOM.
+ */
+using i3_json_backend = rapidjson_backend;
+
+#endif // I3_IPC_USE_SIMDJSON
+
+#endif // I3_JSON_BACKEND_HPP
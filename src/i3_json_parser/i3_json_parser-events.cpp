@@ -25,6 +25,7 @@
 
 // Library headers.
 #include "i3_json_parser.hpp"
+#include "i3_json_backend.hpp"
 #include "i3_message.hpp"
 #include "i3_containers.hpp"
 #include "i3_ipc_bad_message.hpp"
@@ -34,9 +35,6 @@
 // Library templates.
 #include "i3_json_parser-utility.inl"
 
-// External library headers.
-#include <rapidjson/document.h>
-
 // C++ headers.
 #include <string>
 #include <optional>
@@ -57,7 +55,7 @@ namespace
      *
      * \throws i3_ipc_unsupported   When value of extracted workspace change is unknown to "i3-ipc++" library.
      */
-    i3_containers::workspace_change extract_workspace_change(const rapidjson::Value& a_json_object)
+    i3_containers::workspace_change extract_workspace_change(i3_json_backend::value a_json_object)
     {
         const std::string_view workspace_change = get_attribute_value<const char*>(a_json_object, "change");
         if (workspace_change == "focus")
@@ -107,7 +105,7 @@ namespace
      *
      * \throws i3_ipc_unsupported   When value of extracted output change is unknown to "i3-ipc++" library.
      */
-    i3_containers::output_change extract_output_change(const rapidjson::Value& a_json_object)
+    i3_containers::output_change extract_output_change(i3_json_backend::value a_json_object)
     {
         const std::string_view output_change = get_attribute_value<const char*>(a_json_object, "change");
         if (output_change == "unspecified")
@@ -129,7 +127,7 @@ namespace
      *
      * \throws i3_ipc_unsupported   When value of extracted window change is unknown to "i3-ipc++" library.
      */
-    i3_containers::window_change extract_window_change(const rapidjson::Value& a_json_object)
+    i3_containers::window_change extract_window_change(i3_json_backend::value a_json_object)
     {
         const std::string_view window_change = get_attribute_value<const char*>(a_json_object, "change");
         if (window_change == "new")
@@ -183,7 +181,7 @@ namespace
      *
      * \throws i3_ipc_unsupported   When value of extracted binding change is unknown to "i3-ipc++" library.
      */
-    i3_containers::binding_change extract_binding_change(const rapidjson::Value& a_json_object)
+    i3_containers::binding_change extract_binding_change(i3_json_backend::value a_json_object)
     {
         const std::string_view binding_change = get_attribute_value<const char*>(a_json_object, "change");
         if (binding_change == "run")
@@ -205,7 +203,7 @@ namespace
      *
      * \throws i3_ipc_unsupported   When value of extracted binding input type is unknown to "i3-ipc++" library.
      */
-    i3_containers::binding_input_type extract_binding_input_type(const rapidjson::Value& a_json_object)
+    i3_containers::binding_input_type extract_binding_input_type(i3_json_backend::value a_json_object)
     {
         const std::string_view binding_input_type = get_attribute_value<const char*>(a_json_object, "input_type");
         if (binding_input_type == "keyboard")
@@ -231,22 +229,23 @@ namespace
      *
      * \throws i3_ipc_unsupported   When value of extracted binding input type is unknown to "i3-ipc++" library.
      */
-    i3_containers::binding_info extract_binding_info(const rapidjson::Value& a_json_object)
+    i3_containers::binding_info extract_binding_info(i3_json_backend::value a_json_object)
     {
-        assert(a_json_object.IsObject());
-        assert(a_json_object.HasMember("binding"));
+        assert(i3_json_backend::is_object(a_json_object));
+        assert(i3_json_backend::has_member(a_json_object, "binding"));
 
-        const rapidjson::Value& binding_object = a_json_object["binding"];
+        i3_json_backend::value binding_object = i3_json_backend::member(a_json_object, "binding");
 
         i3_containers::binding_info binding_info;
         binding_info.command = get_attribute_value<const char*>(binding_object, "command");
 
-        assert(binding_object.HasMember("event_state_mask"));
-        assert(binding_object["event_state_mask"].IsArray());
-        for (const auto& event_state_mask : binding_object["event_state_mask"].GetArray())
+        assert(i3_json_backend::has_member(binding_object, "event_state_mask"));
+        i3_json_backend::value event_state_masks = i3_json_backend::member(binding_object, "event_state_mask");
+        assert(i3_json_backend::is_array(event_state_masks));
+        for (const auto& event_state_mask : i3_json_backend::elements(event_state_masks))
         {
-            assert(event_state_mask.IsString());
-            binding_info.event_state_mask.push_back(event_state_mask.GetString());
+            assert(i3_json_backend::is_string(event_state_mask));
+            binding_info.event_state_mask.push_back(i3_json_backend::get<const char*>(event_state_mask));
         }
 
         binding_info.input_code = get_attribute_value<std::optional<std::uint8_t>>(binding_object, "input_code");
@@ -266,7 +265,7 @@ namespace
      *
      * \throws i3_ipc_unsupported   When value of extracted shutdown type is unknown to "i3-ipc++" library.
      */
-    i3_containers::shutdown_type extract_shutdown_type(const rapidjson::Value& a_json_object)
+    i3_containers::shutdown_type extract_shutdown_type(i3_json_backend::value a_json_object)
     {
         const std::string_view shutdown_type = get_attribute_value<const char*>(a_json_object, "change");
         if (shutdown_type == "restart")
@@ -294,27 +293,29 @@ void i3_json_parser::parse_subscribe_response(const char* a_json_string)
 
 i3_containers::workspace_event i3_json_parser::parse_workspace_event(const char* a_json_string)
 {
-    const rapidjson::Document& json_object = parse_json(a_json_string);
+    const i3_json_backend::document& json_object = parse_json(a_json_string);
 
     i3_containers::workspace_event workspace_event;
     workspace_event.change = extract_workspace_change(json_object);
 
-    if (!json_object.HasMember("old") || json_object["old"].IsNull())
+    if (!i3_json_backend::has_member(json_object, "old")
+        || i3_json_backend::is_null(i3_json_backend::member(json_object, "old")))
     {
         workspace_event.old = std::nullopt;
     }
     else
     {
-        workspace_event.old = std::make_optional(extract_tree(json_object["old"]));
+        workspace_event.old = std::make_optional(extract_tree(i3_json_backend::member(json_object, "old")));
     }
 
-    if (!json_object.HasMember("current") || json_object["current"].IsNull())
+    if (!i3_json_backend::has_member(json_object, "current")
+        || i3_json_backend::is_null(i3_json_backend::member(json_object, "current")))
     {
         workspace_event.current = std::nullopt;
     }
     else
     {
-        workspace_event.current = std::make_optional(extract_tree(json_object["current"]));
+        workspace_event.current = std::make_optional(extract_tree(i3_json_backend::member(json_object, "current")));
     }
 
     return workspace_event;
@@ -327,7 +328,7 @@ i3_containers::output_event i3_json_parser::parse_output_event(const char* a_jso
 
 i3_containers::mode_event i3_json_parser::parse_mode_event(const char* a_json_string)
 {
-    const rapidjson::Document& json_object = parse_json(a_json_string);
+    const i3_json_backend::document& json_object = parse_json(a_json_string);
 
     i3_containers::mode_event mode_event;
     mode_event.change = get_attribute_value<const char*>(json_object, "change");
@@ -338,18 +339,18 @@ i3_containers::mode_event i3_json_parser::parse_mode_event(const char* a_json_st
 
 i3_containers::window_event i3_json_parser::parse_window_event(const char* a_json_string)
 {
-    const rapidjson::Document& json_object = parse_json(a_json_string);
+    const i3_json_backend::document& json_object = parse_json(a_json_string);
 
     i3_containers::window_event window_event;
     window_event.change = extract_window_change(json_object);
-    window_event.container = extract_tree(json_object["container"]);
+    window_event.container = extract_tree(i3_json_backend::member(json_object, "container"));
 
     return window_event;
 }
 
 i3_containers::binding_event i3_json_parser::parse_binding_event(const char* a_json_string)
 {
-    const rapidjson::Document& json_object = parse_json(a_json_string);
+    const i3_json_backend::document& json_object = parse_json(a_json_string);
 
     i3_containers::binding_event binding_event;
     binding_event.change = extract_binding_change(json_object);
@@ -365,7 +366,7 @@ i3_containers::shutdown_event i3_json_parser::parse_shutdown_event(const char* a
 
 i3_containers::tick_event i3_json_parser::parse_tick_event(const char* a_json_string)
 {
-    const rapidjson::Document& json_object = parse_json(a_json_string);
+    const i3_json_backend::document& json_object = parse_json(a_json_string);
 
     i3_containers::tick_event tick_event;
     tick_event.is_first = get_attribute_value<bool>(json_object, "first");
@@ -0,0 +1,331 @@
+/*
+    Copyright (C) 2019, Ivan Balević
+
+    This file is part of "i3-ipc++" library.
+
+    "i3-ipc++" is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    "i3-ipc++" is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with "i3-ipc++". If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+ * \file    i3_json_parser-parallel.cpp
+ *
+ * \brief   Defines member functions of "i3_json_parser" class that parse subtrees of the node tree in parallel.
+ */
+
+// Library headers.
+#include "i3_json_parser.hpp"
+#include "i3_message.hpp"
+#include "i3_containers.hpp"
+#include "i3_thread_pool.hpp"
+
+// C++ headers.
+#include <deque>
+#include <string>
+#include <vector>
+#include <future>
+#include <exception>
+#include <utility>
+#include <functional>
+#include <string_view>
+
+// C headers.
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+
+namespace
+{
+    /**
+     * \brief   Depth of workspaces in i3 node tree (root -> output -> content container -> workspace).
+     */
+    constexpr std::size_t workspace_depth = 3;
+
+    /**
+     * \brief   Structure used to represent one workspace which is parsed by the pool.
+     */
+    struct subtree
+    {
+        std::size_t output;       /**< Index of the output among tiling child nodes of the root node. */
+        std::size_t container;    /**< Index of the container among tiling child nodes of the output. */
+        i3_containers::node node; /**< Parsed workspace, once the task is finished.                   */
+        std::future<void> task;   /**< Task which parses the workspace.                               */
+    };
+
+    /**
+     * \brief                      Reads JSON of i3 node tree from the stream and splits it into workspaces and the
+     *                             skeleton around them, without parsing the JSON.<br>
+     *                             Workspace is any tiling child node at "workspace_depth" reached only through
+     *                             tiling child nodes, which covers workspaces of real outputs and the scratchpad one.
+     *
+     * \param [in] a_stream        Stream from which JSON of the node tree is read.
+     *
+     * \param [out] a_skeleton     JSON of the node tree in which every workspace is replaced by number 0.
+     *
+     * \param [in] a_on_subtree    Function called with the JSON of every workspace as soon as it is read,
+     *                             together with the indexes of its output and of its content container.
+     *
+     * \throws std::system_error   When system error occurs while reading from the stream.
+     *
+     * \throws i3_ipc_bad_message  When stream ends before the whole JSON is read.
+     */
+    // NOTE: Only the nesting, strings and escapes are tracked, everything else is copied without being looked at.
+    void split_tree(i3_message::payload_stream& a_stream,
+                    std::string& a_skeleton,
+                    const std::function<void(std::string&&, std::size_t, std::size_t)>& a_on_subtree)
+    {
+        // Kind of every opened object and array outside of workspaces.
+        enum class scope_kind : std::uint8_t
+        {
+            node,        // Node which is an ancestor of workspaces.
+            child_nodes, // "nodes" array of such node.
+            other        // Anything else.
+        };
+        struct scope
+        {
+            scope_kind kind;
+            std::size_t children; // Number of child nodes read so far, if the scope is "nodes" array.
+        };
+        std::vector<scope> scopes;
+        std::size_t node_depth = 0;     // Number of opened scopes of "node" kind.
+        std::size_t output = 0;         // Index of the current output.
+        std::size_t container = 0;      // Index of the current content container.
+
+        std::string subtree_json;       // JSON of the workspace that is currently being read.
+        std::size_t subtree_depth = 0;  // Nesting inside of the current workspace, 0 outside of workspaces.
+        std::string last_key;           // Last string that ended directly inside of the node of "node" kind.
+        std::string* string = nullptr;  // String into which the current string is read, if it is needed.
+        bool is_in_string = false;
+        bool is_escaped = false;
+
+        while (a_stream.Peek() != '\0')
+        {
+            const char character = a_stream.Take();
+            std::string& output_json = subtree_depth > 0 ? subtree_json : a_skeleton;
+
+            if (is_in_string)
+            {
+                output_json.push_back(character);
+                if (is_escaped)
+                {
+                    is_escaped = false;
+                }
+                else if (character == '\\')
+                {
+                    is_escaped = true;
+                }
+                else if (character == '"')
+                {
+                    is_in_string = false;
+                    string = nullptr;
+                    continue;
+                }
+
+                if (string)
+                {
+                    string->push_back(character);
+                }
+                continue;
+            }
+
+            // Inside of the workspace only the nesting is tracked, to find where it ends.
+            if (subtree_depth > 0)
+            {
+                subtree_json.push_back(character);
+                if (character == '"')
+                {
+                    is_in_string = true;
+                }
+                else if (character == '{' || character == '[')
+                {
+                    ++subtree_depth;
+                }
+                else if ((character == '}' || character == ']') && --subtree_depth == 0)
+                {
+                    a_on_subtree(std::move(subtree_json), output, container);
+                    subtree_json.clear();
+                }
+                continue;
+            }
+
+            switch (character)
+            {
+                case '"':
+                    is_in_string = true;
+                    if (!scopes.empty() && scopes.back().kind == scope_kind::node)
+                    {
+                        last_key.clear();
+                        string = &last_key;
+                    }
+                    break;
+
+                case '{':
+                    if (scopes.empty())
+                    {
+                        scopes.push_back({ scope_kind::node, 0 });
+                        ++node_depth;
+                    }
+                    else if (scopes.back().kind == scope_kind::child_nodes && node_depth == workspace_depth)
+                    {
+                        // Workspace is replaced by a placeholder which is ignored while the skeleton is parsed.
+                        a_skeleton.push_back('0');
+                        subtree_json.push_back(character);
+                        subtree_depth = 1;
+                        continue;
+                    }
+                    else if (scopes.back().kind == scope_kind::child_nodes)
+                    {
+                        (node_depth == 1 ? output : container) = scopes.back().children++;
+                        scopes.push_back({ scope_kind::node, 0 });
+                        ++node_depth;
+                    }
+                    else
+                    {
+                        scopes.push_back({ scope_kind::other, 0 });
+                    }
+                    break;
+
+                case '[':
+                    // Array value always follows its key, so the last string in the node is the key.
+                    if (!scopes.empty() && scopes.back().kind == scope_kind::node && last_key == "nodes")
+                    {
+                        scopes.push_back({ scope_kind::child_nodes, 0 });
+                    }
+                    else
+                    {
+                        scopes.push_back({ scope_kind::other, 0 });
+                    }
+                    break;
+
+                case '}':
+                case ']':
+                    if (!scopes.empty())
+                    {
+                        if (scopes.back().kind == scope_kind::node)
+                        {
+                            --node_depth;
+                        }
+                        scopes.pop_back();
+                    }
+                    break;
+
+                default:
+                    break;
+            }
+
+            a_skeleton.push_back(character);
+        }
+    }
+
+} // Unnamed namespace.
+
+i3_containers::node i3_json_parser::parse_tree_in_parallel(i3_message::payload_stream& a_stream,
+                                                           const i3_ipc::tree_filter& a_filter,
+                                                           i3_thread_pool& a_pool)
+{
+    // Workspaces are parsed by the pool while this thread keeps reading the rest of the response.
+    // NOTE: Deque never moves its elements, so tasks can refer to them while new ones are being added.
+    std::deque<subtree> subtrees;
+    std::string skeleton;
+    std::exception_ptr exception;
+    try
+    {
+        const auto parse_workspace = [&](std::string&& a_json, std::size_t a_output, std::size_t a_container) -> void
+        {
+            subtree& workspace = subtrees.emplace_back();
+            workspace.output = a_output;
+            workspace.container = a_container;
+            workspace.task = a_pool.submit([&workspace, &a_filter, json = std::move(a_json)]() -> void
+                                           {
+                                               workspace.node = parse_filtered_tree(json, a_filter);
+                                           });
+        };
+        split_tree(a_stream, skeleton, parse_workspace);
+    }
+    catch (...)
+    {
+        exception = std::current_exception();
+    }
+
+    // NOTE: All tasks must finish before any exception is propagated, since they refer to local variables.
+    for (auto& workspace : subtrees)
+    {
+        try
+        {
+            if (workspace.task.valid())
+            {
+                workspace.task.get();
+            }
+        }
+        catch (...)
+        {
+            if (!exception)
+            {
+                exception = std::current_exception();
+            }
+        }
+    }
+    if (exception)
+    {
+        std::rethrow_exception(exception);
+    }
+
+    // Skeleton is parsed without the filter, which is applied around workspaces once they are stitched in.
+    i3_containers::node root = parse_filtered_tree(skeleton, nullptr);
+    for (auto& workspace : subtrees)
+    {
+        assert(workspace.output < root.nodes.size());
+        i3_containers::node& output = root.nodes[workspace.output];
+        assert(workspace.container < output.nodes.size());
+        output.nodes[workspace.container].nodes.push_back(std::move(workspace.node));
+    }
+
+    if (!a_filter)
+    {
+        return root;
+    }
+
+    // Filter is applied top-down to the nodes of the skeleton. Subtrees of workspaces were already filtered by the
+    // pool, so only workspaces themselves are checked against their parents.
+    std::function<void(i3_containers::node&, std::size_t, bool)> filter_children;
+    filter_children = [&](i3_containers::node& a_node, std::size_t a_depth, bool a_is_split) -> void
+    {
+        const auto filter_nodes = [&](std::vector<i3_containers::node>& a_child_nodes,
+                                      std::vector<i3_containers::node>& a_kept_nodes,
+                                      bool a_is_tiling) -> void
+        {
+            const bool is_split = a_is_split && a_is_tiling;
+            for (auto& child_node : a_child_nodes)
+            {
+                if (!apply_filter(a_filter, child_node, a_node))
+                {
+                    continue;
+                }
+
+                if (!is_split || a_depth + 1 < workspace_depth)
+                {
+                    filter_children(child_node, a_depth + 1, is_split);
+                }
+                a_kept_nodes.push_back(std::move(child_node));
+            }
+        };
+
+        std::vector<i3_containers::node> nodes = std::move(a_node.nodes);
+        std::vector<i3_containers::node> floating_nodes = std::move(a_node.floating_nodes);
+        filter_nodes(nodes, a_node.nodes, true);
+        filter_nodes(floating_nodes, a_node.floating_nodes, false);
+    };
+    filter_children(root, 0, true);
+
+    return root;
+}
@@ -25,17 +25,18 @@
 
 // Library headers.
 #include "i3_json_parser.hpp"
+#include "i3_json_backend.hpp"
 #include "i3_containers.hpp"
+#include "i3_compact_node.hpp"
+#include "i3_string_pool.hpp"
 #include "i3_ipc_unsupported.hpp"
 #include "i3_ipc_invalid_argument.hpp"
 
 // Library templates.
 #include "i3_json_parser-utility.inl"
 
-// External library headers.
-#include <rapidjson/document.h>
-
 // C++ headers.
+#include <memory>
 #include <string>
 #include <optional>
 #include <string_view>
@@ -54,7 +55,7 @@ namespace
      *
      * \throws i3_ipc_unsupported   When value of extracted bar mode is unknown to "i3-ipc++" library.
      */
-    i3_containers::bar_mode extract_bar_mode(const rapidjson::Value& a_json_object)
+    i3_containers::bar_mode extract_bar_mode(i3_json_backend::value a_json_object)
     {
         const std::string_view bar_mode = get_attribute_value<const char*>(a_json_object, "mode");
         if (bar_mode == "dock")
@@ -80,7 +81,7 @@ namespace
      *
      * \throws i3_ipc_unsupported   When value of extracted bar position is unknown to "i3-ipc++" library.
      */
-    i3_containers::bar_position extract_bar_position(const rapidjson::Value& a_json_object)
+    i3_containers::bar_position extract_bar_position(i3_json_backend::value a_json_object)
     {
         const std::string_view bar_position = get_attribute_value<const char*>(a_json_object, "position");
         if (bar_position == "bottom")
@@ -104,7 +105,7 @@ namespace
      *
      * \return                     Extracted bar colors from the "a_json_object".
      */
-    i3_containers::bar_colors extract_bar_colors(const rapidjson::Value& a_json_object)
+    i3_containers::bar_colors extract_bar_colors(i3_json_backend::value a_json_object)
     {
         return
         {
@@ -142,11 +143,11 @@ namespace
 
 void i3_json_parser::parse_command_response(const char* a_json_string)
 {
-    const rapidjson::Document& json_array = parse_json(a_json_string);
-    assert(json_array.IsArray());
+    const i3_json_backend::document& json_array = parse_json(a_json_string);
+    assert(i3_json_backend::is_array(json_array));
 
     // Analyze command status for each command separately.
-    for (const auto& command_status : json_array.GetArray())
+    for (const auto& command_status : i3_json_backend::elements(json_array))
     {
         // If i3 declined current command, extract error message and throw exception with it.
         if (!get_attribute_value<bool>(command_status, "success"))
@@ -167,11 +168,11 @@ void i3_json_parser::parse_command_response(const char* a_json_string)
 
 std::vector<i3_containers::workspace> i3_json_parser::parse_workspaces(const char* a_json_string)
 {
-    const rapidjson::Document& json_array = parse_json(a_json_string);
-    assert(json_array.IsArray());
+    const i3_json_backend::document& json_array = parse_json(a_json_string);
+    assert(i3_json_backend::is_array(json_array));
 
     std::vector<i3_containers::workspace> workspaces;
-    for (const auto& workspace_info : json_array.GetArray())
+    for (const auto& workspace_info : i3_json_backend::elements(json_array))
     {
         i3_containers::workspace workspace;
         workspace.id = get_attribute_value<std::uint64_t>(workspace_info, "id");
@@ -192,11 +193,11 @@ std::vector<i3_containers::workspace> i3_json_parser::parse_workspaces(const cha
 
 std::vector<i3_containers::output> i3_json_parser::parse_outputs(const char* a_json_string)
 {
-    const rapidjson::Document& json_array = parse_json(a_json_string);
-    assert(json_array.IsArray());
+    const i3_json_backend::document& json_array = parse_json(a_json_string);
+    assert(i3_json_backend::is_array(json_array));
 
     std::vector<i3_containers::output> outputs;
-    for (const auto& output_info : json_array.GetArray())
+    for (const auto& output_info : i3_json_backend::elements(json_array))
     {
         i3_containers::output output;
         output.name = get_attribute_value<const char*>(output_info, "name");
@@ -211,21 +212,45 @@ std::vector<i3_containers::output> i3_json_parser::parse_outputs(const char* a_j
     return outputs;
 }
 
-i3_containers::node i3_json_parser::parse_tree(const char* a_json_string)
+i3_containers::node i3_json_parser::parse_tree(i3_message::payload_stream& a_stream,
+                                               const i3_ipc::tree_filter& a_filter,
+                                               i3_thread_pool* a_pool)
+{
+    if (a_pool)
+    {
+        return parse_tree_in_parallel(a_stream, a_filter, *a_pool);
+    }
+
+    if (a_filter)
+    {
+        return parse_filtered_tree(a_stream, a_filter);
+    }
+
+    return extract_tree(parse_json(a_stream));
+}
+
+void i3_json_parser::parse_tree(i3_message::payload_stream& a_stream, i3_containers::node& a_tree)
+{
+    extract_tree(parse_json(a_stream), a_tree);
+}
+
+i3_containers::compact_node i3_json_parser::parse_compact_tree(i3_message::payload_stream& a_stream,
+                                                               const string_pool_pointer& a_pool)
 {
-    return extract_tree(parse_json(a_json_string));
+    i3_containers::node scratch{ };
+    return extract_compact_tree(parse_json(a_stream), a_pool, scratch);
 }
 
 std::vector<std::string> i3_json_parser::parse_marks(const char* a_json_string)
 {
-    const rapidjson::Document& json_array = parse_json(a_json_string);
-    assert(json_array.IsArray());
+    const i3_json_backend::document& json_array = parse_json(a_json_string);
+    assert(i3_json_backend::is_array(json_array));
 
     std::vector<std::string> marks;
-    for (const auto& mark : json_array.GetArray())
+    for (const auto& mark : i3_json_backend::elements(json_array))
     {
-        assert(mark.IsString());
-        marks.push_back(mark.GetString());
+        assert(i3_json_backend::is_string(mark));
+        marks.push_back(i3_json_backend::get<const char*>(mark));
     }
 
     return marks;
@@ -233,14 +258,14 @@ std::vector<std::string> i3_json_parser::parse_marks(const char* a_json_string)
 
 std::vector<std::string> i3_json_parser::parse_bar_names(const char* a_json_string)
 {
-    const rapidjson::Document& json_array = parse_json(a_json_string);
-    assert(json_array.IsArray());
+    const i3_json_backend::document& json_array = parse_json(a_json_string);
+    assert(i3_json_backend::is_array(json_array));
 
     std::vector<std::string> bar_names;
-    for (const auto& bar_name : json_array.GetArray())
+    for (const auto& bar_name : i3_json_backend::elements(json_array))
     {
-        assert(bar_name.IsString());
-        bar_names.push_back(bar_name.GetString());
+        assert(i3_json_backend::is_string(bar_name));
+        bar_names.push_back(i3_json_backend::get<const char*>(bar_name));
     }
 
     return bar_names;
@@ -248,7 +273,7 @@ std::vector<std::string> i3_json_parser::parse_bar_names(const char* a_json_stri
 
 i3_containers::bar_config i3_json_parser::parse_bar_config(const char* a_json_string)
 {
-    const rapidjson::Document& json_object = parse_json(a_json_string);
+    const i3_json_backend::document& json_object = parse_json(a_json_string);
 
     const std::optional<std::string_view> id = get_attribute_value<std::optional<const char*>>(json_object, "id");
     if (!id)
@@ -272,7 +297,7 @@ i3_containers::bar_config i3_json_parser::parse_bar_config(const char* a_json_st
 
 i3_containers::version i3_json_parser::parse_version(const char* a_json_string)
 {
-    const rapidjson::Document& json_object = parse_json(a_json_string);
+    const i3_json_backend::document& json_object = parse_json(a_json_string);
 
     i3_containers::version version;
     version.major = get_attribute_value<std::uint8_t>(json_object, "major");
@@ -286,22 +311,22 @@ i3_containers::version i3_json_parser::parse_version(const char* a_json_string)
 
 std::vector<std::string> i3_json_parser::parse_binding_modes(const char* a_json_string)
 {
-    const rapidjson::Document& json_array = parse_json(a_json_string);
-    assert(json_array.IsArray());
+    const i3_json_backend::document& json_array = parse_json(a_json_string);
+    assert(i3_json_backend::is_array(json_array));
 
     std::vector<std::string> binding_modes;
-    for (const auto& binding_mode : json_array.GetArray())
+    for (const auto& binding_mode : i3_json_backend::elements(json_array))
     {
-        assert(binding_mode.IsString());
-        binding_modes.push_back(binding_mode.GetString());
+        assert(i3_json_backend::is_string(binding_mode));
+        binding_modes.push_back(i3_json_backend::get<const char*>(binding_mode));
     }
 
     return binding_modes;
 }
 
-std::string i3_json_parser::parse_config(const char* a_json_string)
+std::string i3_json_parser::parse_config(i3_message::payload_stream& a_stream)
 {
-    return get_attribute_value<const char*>(parse_json(a_json_string), "config");
+    return get_attribute_value<const char*>(parse_json(a_stream), "config");
 }
 
 void i3_json_parser::parse_tick_response(const char* a_json_string)
@@ -0,0 +1,293 @@
+/*
+    Copyright (C) 2019, Ivan Balević
+
+    This file is part of "i3-ipc++" library.
+
+    "i3-ipc++" is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    "i3-ipc++" is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with "i3-ipc++". If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+ * \file i3_json_parser-sax.inl
+ *
+ * Defines template handler which translates "RapidJSON" SAX events into events about i3 nodes.
+ */
+
+#ifndef I3_JSON_PARSER_SAX_INL
+#define I3_JSON_PARSER_SAX_INL
+
+// Library headers.
+#include "i3_json_parser.hpp"
+#include "i3_tree_visitor.hpp"
+
+// External library headers.
+#include <rapidjson/reader.h>
+
+// C++ headers.
+#include <string>
+#include <vector>
+#include <utility>
+#include <string_view>
+#include <type_traits>
+
+// C headers.
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+
+/**
+ * \brief              SAX handler which recognizes i3 nodes in JSON and reports only node-level events to consumer.
+ *
+ * \tparam Consumer    Type which receives node-level events. It must provide following member functions:<br>
+ *                     bool enter_node(std::string_view a_key) - Node object started. "a_key" is the attribute
+ *                     which holds the node ("nodes", "floating_nodes" or empty for the root node).<br>
+ *                     bool field(std::string_view a_object, std::string_view a_key, const i3_tree_visitor::value&)
+ *                     - Scalar attribute of the current node. "a_object" is the name of nested object which holds
+ *                     the attribute ("rect", "window_properties"...) or empty for attributes of the node itself.
+ *                     Each element of array attributes ("marks", "focus"...) is reported as separate field.<br>
+ *                     bool leave_node() - Node object ended.<br>
+ *                     Returning false from any of them stops the parsing.<br>
+ *                     Consumer may also provide bool accept_node() - Called once for every node, when its first
+ *                     child node array starts or when the node ends if it has none. Returning false skips the rest
+ *                     of the node together with its child nodes, and "leave_node" is not called for it.<br>
+ *                     When the root of the message is an event, its own attributes are reported as fields outside
+ *                     of any node, and nodes are recognized under "container", "current" and "old" attributes.
+ */
+/// \cond DO_NOT_DOCUMENT
+// Detects whether the consumer provides optional "accept_node" member function.
+template<typename Consumer, typename = void>
+struct has_accept_node : std::false_type
+{
+};
+
+template<typename Consumer>
+struct has_accept_node<Consumer, std::void_t<decltype(std::declval<Consumer&>().accept_node())>> : std::true_type
+{
+};
+/// \endcond
+
+// NOTE: Only the nesting of scopes is stored, so memory usage depends on the depth of the tree and not on its size.
+template<typename Consumer>
+class sax_tree_handler : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, sax_tree_handler<Consumer>>
+{
+
+public:
+
+    /**
+     * \brief                   Constructs handler which forwards node-level events to given consumer.
+     *
+     * \param [in] a_consumer   Consumer of node-level events.
+     *
+     * \param [in] a_is_event   Whether the root of the message is an event or a node.
+     */
+    explicit sax_tree_handler(Consumer& a_consumer, bool a_is_event = false)
+        : m_consumer(a_consumer), m_is_event(a_is_event), m_scopes(), m_key()
+    {
+    }
+
+    /// \cond DO_NOT_DOCUMENT
+    bool Null()                        { return value(nullptr);                             }
+    bool Bool(bool a_value)            { return value(a_value);                             }
+    bool Int(int a_value)              { return value(static_cast<std::int64_t>(a_value));  }
+    bool Uint(unsigned a_value)        { return value(static_cast<std::uint64_t>(a_value)); }
+    bool Int64(std::int64_t a_value)   { return value(a_value);                             }
+    bool Uint64(std::uint64_t a_value) { return value(a_value);                             }
+    bool Double(double a_value)        { return value(a_value);                             }
+
+    bool String(const char* a_string, rapidjson::SizeType a_length, bool)
+    {
+        return value(std::string_view(a_string, a_length));
+    }
+
+    bool Key(const char* a_string, rapidjson::SizeType a_length, bool)
+    {
+        if (!m_scopes.empty() && m_scopes.back().kind != scope_kind::skipped)
+        {
+            m_key.assign(a_string, a_length);
+        }
+
+        return true;
+    }
+
+    bool StartObject()
+    {
+        if (m_scopes.empty())
+        {
+            if (m_is_event)
+            {
+                m_scopes.push_back({ scope_kind::event, std::string(), true });
+                return true;
+            }
+
+            return start_node(std::string());
+        }
+
+        const scope_kind parent_kind = m_scopes.back().kind;
+        if (parent_kind == scope_kind::child_nodes)
+        {
+            return start_node(m_scopes.back().key);
+        }
+        else if (parent_kind == scope_kind::event && (m_key == "container" || m_key == "current" || m_key == "old"))
+        {
+            return start_node(m_key);
+        }
+        else if (parent_kind == scope_kind::node || parent_kind == scope_kind::event)
+        {
+            m_scopes.push_back({ scope_kind::object, m_key, true });
+        }
+        else
+        {
+            m_scopes.push_back({ scope_kind::skipped, std::string(), true });
+        }
+
+        return true;
+    }
+
+    bool EndObject(rapidjson::SizeType)
+    {
+        assert(!m_scopes.empty());
+        const bool is_node = m_scopes.back().kind == scope_kind::node && accept_node();
+        m_scopes.pop_back();
+
+        return !is_node || m_consumer.leave_node();
+    }
+
+    bool StartArray()
+    {
+        if (m_scopes.empty() || (m_scopes.back().kind != scope_kind::node && m_scopes.back().kind != scope_kind::event))
+        {
+            m_scopes.push_back({ scope_kind::skipped, std::string(), true });
+        }
+        else if (m_scopes.back().kind == scope_kind::node && (m_key == "nodes" || m_key == "floating_nodes"))
+        {
+            // Rejected node is skipped from here on, so none of its child nodes is ever reported.
+            const bool is_accepted = accept_node();
+            m_scopes.push_back({ is_accepted ? scope_kind::child_nodes : scope_kind::skipped, m_key, true });
+        }
+        else
+        {
+            m_scopes.push_back({ scope_kind::array, m_key, true });
+        }
+
+        return true;
+    }
+
+    bool EndArray(rapidjson::SizeType)
+    {
+        assert(!m_scopes.empty());
+        m_scopes.pop_back();
+        return true;
+    }
+    /// \endcond
+
+private:
+
+    /**
+     * \brief   Enumerator used to describe the kind of JSON scope that handler is currently in.
+     */
+    enum class scope_kind : std::uint8_t
+    {
+        event,       /**< Root object of event message.                           */
+        node,        /**< Object which represents i3 node.                        */
+        child_nodes, /**< Array with child nodes ("nodes" or "floating_nodes").   */
+        object,      /**< Object nested directly in node or event ("rect"...).    */
+        array,       /**< Array nested directly in node or event ("marks"...).    */
+        skipped      /**< Any other scope, nothing inside of it will be reported. */
+    };
+
+    /**
+     * \brief   Structure used to represent one opened JSON scope.
+     */
+    struct scope
+    {
+        scope_kind kind; /**< Kind of the scope.                                       */
+        std::string key; /**< Name of the attribute which holds the scope.             */
+        bool is_decided; /**< Whether the consumer was already asked to accept the node. */
+    };
+
+    /**
+     * \brief               Opens the scope of the new node and reports it to the consumer.
+     *
+     * \param [in] a_key    Name of the attribute which holds the node.
+     *
+     * \return              False if consumer wants to stop the parsing, true otherwise.
+     */
+    // NOTE: Key is taken by value since it usually refers to the element of "m_scopes" which may be reallocated.
+    bool start_node(std::string a_key)
+    {
+        m_scopes.push_back({ scope_kind::node, std::move(a_key), false });
+        return m_consumer.enter_node(m_scopes.back().key);
+    }
+
+    /**
+     * \brief    Asks the consumer whether the current node should be kept, if it wasn't asked already.<br>
+     *           Scope of the rejected node becomes skipped, so nothing else inside of it is reported.
+     *
+     * \return   False if the consumer rejected the node, true otherwise.
+     */
+    bool accept_node()
+    {
+        assert(!m_scopes.empty() && m_scopes.back().kind == scope_kind::node);
+        scope& node_scope = m_scopes.back();
+        if (node_scope.is_decided)
+        {
+            return true;
+        }
+
+        node_scope.is_decided = true;
+        if constexpr (has_accept_node<Consumer>::value)
+        {
+            if (!m_consumer.accept_node())
+            {
+                node_scope.kind = scope_kind::skipped;
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * \brief               Reports scalar value to the consumer if it belongs to the node or event.
+     *
+     * \param [in] a_value  Scalar value from JSON.
+     *
+     * \return              False if consumer wants to stop the parsing, true otherwise.
+     */
+    bool value(const i3_tree_visitor::value& a_value)
+    {
+        if (m_scopes.empty())
+        {
+            return true;
+        }
+
+        switch (m_scopes.back().kind)
+        {
+            case scope_kind::event:
+            case scope_kind::node:   return m_consumer.field(std::string_view(), m_key, a_value);
+            case scope_kind::object: return m_consumer.field(m_scopes.back().key, m_key, a_value);
+            case scope_kind::array:  return m_consumer.field(std::string_view(), m_scopes.back().key, a_value);
+
+            default:
+                return true;
+        }
+    }
+
+    Consumer& m_consumer;        /**< Consumer of node-level events.           */
+    bool m_is_event;             /**< Whether the root of the message is event. */
+    std::vector<scope> m_scopes; /**< Currently opened JSON scopes.            */
+    std::string m_key;           /**< Last attribute name read in the scope.   */
+
+}; // class sax_tree_handler
+
+#endif // I3_JSON_PARSER_SAX_INL
@@ -0,0 +1,1000 @@
+/*
+    Copyright (C) 2019, Ivan Balević
+
+    This file is part of "i3-ipc++" library.
+
+    "i3-ipc++" is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    "i3-ipc++" is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with "i3-ipc++". If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+ * \file    i3_json_parser-streaming.cpp
+ *
+ * \brief   Defines member functions of "i3_json_parser" class that parse the data as a stream of SAX events.
+ */
+
+// Library headers.
+#include "i3_json_parser.hpp"
+#include "i3_message.hpp"
+#include "i3_containers.hpp"
+#include "i3_tree_visitor.hpp"
+#include "i3_pmr_containers.hpp"
+
+// Library templates.
+#include "i3_json_parser-sax.inl"
+
+// External library headers.
+#include <rapidjson/reader.h>
+#include <rapidjson/memorystream.h>
+
+// C++ headers.
+#include <string>
+#include <memory>
+#include <vector>
+#include <utility>
+#include <variant>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <memory_resource>
+
+// C headers.
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+
+namespace
+{
+    /**
+     * \brief               Converts numeric value read by streaming JSON parser into requested type.
+     *
+     * \tparam T            Requested numeric type.
+     *
+     * \param [in] a_value  Value read by streaming JSON parser.
+     *
+     * \return              Value converted to type T.
+     */
+    template<typename T>
+    T to_number(const i3_json_parser::json_value& a_value)
+    {
+        return std::visit([](const auto& a_number) -> T
+                          {
+                              using value_type = std::decay_t<decltype(a_number)>;
+                              if constexpr (std::is_arithmetic_v<value_type> && !std::is_same_v<value_type, bool>)
+                              {
+                                  return static_cast<T>(a_number);
+                              }
+                              else
+                              {
+                                  assert("Expected numeric value!" && 0);
+                                  return T();
+                              }
+                          },
+                          a_value);
+    }
+
+    /**
+     * \brief               Converts nullable numeric value read by streaming JSON parser into requested type.
+     *
+     * \tparam T            Requested numeric type.
+     *
+     * \param [in] a_value  Value read by streaming JSON parser.
+     *
+     * \return              Value converted to type T or std::nullopt if value is null.
+     */
+    template<typename T>
+    std::optional<T> to_optional_number(const i3_json_parser::json_value& a_value)
+    {
+        if (std::holds_alternative<std::nullptr_t>(a_value))
+        {
+            return std::nullopt;
+        }
+
+        return to_number<T>(a_value);
+    }
+
+    /**
+     * \brief                   Stores nullable string value read by streaming JSON parser.
+     *
+     * \tparam String           Type of the string which will store the value.
+     *
+     * \tparam Allocator        Type of the allocator used for the string.
+     *
+     * \param [out] a_string    Optional string which will store the value.
+     *
+     * \param [in] a_value      Value read by streaming JSON parser.
+     *
+     * \param [in] a_allocator  Allocator used for the string.
+     */
+    template<typename String, typename Allocator>
+    void set_optional_string(std::optional<String>& a_string,
+                             const i3_json_parser::json_value& a_value,
+                             const Allocator& a_allocator)
+    {
+        if (std::holds_alternative<std::nullptr_t>(a_value))
+        {
+            a_string.reset();
+            return;
+        }
+
+        assert(std::holds_alternative<std::string_view>(a_value));
+        a_string.emplace(std::get<std::string_view>(a_value), a_allocator);
+    }
+
+    /// \cond DO_NOT_DOCUMENT
+    // Allocators which should be used for strings owned by the containers.
+    std::allocator<char> string_allocator(const i3_containers::node&)
+    {
+        return std::allocator<char>();
+    }
+
+    std::allocator<char> string_allocator(const i3_containers::x11_window&)
+    {
+        return std::allocator<char>();
+    }
+
+    std::pmr::polymorphic_allocator<char> string_allocator(const i3_containers::pmr::node& a_node)
+    {
+        return a_node.get_allocator();
+    }
+
+    std::pmr::polymorphic_allocator<char> string_allocator(const i3_containers::pmr::x11_window& a_window)
+    {
+        return a_window.get_allocator();
+    }
+
+    // Creates empty window properties of the node, with the same allocator as the node.
+    void emplace_window_properties(i3_containers::node& a_node)
+    {
+        a_node.window_properties.emplace();
+    }
+
+    void emplace_window_properties(i3_containers::pmr::node& a_node)
+    {
+        a_node.window_properties.emplace(a_node.get_allocator());
+    }
+    /// \endcond
+
+    /**
+     * \brief               Stores one attribute of the rectangle.
+     *
+     * \param [out] a_rect  Rectangle which will store the attribute.
+     *
+     * \param [in] a_key    Name of the attribute.
+     *
+     * \param [in] a_value  Value of the attribute.
+     */
+    void set_rectangle_field(i3_containers::rectangle& a_rect,
+                             std::string_view a_key,
+                             const i3_json_parser::json_value& a_value)
+    {
+        if (a_key == "x")
+        {
+            a_rect.x = to_number<std::uint16_t>(a_value);
+        }
+        else if (a_key == "y")
+        {
+            a_rect.y = to_number<std::uint16_t>(a_value);
+        }
+        else if (a_key == "width")
+        {
+            a_rect.width = to_number<std::uint16_t>(a_value);
+        }
+        else if (a_key == "height")
+        {
+            a_rect.height = to_number<std::uint16_t>(a_value);
+        }
+    }
+
+    /**
+     * \brief                 Stores one attribute of the X11 window.
+     *
+     * \tparam Window         Type of the X11 window ("i3_containers::x11_window" or its "pmr" variant).
+     *
+     * \param [out] a_window  X11 window which will store the attribute.
+     *
+     * \param [in] a_key      Name of the attribute.
+     *
+     * \param [in] a_value    Value of the attribute.
+     */
+    template<typename Window>
+    void set_window_field(Window& a_window,
+                          std::string_view a_key,
+                          const i3_json_parser::json_value& a_value)
+    {
+        if (a_key == "class")
+        {
+            set_optional_string(a_window.window_class, a_value, string_allocator(a_window));
+        }
+        else if (a_key == "instance")
+        {
+            set_optional_string(a_window.window_instance, a_value, string_allocator(a_window));
+        }
+        else if (a_key == "window_role")
+        {
+            set_optional_string(a_window.window_role, a_value, string_allocator(a_window));
+        }
+        else if (a_key == "title")
+        {
+            set_optional_string(a_window.window_title, a_value, string_allocator(a_window));
+        }
+        else if (a_key == "transient_for")
+        {
+            a_window.transient_for = to_optional_number<std::uint64_t>(a_value);
+        }
+    }
+} // Unnamed namespace.
+
+class i3_json_parser::focused_node_finder
+{
+
+public:
+
+    /**
+     * \brief               Starts building the new node.
+     *
+     * \param [in] a_key    Name of the attribute which holds the node.
+     *
+     * \return              Always true, parsing should continue.
+     */
+    bool enter_node(std::string_view a_key)
+    {
+        m_nodes.push_back({ i3_containers::node(), a_key == "floating_nodes" });
+        return true;
+    }
+
+    /**
+     * \brief                       Stores the attribute into the node that is currently being built.
+     *
+     * \param [in] a_object         Name of the nested object which holds the attribute or empty for node itself.
+     *
+     * \param [in] a_key            Name of the attribute.
+     *
+     * \param [in] a_value          Value of the attribute.
+     *
+     * \return                      Always true, parsing should continue.
+     *
+     * \throws i3_ipc_unsupported   When value of some node property is unknown to "i3-ipc++" library.
+     */
+    bool field(std::string_view a_object, std::string_view a_key, const json_value& a_value)
+    {
+        assert(!m_nodes.empty());
+        i3_containers::node& node = m_nodes.back().node;
+        set_node_field(node, a_object, a_key, a_value);
+
+        // Once the focused node is found, remember its depth so that only its subtree is kept from now on.
+        if (!m_focused_depth && node.is_focused && a_object.empty() && a_key == "focused")
+        {
+            m_focused_depth = m_nodes.size();
+        }
+
+        return true;
+    }
+
+    /**
+     * \brief    Finishes the node that is currently being built.
+     *
+     * \return   False if the focused node is finished and parsing should stop, true otherwise.
+     */
+    bool leave_node()
+    {
+        assert(!m_nodes.empty());
+        const std::size_t depth = m_nodes.size();
+        node_entry entry = std::move(m_nodes.back());
+        m_nodes.pop_back();
+
+        // Nodes outside of the focused subtree are dropped.
+        if (!m_focused_depth)
+        {
+            return true;
+        }
+
+        // Focused node is complete, there is no need to read the rest of the tree.
+        // NOTE: Nodes outside of the focused subtree were never attached, so ancestors have no child nodes.
+        if (depth == *m_focused_depth)
+        {
+            i3_containers::focus_path path{ { }, std::move(entry.node) };
+            path.ancestors.reserve(m_nodes.size());
+            for (node_entry& ancestor : m_nodes)
+            {
+                path.ancestors.push_back(std::move(ancestor.node));
+            }
+
+            m_nodes.clear();
+            m_focused_node = std::move(path);
+            return false;
+        }
+
+        // Descendants of the focused node are attached to their parent.
+        i3_containers::node& parent = m_nodes.back().node;
+        (entry.is_floating ? parent.floating_nodes : parent.nodes).push_back(std::move(entry.node));
+        return true;
+    }
+
+    /**
+     * \brief    Takes the focused node and its ancestors out of the finder.
+     *
+     * \return   Info about the focused node and its ancestors or std::nullopt if it wasn't found.
+     */
+    std::optional<i3_containers::focus_path> take_focused_node()
+    {
+        return std::move(m_focused_node);
+    }
+
+private:
+
+    /**
+     * \brief   Structure used to represent one node that is being built.
+     */
+    struct node_entry
+    {
+        i3_containers::node node; /**< Node that is being built.                     */
+        bool is_floating;         /**< Whether the node is floating child or not.    */
+    };
+
+    std::vector<node_entry> m_nodes;                         /**< Chain of nodes from root to the current node. */
+    std::optional<std::size_t> m_focused_depth;              /**< Depth of the focused node, once it is found.  */
+    std::optional<i3_containers::focus_path> m_focused_node; /**< Focused node, once it is completely built.    */
+
+}; // class i3_json_parser::focused_node_finder
+
+class i3_json_parser::pmr_tree_builder
+{
+
+public:
+
+    /**
+     * \brief                   Constructs builder which allocates the whole tree from given memory resource.
+     *
+     * \param [in] a_resource   Memory resource used for every node of the tree.
+     */
+    explicit pmr_tree_builder(std::pmr::memory_resource* a_resource) : m_resource(a_resource), m_nodes(), m_tree()
+    {
+    }
+
+    /**
+     * \brief               Starts building the new node.
+     *
+     * \param [in] a_key    Name of the attribute which holds the node.
+     *
+     * \return              Always true, parsing should continue.
+     */
+    bool enter_node(std::string_view a_key)
+    {
+        m_nodes.push_back({ i3_containers::pmr::node(m_resource), a_key == "floating_nodes" });
+        return true;
+    }
+
+    /**
+     * \brief                       Stores the attribute into the node that is currently being built.
+     *
+     * \param [in] a_object         Name of the nested object which holds the attribute or empty for node itself.
+     *
+     * \param [in] a_key            Name of the attribute.
+     *
+     * \param [in] a_value          Value of the attribute.
+     *
+     * \return                      Always true, parsing should continue.
+     *
+     * \throws i3_ipc_unsupported   When value of some node property is unknown to "i3-ipc++" library.
+     */
+    bool field(std::string_view a_object, std::string_view a_key, const json_value& a_value)
+    {
+        assert(!m_nodes.empty());
+        set_node_field(m_nodes.back().node, a_object, a_key, a_value);
+        return true;
+    }
+
+    /**
+     * \brief    Finishes the node that is currently being built and attaches it to its parent.
+     *
+     * \return   Always true, parsing should continue.
+     */
+    bool leave_node()
+    {
+        assert(!m_nodes.empty());
+        node_entry entry = std::move(m_nodes.back());
+        m_nodes.pop_back();
+
+        if (m_nodes.empty())
+        {
+            m_tree.emplace(std::move(entry.node));
+            return true;
+        }
+
+        // Parent uses the same memory resource, so the node is moved without copying anything.
+        i3_containers::pmr::node& parent = m_nodes.back().node;
+        (entry.is_floating ? parent.floating_nodes : parent.nodes).push_back(std::move(entry.node));
+        return true;
+    }
+
+    /**
+     * \brief    Takes the built tree out of the builder.
+     *
+     * \return   Info about the root node in i3 node tree.
+     */
+    i3_containers::pmr::node take_tree()
+    {
+        assert(m_tree);
+        return std::move(*m_tree);
+    }
+
+private:
+
+    /**
+     * \brief   Structure used to represent one node that is being built.
+     */
+    struct node_entry
+    {
+        i3_containers::pmr::node node; /**< Node that is being built.                     */
+        bool is_floating;              /**< Whether the node is floating child or not.    */
+    };
+
+    std::pmr::memory_resource* m_resource;         /**< Memory resource used for every node.           */
+    std::vector<node_entry> m_nodes;               /**< Chain of nodes from root to the current node.  */
+    std::optional<i3_containers::pmr::node> m_tree; /**< Root node, once it is completely built.       */
+
+}; // class i3_json_parser::pmr_tree_builder
+
+class i3_json_parser::tree_builder
+{
+
+public:
+
+    /**
+     * \brief                 Constructs builder which keeps only the subtrees accepted by given filter.
+     *
+     * \param [in] a_filter    Predicate which decides whether the node and its subtree should be kept.
+     */
+    explicit tree_builder(const i3_ipc::tree_filter& a_filter) : m_filter(a_filter), m_nodes(), m_tree()
+    {
+    }
+
+    /**
+     * \brief               Starts building the new node.
+     *
+     * \param [in] a_key    Name of the attribute which holds the node.
+     *
+     * \return              Always true, parsing should continue.
+     */
+    bool enter_node(std::string_view a_key)
+    {
+        m_nodes.push_back({ i3_containers::node(), a_key == "floating_nodes" });
+        return true;
+    }
+
+    /**
+     * \brief                       Stores the attribute into the node that is currently being built.
+     *
+     * \param [in] a_object         Name of the nested object which holds the attribute or empty for node itself.
+     *
+     * \param [in] a_key            Name of the attribute.
+     *
+     * \param [in] a_value          Value of the attribute.
+     *
+     * \return                      Always true, parsing should continue.
+     *
+     * \throws i3_ipc_unsupported   When value of some node property is unknown to "i3-ipc++" library.
+     */
+    bool field(std::string_view a_object, std::string_view a_key, const json_value& a_value)
+    {
+        assert(!m_nodes.empty());
+        set_node_field(m_nodes.back().node, a_object, a_key, a_value);
+        return true;
+    }
+
+    /**
+     * \brief    Asks the filter whether the node that is currently being built should be kept.<br>
+     *           Rejected node is dropped, and the rest of its JSON is skipped without being reported.
+     *
+     * \return   True if the node is kept, false otherwise.
+     */
+    bool accept_node()
+    {
+        assert(!m_nodes.empty());
+        if (!m_filter || m_nodes.size() == 1)
+        {
+            return true;
+        }
+
+        const bool is_accepted = apply_filter(m_filter, m_nodes.back().node, m_nodes[m_nodes.size() - 2].node);
+        if (!is_accepted)
+        {
+            m_nodes.pop_back();
+        }
+
+        return is_accepted;
+    }
+
+    /**
+     * \brief    Finishes the node that is currently being built and attaches it to its parent.
+     *
+     * \return   Always true, parsing should continue.
+     */
+    bool leave_node()
+    {
+        assert(!m_nodes.empty());
+        node_entry entry = std::move(m_nodes.back());
+        m_nodes.pop_back();
+
+        if (m_nodes.empty())
+        {
+            m_tree.emplace(std::move(entry.node));
+            return true;
+        }
+
+        i3_containers::node& parent = m_nodes.back().node;
+        (entry.is_floating ? parent.floating_nodes : parent.nodes).push_back(std::move(entry.node));
+        return true;
+    }
+
+    /**
+     * \brief    Takes the built tree out of the builder.
+     *
+     * \return   Info about the root node in pruned i3 node tree.
+     */
+    i3_containers::node take_tree()
+    {
+        assert(m_tree);
+        return std::move(*m_tree);
+    }
+
+private:
+
+    /**
+     * \brief   Structure used to represent one node that is being built.
+     */
+    struct node_entry
+    {
+        i3_containers::node node; /**< Node that is being built.                     */
+        bool is_floating;         /**< Whether the node is floating child or not.    */
+    };
+
+    const i3_ipc::tree_filter& m_filter;       /**< Predicate which decides which subtrees are kept. */
+    std::vector<node_entry> m_nodes;           /**< Chain of nodes from root to the current node.    */
+    std::optional<i3_containers::node> m_tree; /**< Root node, once it is completely built.          */
+
+}; // class i3_json_parser::tree_builder
+
+class i3_json_parser::window_collector
+{
+
+public:
+
+    /**
+     * \brief               Starts collecting info about the new node.
+     *
+     * \param [in] a_key    Name of the attribute which holds the node.
+     *
+     * \return              Always true, parsing should continue.
+     */
+    bool enter_node(std::string_view)
+    {
+        m_nodes.push_back({ i3_containers::window_info(), std::nullopt, i3_containers::node_type::con, false });
+        return true;
+    }
+
+    /**
+     * \brief                       Stores the attribute of the node if it is needed for the window info.
+     *
+     * \param [in] a_object         Name of the nested object which holds the attribute or empty for node itself.
+     *
+     * \param [in] a_key            Name of the attribute.
+     *
+     * \param [in] a_value          Value of the attribute.
+     *
+     * \return                      Always true, parsing should continue.
+     *
+     * \throws i3_ipc_unsupported   When type of some node is unknown to "i3-ipc++" library.
+     */
+    bool field(std::string_view a_object, std::string_view a_key, const json_value& a_value)
+    {
+        assert(!m_nodes.empty());
+        node_entry& entry = m_nodes.back();
+        i3_containers::window_info& info = entry.info;
+        if (a_object.empty())
+        {
+            if (a_key == "id")
+            {
+                info.id = to_number<std::uint64_t>(a_value);
+            }
+            else if (a_key == "type")
+            {
+                entry.type = to_node_type(std::get<std::string_view>(a_value));
+            }
+            else if (a_key == "name")
+            {
+                set_optional_string(entry.name, a_value, std::allocator<char>());
+            }
+            else if (a_key == "window")
+            {
+                const std::optional<std::uint64_t> window = to_optional_number<std::uint64_t>(a_value);
+                entry.has_window = window.has_value();
+                info.window = window.value_or(0);
+            }
+            else if (a_key == "focused")
+            {
+                info.is_focused = std::get<bool>(a_value);
+            }
+            else if (a_key == "urgent")
+            {
+                info.is_urgent = std::get<bool>(a_value);
+            }
+        }
+        else if (a_object == "rect")
+        {
+            set_rectangle_field(info.rect, a_key, a_value);
+        }
+        else if (a_object == "window_properties")
+        {
+            if (a_key == "class")
+            {
+                set_optional_string(info.window_class, a_value, std::allocator<char>());
+            }
+            else if (a_key == "instance")
+            {
+                set_optional_string(info.window_instance, a_value, std::allocator<char>());
+            }
+            else if (a_key == "title")
+            {
+                set_optional_string(info.window_title, a_value, std::allocator<char>());
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * \brief    Finishes the node and adds it to the list if it is a window.
+     *
+     * \return   Always true, parsing should continue.
+     */
+    bool leave_node()
+    {
+        assert(!m_nodes.empty());
+        node_entry entry = std::move(m_nodes.back());
+        m_nodes.pop_back();
+        if (!entry.has_window)
+        {
+            return true;
+        }
+
+        // NOTE: Workspace and output are the ancestors of the window, which are still on the chain.
+        for (const node_entry& ancestor : m_nodes)
+        {
+            if (ancestor.type == i3_containers::node_type::output)
+            {
+                entry.info.output = ancestor.name.value_or("");
+            }
+            else if (ancestor.type == i3_containers::node_type::workspace)
+            {
+                entry.info.workspace = ancestor.name;
+            }
+        }
+
+        m_windows.push_back(std::move(entry.info));
+        return true;
+    }
+
+    /**
+     * \brief    Takes the collected windows out of the collector.
+     *
+     * \return   Info about every window in the tree.
+     */
+    std::vector<i3_containers::window_info> take_windows()
+    {
+        return std::move(m_windows);
+    }
+
+private:
+
+    /**
+     * \brief   Structure used to represent one node on the chain from the root to the current node.
+     */
+    struct node_entry
+    {
+        i3_containers::window_info info; /**< Info about the node, used if it is a window.   */
+        std::optional<std::string> name; /**< Name of the node, used if it is an ancestor.   */
+        i3_containers::node_type type;   /**< Type of the node.                              */
+        bool has_window;                 /**< Whether the node is a container of X11 window. */
+    };
+
+    std::vector<node_entry> m_nodes;                   /**< Chain of nodes from root to the current node. */
+    std::vector<i3_containers::window_info> m_windows; /**< Windows collected so far.                     */
+
+}; // class i3_json_parser::window_collector
+
+class i3_json_parser::window_event_key_reader
+{
+
+public:
+
+    /**
+     * \brief   Constructs reader which hasn't read anything yet.
+     */
+    window_event_key_reader() : m_depth(0), m_is_coalescable(true), m_change(), m_id()
+    {
+    }
+
+    /**
+     * \brief               Tracks the depth of nodes, since only the ID of the top-level container is needed.
+     *
+     * \param [in] a_key    Name of the attribute which holds the node.
+     *
+     * \return              Always true, parsing should continue.
+     */
+    bool enter_node(std::string_view)
+    {
+        ++m_depth;
+        return true;
+    }
+
+    /**
+     * \brief                  Stores the change of the event and the ID of its container.
+     *
+     * \param [in] a_object    Name of the nested object which holds the attribute or empty for node itself.
+     *
+     * \param [in] a_key       Name of the attribute.
+     *
+     * \param [in] a_value     Value of the attribute.
+     *
+     * \return                 False once the key is complete or the change can't be coalesced, true otherwise.
+     */
+    bool field(std::string_view a_object, std::string_view a_key, const json_value& a_value)
+    {
+        if (!a_object.empty())
+        {
+            return true;
+        }
+
+        if (m_depth == 0 && a_key == "change")
+        {
+            const std::string_view* change = std::get_if<std::string_view>(&a_value);
+            if (change && *change == "title")
+            {
+                m_change = i3_containers::window_change::title;
+            }
+            else if (change && *change == "move")
+            {
+                m_change = i3_containers::window_change::move;
+            }
+            else
+            {
+                m_is_coalescable = false;
+                return false;
+            }
+        }
+        else if (m_depth == 1 && a_key == "id")
+        {
+            m_id = to_number<std::uint64_t>(a_value);
+        }
+
+        return !m_change || !m_id;
+    }
+
+    /**
+     * \brief    Tracks the depth of nodes.
+     *
+     * \return   Always true, parsing should continue.
+     */
+    bool leave_node()
+    {
+        --m_depth;
+        return true;
+    }
+
+    /**
+     * \brief    Returns the key of the event.
+     *
+     * \return   Change and container ID, or std::nullopt if event can't be coalesced.
+     */
+    std::optional<std::pair<i3_containers::window_change, std::uint64_t>> get_key() const
+    {
+        if (!m_is_coalescable || !m_change || !m_id)
+        {
+            return std::nullopt;
+        }
+
+        return std::make_pair(*m_change, *m_id);
+    }
+
+private:
+
+    std::size_t m_depth;                                  /**< Depth of the current node, 0 outside of nodes. */
+    bool m_is_coalescable;                                /**< Whether the change can be coalesced.           */
+    std::optional<i3_containers::window_change> m_change; /**< Change of the event, once it is read.          */
+    std::optional<std::uint64_t> m_id;                    /**< ID of the container, once it is read.          */
+
+}; // class i3_json_parser::window_event_key_reader
+
+template<typename Node>
+void i3_json_parser::set_node_field(Node& a_node,
+                                    std::string_view a_object,
+                                    std::string_view a_key,
+                                    const json_value& a_value)
+{
+    if (a_object.empty())
+    {
+        if (a_key == "id")
+        {
+            a_node.id = to_number<std::uint64_t>(a_value);
+        }
+        else if (a_key == "name")
+        {
+            set_optional_string(a_node.name, a_value, string_allocator(a_node));
+        }
+        else if (a_key == "type")
+        {
+            a_node.type = to_node_type(std::get<std::string_view>(a_value));
+        }
+        else if (a_key == "border")
+        {
+            a_node.border = to_border_style(std::get<std::string_view>(a_value));
+        }
+        else if (a_key == "current_border_width")
+        {
+            const auto width = to_number<std::int64_t>(a_value);
+            a_node.current_border_width = width <= 0 ? std::nullopt
+                                                     : std::make_optional(static_cast<std::uint8_t>(width));
+        }
+        else if (a_key == "layout")
+        {
+            a_node.layout = to_node_layout(std::get<std::string_view>(a_value));
+        }
+        else if (a_key == "percent")
+        {
+            a_node.percent = to_optional_number<float>(a_value);
+        }
+        else if (a_key == "window")
+        {
+            a_node.window = to_optional_number<std::uint64_t>(a_value);
+        }
+        else if (a_key == "urgent")
+        {
+            a_node.is_urgent = std::get<bool>(a_value);
+        }
+        else if (a_key == "focused")
+        {
+            a_node.is_focused = std::get<bool>(a_value);
+        }
+        else if (a_key == "fullscreen_mode")
+        {
+            a_node.fullscreen_mode = static_cast<i3_containers::fullscreen_mode_type>(to_number<std::uint8_t>(a_value));
+        }
+        else if (a_key == "marks")
+        {
+            a_node.marks.emplace_back(std::get<std::string_view>(a_value));
+        }
+        else if (a_key == "focus")
+        {
+            a_node.focus.push_back(to_number<std::uint64_t>(a_value));
+        }
+    }
+    else if (a_object == "rect")
+    {
+        set_rectangle_field(a_node.rect, a_key, a_value);
+    }
+    else if (a_object == "window_rect")
+    {
+        set_rectangle_field(a_node.window_rect, a_key, a_value);
+    }
+    else if (a_object == "deco_rect")
+    {
+        set_rectangle_field(a_node.deco_rect, a_key, a_value);
+    }
+    else if (a_object == "geometry")
+    {
+        set_rectangle_field(a_node.geometry, a_key, a_value);
+    }
+    else if (a_object == "window_properties")
+    {
+        if (!a_node.window_properties)
+        {
+            emplace_window_properties(a_node);
+        }
+
+        set_window_field(*a_node.window_properties, a_key, a_value);
+    }
+}
+
+std::optional<i3_containers::focus_path> i3_json_parser::parse_focused_node(i3_message::payload_stream& a_stream)
+{
+    focused_node_finder finder;
+    sax_tree_handler<focused_node_finder> handler(finder);
+
+    // Parsing is terminated by the finder as soon as the focused node is built.
+    [[maybe_unused]] const rapidjson::ParseResult result = rapidjson::Reader().Parse(a_stream, handler);
+    assert(result || result.Code() == rapidjson::kParseErrorTermination);
+
+    return finder.take_focused_node();
+}
+
+i3_containers::pmr::node i3_json_parser::parse_tree(i3_message::payload_stream& a_stream,
+                                                    std::pmr::memory_resource* a_resource)
+{
+    pmr_tree_builder builder(a_resource);
+    sax_tree_handler<pmr_tree_builder> handler(builder);
+
+    [[maybe_unused]] const rapidjson::ParseResult result = rapidjson::Reader().Parse(a_stream, handler);
+    assert(result);
+
+    return builder.take_tree();
+}
+
+i3_containers::node i3_json_parser::parse_filtered_tree(i3_message::payload_stream& a_stream,
+                                                        const i3_ipc::tree_filter& a_filter)
+{
+    tree_builder builder(a_filter);
+    sax_tree_handler<tree_builder> handler(builder);
+
+    [[maybe_unused]] const rapidjson::ParseResult result = rapidjson::Reader().Parse(a_stream, handler);
+    assert(result);
+
+    return builder.take_tree();
+}
+
+i3_containers::node i3_json_parser::parse_filtered_tree(std::string_view a_json, const i3_ipc::tree_filter& a_filter)
+{
+    tree_builder builder(a_filter);
+    sax_tree_handler<tree_builder> handler(builder);
+    rapidjson::MemoryStream stream(a_json.data(), a_json.size());
+
+    [[maybe_unused]] const rapidjson::ParseResult result = rapidjson::Reader().Parse(stream, handler);
+    assert(result);
+
+    return builder.take_tree();
+}
+
+std::optional<std::pair<i3_containers::window_change, std::uint64_t>>
+i3_json_parser::parse_window_event_key(std::string_view a_json)
+{
+    window_event_key_reader reader;
+    sax_tree_handler<window_event_key_reader> handler(reader, true);
+    rapidjson::MemoryStream stream(a_json.data(), a_json.size());
+
+    // Parsing is terminated by the reader as soon as the key is known.
+    [[maybe_unused]] const rapidjson::ParseResult result = rapidjson::Reader().Parse(stream, handler);
+    assert(result || result.Code() == rapidjson::kParseErrorTermination);
+
+    return reader.get_key();
+}
+
+std::vector<i3_containers::window_info> i3_json_parser::parse_windows(i3_message::payload_stream& a_stream)
+{
+    window_collector collector;
+    sax_tree_handler<window_collector> handler(collector);
+
+    [[maybe_unused]] const rapidjson::ParseResult result = rapidjson::Reader().Parse(a_stream, handler);
+    assert(result);
+
+    return collector.take_windows();
+}
+
+void i3_json_parser::visit_tree(i3_message::payload_stream& a_stream, i3_tree_visitor& a_visitor)
+{
+    sax_tree_handler<i3_tree_visitor> handler(a_visitor);
+
+    // Visitor is allowed to stop the walk at any point.
+    [[maybe_unused]] const rapidjson::ParseResult result = rapidjson::Reader().Parse(a_stream, handler);
+    assert(result || result.Code() == rapidjson::kParseErrorTermination);
+}
+
+void i3_json_parser::visit_event(std::string_view a_json, i3_tree_visitor& a_visitor)
+{
+    sax_tree_handler<i3_tree_visitor> handler(a_visitor, true);
+    rapidjson::MemoryStream stream(a_json.data(), a_json.size());
+
+    // Visitor is allowed to stop the walk at any point.
+    [[maybe_unused]] const rapidjson::ParseResult result = rapidjson::Reader().Parse(stream, handler);
+    assert(result || result.Code() == rapidjson::kParseErrorTermination);
+}
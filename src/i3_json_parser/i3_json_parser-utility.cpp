@@ -25,161 +25,60 @@
 
 // Library headers.
 #include "i3_json_parser.hpp"
+#include "i3_json_backend.hpp"
+#include "i3_message.hpp"
 #include "i3_containers.hpp"
+#include "i3_compact_node.hpp"
+#include "i3_string_pool.hpp"
 #include "i3_ipc_unsupported.hpp"
 
 // Library templates.
 #include "i3_json_parser-utility.inl"
 
-// External library headers.
-#include <rapidjson/document.h>
-
 // C++ headers.
+#include <memory>
 #include <string>
+#include <vector>
+#include <utility>
 #include <optional>
 #include <string_view>
 
+// C headers.
+#include <cstddef>
+#include <cstdint>
+
 namespace
 {
     /**
-     * \brief                       Extracts info about i3 node type from JSON object.
-     *
-     * \param [in] a_json_object    JSON object.
+     * \brief                      Extracts info about window properties from JSON object.<br>
+     *                             Strings that already exist in "a_window" are overwritten, keeping their capacity.
      *
-     * \return                      Extracted node type from the "a_json_object".
+     * \param [in] a_json_object   JSON object.
      *
-     * \throws i3_ipc_unsupported   When value of extracted node type is unknown to "i3-ipc++" library.
+     * \param [out] a_window       Window properties which will be overwritten with the ones from "a_json_object".
      */
-    i3_containers::node_type extract_node_type(const rapidjson::Value& a_json_object)
+    void extract_window_properties(i3_json_backend::value a_json_object,
+                                   std::optional<i3_containers::x11_window>& a_window)
     {
-        const std::string_view type = get_attribute_value<const char*>(a_json_object, "type");
-        if (type == "root")
-        {
-            return i3_containers::node_type::root;
-        }
-        else if (type == "output")
-        {
-            return i3_containers::node_type::output;
-        }
-        else if (type == "con")
-        {
-            return i3_containers::node_type::con;
-        }
-        else if (type == "floating_con")
+        assert(i3_json_backend::is_object(a_json_object));
+        if (!i3_json_backend::has_member(a_json_object, "window_properties")
+            || i3_json_backend::is_null(i3_json_backend::member(a_json_object, "window_properties")))
         {
-            return i3_containers::node_type::floating_con;
+            a_window.reset();
+            return;
         }
-        else if (type == "workspace")
-        {
-            return i3_containers::node_type::workspace;
-        }
-        else if (type == "dockarea")
-        {
-            return i3_containers::node_type::dockarea;
-        }
-        else
-        {
-            throw i3_ipc_unsupported("Unknown node type: \"" + std::string(type) + "\"");
-        }
-    }
 
-    /**
-     * \brief                       Extracts info about border style from JSON object.
-     *
-     * \param [in] a_json_object    JSON object.
-     *
-     * \return                      Extracted border style from the "a_json_object".
-     *
-     * \throws i3_ipc_unsupported   When value of extracted border style is unknown to "i3-ipc++" library.
-     */
-    i3_containers::border_style extract_border_style(const rapidjson::Value& a_json_object)
-    {
-        const std::string_view border_style = get_attribute_value<const char*>(a_json_object, "border");
-        if (border_style == "normal")
-        {
-            return i3_containers::border_style::normal;
-        }
-        else if (border_style == "none")
-        {
-            return i3_containers::border_style::none;
-        }
-        else if (border_style == "pixel")
-        {
-            return i3_containers::border_style::pixel;
-        }
-        else
-        {
-            throw i3_ipc_unsupported("Unknown border style: \"" + std::string(border_style) + "\"");
-        }
-    }
+        i3_json_backend::value window_object = i3_json_backend::member(a_json_object, "window_properties");
 
-    /**
-     * \brief                       Extracts info about node layout from JSON object.
-     *
-     * \param [in] a_json_object    JSON object.
-     *
-     * \return                      Extracted node layout from the "a_json_object".
-     *
-     * \throws i3_ipc_unsupported   When value of extracted node layout is unknown to "i3-ipc++" library.
-     */
-    i3_containers::node_layout extract_node_layout(const rapidjson::Value& a_json_object)
-    {
-        const std::string_view layout = get_attribute_value<const char*>(a_json_object, "layout");
-        if (layout == "splith")
-        {
-            return i3_containers::node_layout::splith;
-        }
-        else if (layout == "splitv")
-        {
-            return i3_containers::node_layout::splitv;
-        }
-        else if (layout == "stacked")
-        {
-            return i3_containers::node_layout::stacked;
-        }
-        else if (layout == "tabbed")
-        {
-            return i3_containers::node_layout::tabbed;
-        }
-        else if (layout == "dockarea")
-        {
-            return i3_containers::node_layout::dockarea;
-        }
-        else if (layout == "output")
-        {
-            return i3_containers::node_layout::output;
-        }
-        else
-        {
-            throw i3_ipc_unsupported("Unknown node layout: \"" + std::string(layout) + "\"");
-        }
-    }
-
-    /**
-     * \brief                      Extracts info about window properties from JSON object.
-     *
-     * \param [in] a_json_object   JSON object.
-     *
-     * \return                     Extracted window properties from the "a_json_object".
-     */
-    std::optional<i3_containers::x11_window> extract_window_properties(const rapidjson::Value& a_json_object)
-    {
-        assert(a_json_object.IsObject());
-        if (!a_json_object.HasMember("window_properties") || a_json_object["window_properties"].IsNull())
+        if (!a_window)
         {
-            return std::nullopt;
+            a_window.emplace();
         }
-
-        const rapidjson::Value& window_object = a_json_object["window_properties"];
-
-        i3_containers::x11_window window;
-        window.window_class = get_attribute_value<std::optional<const char*>>(window_object, "class");
-        window.window_instance = get_attribute_value<std::optional<const char*>>(window_object, "instance");
-        window.window_role = get_attribute_value<std::optional<const char*>>(window_object, "window_role");
-        window.window_title = get_attribute_value<std::optional<const char*>>(window_object, "title");
-        window.transient_for = get_attribute_value<std::optional<std::uint64_t>>(window_object, "transient_for");
-
-        return window;
+        a_window->window_class = get_attribute_value<std::optional<const char*>>(window_object, "class");
+        a_window->window_instance = get_attribute_value<std::optional<const char*>>(window_object, "instance");
+        a_window->window_role = get_attribute_value<std::optional<const char*>>(window_object, "window_role");
+        a_window->window_title = get_attribute_value<std::optional<const char*>>(window_object, "title");
+        a_window->transient_for = get_attribute_value<std::optional<std::uint64_t>>(window_object, "transient_for");
     }
 
     /**
@@ -189,10 +88,11 @@ namespace
      *
      * \return                     Extracted fullscreen_mode.
      */
-    i3_containers::fullscreen_mode_type extract_fullscreen_mode(const rapidjson::Value& a_json_object)
+    i3_containers::fullscreen_mode_type extract_fullscreen_mode(i3_json_backend::value a_json_object)
     {
-        assert(a_json_object.IsObject());
-        assert(a_json_object.HasMember("fullscreen_mode") && a_json_object["fullscreen_mode"].IsUint());
+        assert(i3_json_backend::is_object(a_json_object));
+        assert(i3_json_backend::has_member(a_json_object, "fullscreen_mode")
+               && i3_json_backend::is<unsigned>(i3_json_backend::member(a_json_object, "fullscreen_mode")));
 
         const auto val = get_attribute_value<std::uint8_t>(a_json_object, "fullscreen_mode");
         return static_cast<i3_containers::fullscreen_mode_type>(val);
@@ -200,48 +100,139 @@ namespace
 
 
     /**
-     * \brief                      Extracts the marks of the node from the JSON object.
+     * \brief                      Extracts the marks of the node from the JSON object.<br>
+     *                             Strings that already exist in "a_marks" are overwritten, keeping their capacity.
      *
      * \param [in] a_json_object   JSON object.
      *
-     * \return                     Extracted vector of marks
+     * \param [out] a_marks        Vector of marks which will be overwritten with the ones from "a_json_object".
      */
-    std::vector<std::string> extract_marks(const rapidjson::Value& a_json_object)
+    void extract_marks(i3_json_backend::value a_json_object, std::vector<std::string>& a_marks)
     {
-        assert(a_json_object.IsObject());
-        if (!a_json_object.HasMember("marks") || !a_json_object["marks"].IsArray())
+        assert(i3_json_backend::is_object(a_json_object));
+        if (!i3_json_backend::has_member(a_json_object, "marks")
+            || !i3_json_backend::is_array(i3_json_backend::member(a_json_object, "marks")))
         {
-            return { };
+            a_marks.clear();
+            return;
         }
 
-        auto& json_marks = a_json_object["marks"];
-        std::vector<std::string> marks{};
-        marks.reserve(json_marks.GetArray().Size());
-        for (const auto& mark : json_marks.GetArray())
+        i3_json_backend::value json_marks = i3_json_backend::member(a_json_object, "marks");
+        a_marks.resize(i3_json_backend::size(json_marks));
+        std::size_t i = 0;
+        for (const auto& mark : i3_json_backend::elements(json_marks))
         {
-            assert(mark.IsString());
-            marks.push_back(mark.GetString());
+            assert(i3_json_backend::is_string(mark));
+            a_marks[i++] = i3_json_backend::get<const char*>(mark);
         }
-
-        return marks;
     }
 } // Unnamed namespace.
 
-rapidjson::Document i3_json_parser::parse_json(const char* a_json_string)
+i3_containers::node_type i3_json_parser::to_node_type(std::string_view a_type)
 {
-    rapidjson::Document document;
-    document.Parse(a_json_string);
-    assert(!document.HasParseError());
+    if (a_type == "root")
+    {
+        return i3_containers::node_type::root;
+    }
+    else if (a_type == "output")
+    {
+        return i3_containers::node_type::output;
+    }
+    else if (a_type == "con")
+    {
+        return i3_containers::node_type::con;
+    }
+    else if (a_type == "floating_con")
+    {
+        return i3_containers::node_type::floating_con;
+    }
+    else if (a_type == "workspace")
+    {
+        return i3_containers::node_type::workspace;
+    }
+    else if (a_type == "dockarea")
+    {
+        return i3_containers::node_type::dockarea;
+    }
+    else
+    {
+        throw i3_ipc_unsupported("Unknown node type: \"" + std::string(a_type) + "\"");
+    }
+}
+
+i3_containers::border_style i3_json_parser::to_border_style(std::string_view a_border_style)
+{
+    if (a_border_style == "normal")
+    {
+        return i3_containers::border_style::normal;
+    }
+    else if (a_border_style == "none")
+    {
+        return i3_containers::border_style::none;
+    }
+    else if (a_border_style == "pixel")
+    {
+        return i3_containers::border_style::pixel;
+    }
+    else
+    {
+        throw i3_ipc_unsupported("Unknown border style: \"" + std::string(a_border_style) + "\"");
+    }
+}
+
+i3_containers::node_layout i3_json_parser::to_node_layout(std::string_view a_layout)
+{
+    if (a_layout == "splith")
+    {
+        return i3_containers::node_layout::splith;
+    }
+    else if (a_layout == "splitv")
+    {
+        return i3_containers::node_layout::splitv;
+    }
+    else if (a_layout == "stacked")
+    {
+        return i3_containers::node_layout::stacked;
+    }
+    else if (a_layout == "tabbed")
+    {
+        return i3_containers::node_layout::tabbed;
+    }
+    else if (a_layout == "dockarea")
+    {
+        return i3_containers::node_layout::dockarea;
+    }
+    else if (a_layout == "output")
+    {
+        return i3_containers::node_layout::output;
+    }
+    else
+    {
+        throw i3_ipc_unsupported("Unknown node layout: \"" + std::string(a_layout) + "\"");
+    }
+}
+
+i3_json_backend::document i3_json_parser::parse_json(const char* a_json_string)
+{
+    return i3_json_backend::parse(a_json_string);
+}
 
-    return document;
+i3_json_backend::document i3_json_parser::parse_json(std::string_view a_json)
+{
+    return i3_json_backend::parse(a_json);
+}
+
+i3_json_backend::document i3_json_parser::parse_json(i3_message::payload_stream& a_stream)
+{
+    return i3_json_backend::parse(a_stream);
 }
 
-i3_containers::rectangle i3_json_parser::extract_rectangle(const rapidjson::Value& a_json_object,
+i3_containers::rectangle i3_json_parser::extract_rectangle(i3_json_backend::value a_json_object,
                                                            const char* a_attribute)
 {
-    assert(a_json_object.IsObject());
-    assert(a_json_object.HasMember(a_attribute));
-    const rapidjson::Value& rectangle_object = a_json_object[a_attribute];
+    assert(i3_json_backend::is_object(a_json_object));
+    assert(i3_json_backend::has_member(a_json_object, a_attribute));
+    i3_json_backend::value rectangle_object = i3_json_backend::member(a_json_object, a_attribute);
 
     i3_containers::rectangle rectangle;
     rectangle.x      = get_attribute_value<std::uint16_t>(rectangle_object, "x");
@@ -252,53 +243,138 @@ i3_containers::rectangle i3_json_parser::extract_rectangle(const rapidjson::Valu
     return rectangle;
 }
 
-i3_containers::node i3_json_parser::extract_tree(const rapidjson::Value& a_json_object)
+i3_containers::node i3_json_parser::extract_node(i3_json_backend::value a_json_object)
 {
-    // Extract trivial node info.
     i3_containers::node node;
-    node.id = get_attribute_value<std::uint64_t>(a_json_object, "id");
-    node.name = get_attribute_value<std::optional<const char*>>(a_json_object, "name");
-    node.type = extract_node_type(a_json_object);
-    node.border = extract_border_style(a_json_object);
+    extract_node(a_json_object, node);
+    return node;
+}
+
+void i3_json_parser::extract_node(i3_json_backend::value a_json_object, i3_containers::node& a_node)
+{
+    // Extract trivial node info.
+    // NOTE: Optional strings are assigned from optional C strings, so existing strings keep their capacity.
+    a_node.id = get_attribute_value<std::uint64_t>(a_json_object, "id");
+    a_node.name = get_attribute_value<std::optional<const char*>>(a_json_object, "name");
+    a_node.type = to_node_type(get_attribute_value<const char*>(a_json_object, "type"));
+    a_node.border = to_border_style(get_attribute_value<const char*>(a_json_object, "border"));
     const std::int8_t tmp = get_attribute_value<std::int8_t>(a_json_object, "current_border_width");
-    node.current_border_width = tmp <= 0 ? std::nullopt : std::make_optional(static_cast<std::uint8_t>(tmp));
-    node.layout = extract_node_layout(a_json_object);
-    node.percent = get_attribute_value<std::optional<float>>(a_json_object, "percent");
-    node.rect = extract_rectangle(a_json_object, "rect");
-    node.window_rect = extract_rectangle(a_json_object, "window_rect");
-    node.deco_rect = extract_rectangle(a_json_object, "deco_rect");
-    node.geometry = extract_rectangle(a_json_object, "geometry");
-    node.window = get_attribute_value<std::optional<std::uint64_t>>(a_json_object, "window");
-    node.window_properties = extract_window_properties(a_json_object);
-    node.is_urgent = get_attribute_value<bool>(a_json_object, "urgent");
-    node.is_focused = get_attribute_value<bool>(a_json_object, "focused");
-    node.fullscreen_mode = extract_fullscreen_mode(a_json_object);
-    node.marks = extract_marks(a_json_object);
+    a_node.current_border_width = tmp <= 0 ? std::nullopt : std::make_optional(static_cast<std::uint8_t>(tmp));
+    a_node.layout = to_node_layout(get_attribute_value<const char*>(a_json_object, "layout"));
+    a_node.percent = get_attribute_value<std::optional<float>>(a_json_object, "percent");
+    a_node.rect = extract_rectangle(a_json_object, "rect");
+    a_node.window_rect = extract_rectangle(a_json_object, "window_rect");
+    a_node.deco_rect = extract_rectangle(a_json_object, "deco_rect");
+    a_node.geometry = extract_rectangle(a_json_object, "geometry");
+    a_node.window = get_attribute_value<std::optional<std::uint64_t>>(a_json_object, "window");
+    extract_window_properties(a_json_object, a_node.window_properties);
+    a_node.is_urgent = get_attribute_value<bool>(a_json_object, "urgent");
+    a_node.is_focused = get_attribute_value<bool>(a_json_object, "focused");
+    a_node.fullscreen_mode = extract_fullscreen_mode(a_json_object);
+    extract_marks(a_json_object, a_node.marks);
 
     // Extract list of node IDs that have focus.
-    assert(a_json_object.HasMember("focus"));
-    assert(a_json_object["focus"].IsArray());
-    for (const auto& node_ID : a_json_object["focus"].GetArray())
+    assert(i3_json_backend::has_member(a_json_object, "focus"));
+    i3_json_backend::value focus = i3_json_backend::member(a_json_object, "focus");
+    assert(i3_json_backend::is_array(focus));
+    a_node.focus.clear();
+    for (const auto& node_ID : i3_json_backend::elements(focus))
     {
-        assert(node_ID.IsUint64());
-        node.focus.push_back(node_ID.GetUint64());
+        assert(i3_json_backend::is<std::uint64_t>(node_ID));
+        a_node.focus.push_back(i3_json_backend::get<std::uint64_t>(node_ID));
     }
+}
+
+i3_containers::node i3_json_parser::extract_tree(i3_json_backend::value a_json_object)
+{
+    i3_containers::node node = extract_node(a_json_object);
 
     // Recursively call this function to extract info about tilling child nodes.
-    assert(a_json_object.HasMember("nodes"));
-    assert(a_json_object["nodes"].IsArray());
-    for (const auto& node_object : a_json_object["nodes"].GetArray())
+    assert(i3_json_backend::has_member(a_json_object, "nodes"));
+    i3_json_backend::value node_objects = i3_json_backend::member(a_json_object, "nodes");
+    assert(i3_json_backend::is_array(node_objects));
+    for (const auto& node_object : i3_json_backend::elements(node_objects))
     {
         node.nodes.push_back(extract_tree(node_object));
     }
 
     // Recursively call this function to extract info about floating child nodes.
-    assert(a_json_object.HasMember("floating_nodes"));
-    assert(a_json_object["floating_nodes"].IsArray());
-    for (const auto& node_object : a_json_object["floating_nodes"].GetArray())
+    assert(i3_json_backend::has_member(a_json_object, "floating_nodes"));
+    i3_json_backend::value floating_node_objects = i3_json_backend::member(a_json_object, "floating_nodes");
+    assert(i3_json_backend::is_array(floating_node_objects));
+    for (const auto& node_object : i3_json_backend::elements(floating_node_objects))
     {
         node.floating_nodes.push_back(extract_tree(node_object));
     }
 
     return node;
 }
+
+void i3_json_parser::extract_tree(i3_json_backend::value a_json_object, i3_containers::node& a_tree)
+{
+    extract_node(a_json_object, a_tree);
+
+    // Child nodes are matched by position, so every child node that already exists is overwritten in place.
+    const auto extract_child_nodes = [&](const char* a_attribute, std::vector<i3_containers::node>& a_child_nodes)
+    {
+        assert(i3_json_backend::has_member(a_json_object, a_attribute));
+        i3_json_backend::value node_objects = i3_json_backend::member(a_json_object, a_attribute);
+        assert(i3_json_backend::is_array(node_objects));
+
+        a_child_nodes.resize(i3_json_backend::size(node_objects));
+        std::size_t i = 0;
+        for (const auto& node_object : i3_json_backend::elements(node_objects))
+        {
+            extract_tree(node_object, a_child_nodes[i++]);
+        }
+    };
+
+    extract_child_nodes("nodes", a_tree.nodes);
+    extract_child_nodes("floating_nodes", a_tree.floating_nodes);
+}
+
+bool i3_json_parser::apply_filter(const i3_ipc::tree_filter& a_filter,
+                                  i3_containers::node& a_node,
+                                  i3_containers::node& a_parent)
+{
+    // NOTE: If the filter throws, the whole tree is dropped anyway, so child nodes don't have to be put back.
+    std::vector<i3_containers::node> nodes = std::move(a_node.nodes);
+    std::vector<i3_containers::node> floating_nodes = std::move(a_node.floating_nodes);
+    std::vector<i3_containers::node> parent_nodes = std::move(a_parent.nodes);
+    std::vector<i3_containers::node> parent_floating_nodes = std::move(a_parent.floating_nodes);
+
+    const bool is_accepted = a_filter(std::as_const(a_node), std::as_const(a_parent));
+
+    a_node.nodes = std::move(nodes);
+    a_node.floating_nodes = std::move(floating_nodes);
+    a_parent.nodes = std::move(parent_nodes);
+    a_parent.floating_nodes = std::move(parent_floating_nodes);
+    return is_accepted;
+}
+
+i3_containers::compact_node i3_json_parser::extract_compact_tree(i3_json_backend::value a_json_object,
+                                                                 const string_pool_pointer& a_pool,
+                                                                 i3_containers::node& a_scratch)
+{
+    // NOTE: Scratch node never has child nodes, since "extract_node" doesn't extract them.
+    extract_node(a_json_object, a_scratch);
+    i3_containers::compact_node compact_node(std::as_const(a_scratch), a_pool);
+
+    const auto extract_child_nodes = [&](const char* a_attribute, std::vector<i3_containers::compact_node>& a_nodes)
+    {
+        assert(i3_json_backend::has_member(a_json_object, a_attribute));
+        i3_json_backend::value node_objects = i3_json_backend::member(a_json_object, a_attribute);
+        assert(i3_json_backend::is_array(node_objects));
+
+        a_nodes.reserve(i3_json_backend::size(node_objects));
+        for (const auto& node_object : i3_json_backend::elements(node_objects))
+        {
+            a_nodes.push_back(extract_compact_tree(node_object, a_pool, a_scratch));
+        }
+    };
+
+    extract_child_nodes("nodes", compact_node.get_nodes());
+    extract_child_nodes("floating_nodes", compact_node.get_floating_nodes());
+
+    return compact_node;
+}
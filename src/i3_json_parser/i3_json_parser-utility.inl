@@ -20,14 +20,14 @@
 /**
  * \file i3_json_parser-utility.inl
  *
- * Defines template function used for convenient extraction of data from "RapidJSON" objects.
+ * Defines template function used for convenient extraction of data from JSON objects of selected JSON backend.
  */
 
 #ifndef I3_JSON_PARSER_UTILITY_INL
 #define I3_JSON_PARSER_UTILITY_INL
 
-// External library headers.
-#include <rapidjson/document.h>
+// Library headers.
+#include "i3_json_backend.hpp"
 
 // C++ headers.
 #include <optional>
@@ -59,23 +59,23 @@ template<typename T> struct core_type<std::optional<T>> { using type = T; };
 template<typename T> using core_type_t = typename core_type<T>::type;
 
 /**
- * \brief      Helper template which checks if type T is supported by "RapidJSON" library.
+ * \brief      Helper template which checks if type T is supported by JSON backend.
  *
  * \tparam T   Type to be checked.
  *
  * \return     True of false.
  */
-template<typename T> using is_supported_by_rapidjson = std::disjunction<
-                                                                        std::is_same<T, bool>,
-                                                                        std::is_same<T, int>,
-                                                                        std::is_same<T, unsigned>,
-                                                                        std::is_same<T, std::int64_t>,
-                                                                        std::is_same<T, std::uint64_t>,
-                                                                        std::is_same<T, double>,
-                                                                        std::is_same<T, float>,
-                                                                        std::is_same<T, const char*>
-                                                                       >;
-template<typename T> constexpr bool is_supported_by_rapidjson_v = is_supported_by_rapidjson<T>::value;
+template<typename T> using is_supported_by_json_backend = std::disjunction<
+                                                                           std::is_same<T, bool>,
+                                                                           std::is_same<T, int>,
+                                                                           std::is_same<T, unsigned>,
+                                                                           std::is_same<T, std::int64_t>,
+                                                                           std::is_same<T, std::uint64_t>,
+                                                                           std::is_same<T, double>,
+                                                                           std::is_same<T, float>,
+                                                                           std::is_same<T, const char*>
+                                                                          >;
+template<typename T> constexpr bool is_supported_by_json_backend_v = is_supported_by_json_backend<T>::value;
 
 /**
  * \brief      Helper template which checks if type T is supported only by "i3-ipc++" library.
@@ -95,13 +95,13 @@ template<typename T> using is_supported_by_i3_ipc = std::disjunction<
 template<typename T> constexpr bool is_supported_by_i3_ipc_v = is_supported_by_i3_ipc<T>::value;
 
 /**
- * \brief      Helper template which checks if type T is supported either by "RapidJSON" or "i3-ipc++" library.
+ * \brief      Helper template which checks if type T is supported either by JSON backend or "i3-ipc++" library.
  *
  * \tparam T   Type to be checked.
  *
  * \return     True of false.
  */
-template<typename T> using is_supported = std::disjunction<is_supported_by_rapidjson<T>, is_supported_by_i3_ipc<T>>;
+template<typename T> using is_supported = std::disjunction<is_supported_by_json_backend<T>, is_supported_by_i3_ipc<T>>;
 template<typename T> constexpr bool is_supported_v = is_supported<T>::value;
 
 /**
@@ -116,54 +116,56 @@ template<typename T> constexpr bool is_supported_v = is_supported<T>::value;
  * \return                     Extracted value of the "a_attribute" from "a_json_object".
  */
 template<typename T, typename = std::enable_if_t<is_supported_v<core_type_t<T>>>>
-T get_attribute_value(const rapidjson::Value& a_json_object, const char* a_attribute)
+T get_attribute_value(i3_json_backend::value a_json_object, const char* a_attribute)
 {
-    assert(a_json_object.IsObject());
+    assert(i3_json_backend::is_object(a_json_object));
 
     // Handle non-existing attributes.
     if constexpr (is_optional_v<T>)
     {
-        if (!a_json_object.HasMember(a_attribute) || a_json_object[a_attribute].IsNull())
+        if (!i3_json_backend::has_member(a_json_object, a_attribute)
+            || i3_json_backend::is_null(i3_json_backend::member(a_json_object, a_attribute)))
         {
             return std::nullopt;
         }
     }
     else
     {
-        assert(a_json_object.HasMember(a_attribute));
+        assert(i3_json_backend::has_member(a_json_object, a_attribute));
     }
 
     // Extract attribute value from JSON object.
     using return_type = core_type_t<T>;
-    if constexpr (is_supported_by_rapidjson_v<return_type>)
+    i3_json_backend::value attribute = i3_json_backend::member(a_json_object, a_attribute);
+    if constexpr (is_supported_by_json_backend_v<return_type>)
     {
-        assert(a_json_object[a_attribute].template Is<return_type>());
-        return a_json_object[a_attribute].template Get<return_type>();
+        assert(i3_json_backend::is<return_type>(attribute));
+        return i3_json_backend::get<return_type>(attribute);
     }
     else if constexpr (std::is_signed_v<return_type>)
     {
         if constexpr (sizeof(return_type) <= sizeof(int))
         {
-            assert(a_json_object[a_attribute].template Is<int>());
-            return static_cast<return_type>(a_json_object[a_attribute].template Get<int>());
+            assert(i3_json_backend::is<int>(attribute));
+            return static_cast<return_type>(i3_json_backend::get<int>(attribute));
         }
         else
         {
-            assert(a_json_object[a_attribute].template Is<std::int64_t>());
-            return static_cast<return_type>(a_json_object[a_attribute].template Get<std::int64_t>());
+            assert(i3_json_backend::is<std::int64_t>(attribute));
+            return static_cast<return_type>(i3_json_backend::get<std::int64_t>(attribute));
         }
     }
     else if constexpr (std::is_unsigned_v<return_type>)
     {
         if constexpr (sizeof(return_type) <= sizeof(unsigned))
         {
-            assert(a_json_object[a_attribute].template Is<unsigned>());
-            return static_cast<return_type>(a_json_object[a_attribute].template Get<unsigned>());
+            assert(i3_json_backend::is<unsigned>(attribute));
+            return static_cast<return_type>(i3_json_backend::get<unsigned>(attribute));
         }
         else
         {
-            assert(a_json_object[a_attribute].template Is<std::uint64_t>());
-            return static_cast<return_type>(a_json_object[a_attribute].template Get<std::uint64_t>());
+            assert(i3_json_backend::is<std::uint64_t>(attribute));
+            return static_cast<return_type>(i3_json_backend::get<std::uint64_t>(attribute));
         }
     }
 }
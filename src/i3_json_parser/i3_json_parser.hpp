@@ -27,15 +27,26 @@
 #define I3_JSON_PARSER_HPP
 
 // Library headers.
+#include "i3_ipc.hpp"
 #include "i3_message.hpp"
 #include "i3_containers.hpp"
-
-// External library headers.
-#include <rapidjson/document.h>
+#include "i3_json_backend.hpp"
+#include "i3_tree_visitor.hpp"
+#include "i3_compact_node.hpp"
+#include "i3_string_pool.hpp"
+#include "i3_pmr_containers.hpp"
 
 // C++ headers.
+#include <memory>
 #include <vector>
 #include <string>
+#include <utility>
+#include <optional>
+#include <string_view>
+#include <memory_resource>
+
+// C headers.
+#include <cstddef>
 
 /**
  * \brief   This class is used for parsing the JSON messages sent by i3.
@@ -50,6 +61,16 @@ public:
     // Make class abstract.
     virtual ~i3_json_parser() = 0;
 
+    /**
+     * \brief   Type used to store any scalar value read by streaming JSON parser.
+     */
+    using json_value = i3_tree_visitor::value;
+
+    /**
+     * \brief   Type used to share the pool of interned strings between compact nodes.
+     */
+    using string_pool_pointer = std::shared_ptr<i3_containers::string_pool>;
+
     /**
      * \brief                            Parses i3's response for sent command(s).
      *
@@ -87,15 +108,145 @@ public:
     static std::vector<i3_containers::output> parse_outputs(const char* a_json_string);
 
     /**
-     * \brief                       Parses i3's response for node tree request.
+     * \brief                       Parses i3's response for node tree request, skipping subtrees rejected by filter.
+     *
+     * \param [in] a_stream         Stream from which i3's response in JSON format is read.
+     *
+     * \param [in] a_filter         Predicate which decides whether the node and its subtree should be extracted.
+     *                              If it is empty, the whole tree is extracted.
+     *
+     * \param [in] a_pool           Pool of worker threads which parse workspaces in parallel while the rest of the
+     *                              response is read. If it is null, the whole tree is parsed by the calling thread.
+     *
+     * \return                      Info about the root node in i3 node tree.
+     *
+     * \throws std::system_error    When system error occurs while reading from the stream.
+     *
+     * \throws i3_ipc_bad_message   When stream ends before the whole response is read.
+     *
+     * \throws i3_ipc_unsupported   When value of some node property is unknown to "i3-ipc++" library.
+     */
+    static i3_containers::node parse_tree(i3_message::payload_stream& a_stream,
+                                          const i3_ipc::tree_filter& a_filter = nullptr,
+                                          i3_thread_pool* a_pool = nullptr);
+
+    /**
+     * \brief                       Parses i3's response for node tree request into existing tree.<br>
+     *                              Strings and vectors of "a_tree" are reused wherever the shape of the tree allows it.
+     *
+     * \param [in] a_stream         Stream from which i3's response in JSON format is read.
+     *
+     * \param [out] a_tree          Root node of the tree which will be overwritten.
+     *
+     * \throws std::system_error    When system error occurs while reading from the stream.
+     *
+     * \throws i3_ipc_bad_message   When stream ends before the whole response is read.
+     *
+     * \throws i3_ipc_unsupported   When value of some node property is unknown to "i3-ipc++" library.
+     */
+    static void parse_tree(i3_message::payload_stream& a_stream, i3_containers::node& a_tree);
+
+    /**
+     * \brief                       Parses i3's response for node tree request into compact nodes.
+     *
+     * \param [in] a_stream         Stream from which i3's response in JSON format is read.
+     *
+     * \param [in] a_pool           Pool in which window classes, instances, roles and marks are interned.
+     *
+     * \return                      Info about the root node in i3 node tree.
+     *
+     * \throws std::system_error    When system error occurs while reading from the stream.
+     *
+     * \throws i3_ipc_bad_message   When stream ends before the whole response is read.
+     *
+     * \throws i3_ipc_unsupported   When value of some node property is unknown to "i3-ipc++" library.
+     */
+    static i3_containers::compact_node parse_compact_tree(i3_message::payload_stream& a_stream,
+                                                          const string_pool_pointer& a_pool);
+
+    /**
+     * \brief                       Parses i3's response for node tree request while it is being read, allocating the
+     *                              whole tree from given memory resource.
+     *
+     * \param [in] a_stream         Stream from which i3's response in JSON format is read.
      *
-     * \param [in] a_json_string    String containing the i3's response in JSON format.
+     * \param [in] a_resource       Memory resource used for every string and container in the tree.
      *
      * \return                      Info about the root node in i3 node tree.
      *
+     * \throws std::system_error    When system error occurs while reading from the stream.
+     *
+     * \throws i3_ipc_bad_message   When stream ends before the whole response is read.
+     *
+     * \throws i3_ipc_unsupported   When value of some node property is unknown to "i3-ipc++" library.
+     */
+    static i3_containers::pmr::node parse_tree(i3_message::payload_stream& a_stream,
+                                               std::pmr::memory_resource* a_resource);
+
+    /**
+     * \brief                       Streams i3's response for node tree request until the focused node is parsed.
+     *
+     * \param [in] a_stream         Stream from which i3's response in JSON format is read.
+     *
+     * \return                      Info about the focused node (with its subtree and its ancestors) or std::nullopt
+     *                              if nothing is focused.
+     *
+     * \throws std::system_error    When system error occurs while reading from the stream.
+     *
+     * \throws i3_ipc_bad_message   When stream ends before the whole response is read.
+     *
      * \throws i3_ipc_unsupported   When value of some node property is unknown to "i3-ipc++" library.
      */
-    static i3_containers::node parse_tree(const char* a_json_string);
+    static std::optional<i3_containers::focus_path> parse_focused_node(i3_message::payload_stream& a_stream);
+
+    /**
+     * \brief                       Streams i3's response for node tree request, collecting only the windows.
+     *
+     * \param [in] a_stream         Stream from which i3's response in JSON format is read.
+     *
+     * \return                      Info about every X11 window in the tree, in the order of the tree.
+     *
+     * \throws std::system_error    When system error occurs while reading from the stream.
+     *
+     * \throws i3_ipc_bad_message   When stream ends before the whole response is read.
+     *
+     * \throws i3_ipc_unsupported   When value of some node property is unknown to "i3-ipc++" library.
+     */
+    static std::vector<i3_containers::window_info> parse_windows(i3_message::payload_stream& a_stream);
+
+    /**
+     * \brief                       Streams i3's response for node tree request to given visitor.
+     *
+     * \param [in] a_stream         Stream from which i3's response in JSON format is read.
+     *
+     * \param [in] a_visitor        Visitor which receives nodes of the tree while they are being parsed.
+     *
+     * \throws std::system_error    When system error occurs while reading from the stream.
+     *
+     * \throws i3_ipc_bad_message   When stream ends before the whole response is read.
+     */
+    static void visit_tree(i3_message::payload_stream& a_stream, i3_tree_visitor& a_visitor);
+
+    /**
+     * \brief                      Streams i3's event message to given visitor.
+     *
+     * \param [in] a_json          Payload of the event message in JSON format.
+     *
+     * \param [in] a_visitor       Visitor which receives attributes of the event and nodes inside of it.
+     */
+    static void visit_event(std::string_view a_json, i3_tree_visitor& a_visitor);
+
+    /**
+     * \brief                      Reads only the change and the container ID of coalescable window event.<br>
+     *                             Parsing stops as soon as both of them are read, so the rest of the event is skipped.
+     *
+     * \param [in] a_json          Payload of the window event message in JSON format.
+     *
+     * \return                     Change ("title" or "move") and ID of the container, or std::nullopt for other
+     *                             changes.
+     */
+    static std::optional<std::pair<i3_containers::window_change, std::uint64_t>>
+    parse_window_event_key(std::string_view a_json);
 
     /**
      * \brief                      Parses i3's response for marks request.
@@ -148,13 +299,17 @@ public:
     static std::vector<std::string> parse_binding_modes(const char* a_json_string);
 
     /**
-     * \brief                      Parses i3's response for configuration request.
+     * \brief                       Parses i3's response for configuration request.
      *
-     * \param [in] a_json_string   String containing the i3's response in JSON format.
+     * \param [in] a_stream         Stream from which i3's response in JSON format is read.
+     *
+     * \return                      Most reacently loaded configuration used by i3.
      *
-     * \return                     Most reacently loaded configuration used by i3.
+     * \throws std::system_error    When system error occurs while reading from the stream.
+     *
+     * \throws i3_ipc_bad_message   When stream ends before the whole response is read.
      */
-    static std::string parse_config(const char* a_json_string);
+    static std::string parse_config(i3_message::payload_stream& a_stream);
 
     /**
      * \brief                            Parses i3's response for sending tick event.
@@ -264,6 +419,137 @@ public:
 
 private:
 
+    /**
+     * \brief   Consumer of node-level events which builds only the focused node and its ancestors.
+     */
+    class focused_node_finder;
+
+    /**
+     * \brief   Consumer of node-level events which builds the whole tree inside of given memory resource.
+     */
+    class pmr_tree_builder;
+
+    /**
+     * \brief   Consumer of node-level events which builds the tree, dropping the subtrees rejected by the filter.
+     */
+    class tree_builder;
+
+    /**
+     * \brief   Consumer of node-level events which builds flat list of windows, without building any node.
+     */
+    class window_collector;
+
+    /**
+     * \brief   Consumer of node-level events which reads only the change and the container ID of window event.
+     */
+    class window_event_key_reader;
+
+    /**
+     * \brief                       Converts the name of i3 node type into enumerator.
+     *
+     * \param [in] a_type           Name of the node type, as sent by i3.
+     *
+     * \return                      Node type named by "a_type".
+     *
+     * \throws i3_ipc_unsupported   When value of "a_type" is unknown to "i3-ipc++" library.
+     */
+    static i3_containers::node_type to_node_type(std::string_view a_type);
+
+    /**
+     * \brief                       Converts the name of border style into enumerator.
+     *
+     * \param [in] a_border_style   Name of the border style, as sent by i3.
+     *
+     * \return                      Border style named by "a_border_style".
+     *
+     * \throws i3_ipc_unsupported   When value of "a_border_style" is unknown to "i3-ipc++" library.
+     */
+    static i3_containers::border_style to_border_style(std::string_view a_border_style);
+
+    /**
+     * \brief                       Converts the name of node layout into enumerator.
+     *
+     * \param [in] a_layout         Name of the node layout, as sent by i3.
+     *
+     * \return                      Node layout named by "a_layout".
+     *
+     * \throws i3_ipc_unsupported   When value of "a_layout" is unknown to "i3-ipc++" library.
+     */
+    static i3_containers::node_layout to_node_layout(std::string_view a_layout);
+
+    /**
+     * \brief                       Stores one scalar attribute, reported by streaming JSON parser, into the node.
+     *
+     * \tparam Node                 Type of the node ("i3_containers::node" or its "pmr" variant).
+     *
+     * \param [out] a_node          Node which will store the attribute.
+     *
+     * \param [in] a_object         Name of the nested object which holds the attribute or empty for node itself.
+     *
+     * \param [in] a_key            Name of the attribute.
+     *
+     * \param [in] a_value          Value of the attribute.
+     *
+     * \throws i3_ipc_unsupported   When value of some node property is unknown to "i3-ipc++" library.
+     */
+    template<typename Node>
+    static void set_node_field(Node& a_node,
+                               std::string_view a_object,
+                               std::string_view a_key,
+                               const json_value& a_value);
+
+    /**
+     * \brief                     Asks the filter whether the node should be kept.<br>
+     *                            Child nodes of both nodes are moved out for the duration of the call, so the
+     *                            filter never sees them.
+     *
+     * \param [in] a_filter       Predicate which decides whether the node and its subtree should be kept.
+     *
+     * \param [in,out] a_node     Candidate node.
+     *
+     * \param [in,out] a_parent   Parent of the candidate node.
+     *
+     * \return                    True if the node should be kept, false otherwise.
+     */
+    static bool apply_filter(const i3_ipc::tree_filter& a_filter,
+                             i3_containers::node& a_node,
+                             i3_containers::node& a_parent);
+
+    /**
+     * \brief                       Streams i3's node tree, dropping the subtrees rejected by filter before any of
+     *                              their child nodes is parsed.
+     *
+     * \param [in] a_stream         Stream from which the node tree in JSON format is read.
+     *
+     * \param [in] a_filter         Predicate which decides whether the node and its subtree should be kept.
+     *                              It is never called for the root node.
+     *
+     * \return                      Info about the root node in pruned i3 node tree.
+     *
+     * \throws std::system_error    When system error occurs while reading from the stream.
+     *
+     * \throws i3_ipc_bad_message   When stream ends before the whole response is read.
+     *
+     * \throws i3_ipc_unsupported   When value of some node property is unknown to "i3-ipc++" library.
+     */
+    static i3_containers::node parse_filtered_tree(i3_message::payload_stream& a_stream,
+                                                   const i3_ipc::tree_filter& a_filter);
+
+    /**
+     * \brief                       Parses the node tree, dropping the subtrees rejected by filter before any of their
+     *                              child nodes is parsed.
+     *
+     * \param [in] a_json           JSON of the node tree.
+     *
+     * \param [in] a_filter         Predicate which decides whether the node and its subtree should be kept.
+     *                              It is never called for the root node.
+     *
+     * \return                      Info about the root node in pruned i3 node tree.
+     *
+     * \throws i3_ipc_unsupported   When value of some node property is unknown to "i3-ipc++" library.
+     */
+    static i3_containers::node parse_filtered_tree(std::string_view a_json, const i3_ipc::tree_filter& a_filter);
+
     /**
      * \brief                      Parses JSON string into an JSON object.
      *
@@ -271,7 +557,29 @@ private:
      *
      * \return                     JSON object.
      */
-    static rapidjson::Document parse_json(const char* a_json_string);
+    static i3_json_backend::document parse_json(const char* a_json_string);
+
+    /**
+     * \brief               Parses part of the larger JSON string into an JSON object.
+     *
+     * \param [in] a_json   JSON to be parsed. It doesn't have to be null-terminated.
+     *
+     * \return              JSON object.
+     */
+    static i3_json_backend::document parse_json(std::string_view a_json);
+
+    /**
+     * \brief                       Parses JSON read from the stream into an JSON object.
+     *
+     * \param [in] a_stream         Stream from which JSON is read.
+     *
+     * \return                      JSON object.
+     *
+     * \throws std::system_error    When system error occurs while reading from the stream.
+     *
+     * \throws i3_ipc_bad_message   When stream ends before the whole JSON is read.
+     */
+    static i3_json_backend::document parse_json(i3_message::payload_stream& a_stream);
 
     /**
      * \brief                      Extracts informations about rectangle from JSON object.
@@ -282,7 +590,30 @@ private:
      *
      * \return                     Rectangle info extracted from the "a_attribute" in "a_json_object".
      */
-    static i3_containers::rectangle extract_rectangle(const rapidjson::Value& a_json_object, const char* a_attribute);
+    static i3_containers::rectangle extract_rectangle(i3_json_backend::value a_json_object, const char* a_attribute);
+
+    /**
+     * \brief                       Extracts info about single i3 node from JSON object, without its child nodes.
+     *
+     * \param [in] a_json_object    JSON object.
+     *
+     * \return                      Info about the node, extracted from the "a_json_object".
+     *
+     * \throws i3_ipc_unsupported   When value of some node property is unknown to "i3-ipc++" library.
+     */
+    static i3_containers::node extract_node(i3_json_backend::value a_json_object);
+
+    /**
+     * \brief                       Extracts info about single i3 node from JSON object into existing node, without
+     *                              its child nodes. Strings and vectors of "a_node" are reused wherever possible.
+     *
+     * \param [in] a_json_object    JSON object.
+     *
+     * \param [out] a_node          Node which will be overwritten with the info extracted from the "a_json_object".
+     *
+     * \throws i3_ipc_unsupported   When value of some node property is unknown to "i3-ipc++" library.
+     */
+    static void extract_node(i3_json_backend::value a_json_object, i3_containers::node& a_node);
 
     /**
      * \brief                       Extracts info about i3 node tree from JSON object.
@@ -293,7 +624,64 @@ private:
      *
      * \throws i3_ipc_unsupported   When value of some node property is unknown to "i3-ipc++" library.
      */
-    static i3_containers::node extract_tree(const rapidjson::Value& a_json_object);
+    static i3_containers::node extract_tree(i3_json_backend::value a_json_object);
+
+    /**
+     * \brief                       Extracts info about i3 node tree from JSON object into existing tree.<br>
+     *                              Child nodes are matched by their position, so the capacity of strings and vectors
+     *                              is kept wherever the shape of the tree didn't change.
+     *
+     * \param [in] a_json_object    JSON object.
+     *
+     * \param [out] a_tree          Root node of the tree which will be overwritten.
+     *
+     * \throws i3_ipc_unsupported   When value of some node property is unknown to "i3-ipc++" library.
+     */
+    static void extract_tree(i3_json_backend::value a_json_object, i3_containers::node& a_tree);
+
+    /**
+     * \brief                       Extracts info about i3 node tree from JSON object into compact nodes.<br>
+     *                              Every node is first extracted into the same regular node, which keeps the capacity
+     *                              of its strings, so strings which are already interned are never allocated again.
+     *
+     * \param [in] a_json_object    JSON object.
+     *
+     * \param [in] a_pool           Pool in which window classes, instances, roles and marks are interned.
+     *
+     * \param [in,out] a_scratch    Regular node reused for extracting every node in the tree.
+     *
+     * \return                      Info about the root node in i3 node tree, extracted from the "a_json_object".
+     *
+     * \throws i3_ipc_unsupported   When value of some node property is unknown to "i3-ipc++" library.
+     */
+    static i3_containers::compact_node extract_compact_tree(i3_json_backend::value a_json_object,
+                                                            const string_pool_pointer& a_pool,
+                                                            i3_containers::node& a_scratch);
+
+    /**
+     * \brief                       Streams i3's node tree, handing the JSON of every workspace to the pool of worker
+     *                              threads as soon as it is read.<br>
+     *                              Calling thread reads the response and parses everything around workspaces (root,
+     *                              outputs and their content containers), then it stitches parsed workspaces in.
+     *
+     * \param [in] a_stream         Stream from which i3's response in JSON format is read.
+     *
+     * \param [in] a_filter         Predicate which decides whether the node and its subtree should be kept.
+     *                              It is called concurrently from several threads.
+     *
+     * \param [in] a_pool           Pool of worker threads which parse workspaces.
+     *
+     * \return                      Info about the root node in i3 node tree.
+     *
+     * \throws std::system_error    When system error occurs while reading from the stream.
+     *
+     * \throws i3_ipc_bad_message   When stream ends before the whole response is read.
+     *
+     * \throws i3_ipc_unsupported   When value of some node property is unknown to "i3-ipc++" library.
+     */
+    static i3_containers::node parse_tree_in_parallel(i3_message::payload_stream& a_stream,
+                                                      const i3_ipc::tree_filter& a_filter,
+                                                      i3_thread_pool& a_pool);
 
 };
 
@@ -31,21 +31,67 @@
 #include <i3/ipc.h>
 
 // C++ headers.
+#include <chrono>
 #include <vector>
 #include <string>
+#include <algorithm>
 #include <optional>
 #include <string_view>
 #include <type_traits>
 #include <system_error>
 
 // C headers.
+#include <cerrno>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <poll.h>
+#include <sys/ioctl.h>
 #include <unistd.h>
 
 namespace
 {
     constexpr std::string_view MAGIC_STRING = I3_IPC_MAGIC; /**< Magic string used for communication with i3. */
+    constexpr std::uint32_t CHUNK_SIZE = 64 * 1024;         /**< Size of chunks in which payload is streamed.  */
+
+    /**
+     * \brief                       Reads exactly the given number of bytes from the socket.
+     *
+     * \param [in] a_socket         Socket from which the data will be read.
+     *
+     * \param [out] a_buffer        Buffer which will store the read data.
+     *
+     * \param [in] a_size           Number of bytes to be read.
+     *
+     * \throws std::system_error    When system error occurs while reading from "a_socket".
+     *
+     * \throws i3_ipc_bad_message   When socket is closed before all bytes are read.
+     */
+    // NOTE: Single read() may return only a part of big message, so it is repeated until everything is read.
+    void read_exactly(int a_socket, void* a_buffer, std::size_t a_size)
+    {
+        auto* buffer = static_cast<char*>(a_buffer);
+        while (a_size > 0)
+        {
+            const ssize_t read_size = read(a_socket, buffer, a_size);
+            if (read_size == -1)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+
+                throw std::system_error(errno, std::generic_category());
+            }
+            else if (read_size == 0)
+            {
+                throw i3_ipc_bad_message("Socket was closed in the middle of the message!");
+            }
+
+            buffer += read_size;
+            a_size -= static_cast<std::size_t>(read_size);
+        }
+    }
 } // Unnamed namespace.
 
 void i3_message::send(int a_socket, i3_message::type a_type, const std::optional<std::string_view>& a_payload)
@@ -74,13 +120,16 @@ void i3_message::send(int a_socket, i3_message::type a_type, const std::optional
 }
 
 i3_message::response i3_message::receive(int a_socket)
+{
+    const header message_header = receive_header(a_socket);
+    return { message_header.message_type, receive_payload(a_socket, message_header.payload_size) };
+}
+
+i3_message::header i3_message::receive_header(int a_socket)
 {
     // Read message header.
     i3_ipc_header_t header;
-    if (read(a_socket, &header, sizeof(header)) == -1)
-    {
-        throw std::system_error(errno, std::generic_category());
-    }
+    read_exactly(a_socket, &header, sizeof(header));
 
     // Check if magic string is valid.
     if (const std::string_view magic_string(header.magic, MAGIC_STRING.size()); magic_string != MAGIC_STRING)
@@ -90,12 +139,94 @@ i3_message::response i3_message::receive(int a_socket)
                                  "Received: " + std::string(magic_string));
     }
 
-    // Read message payload if it exists.
-    std::vector<char> buffer(header.size);
-    if (buffer.size() && read(a_socket, buffer.data(), buffer.size()) == -1)
+    return { static_cast<i3_message::type>(header.type), header.size };
+}
+
+std::string i3_message::receive_payload(int a_socket, std::uint32_t a_payload_size)
+{
+    std::string payload(a_payload_size, '\0');
+    read_exactly(a_socket, payload.data(), payload.size());
+
+    return payload;
+}
+
+bool i3_message::wait_readable(int a_socket, std::chrono::milliseconds a_timeout)
+{
+    pollfd descriptor = { a_socket, POLLIN, 0 };
+    while (true)
+    {
+        const int result = poll(&descriptor, 1, static_cast<int>(a_timeout.count()));
+        if (result == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            throw std::system_error(errno, std::generic_category());
+        }
+
+        // NOTE: Closed or broken socket is reported as readable, so that the following read reports the problem.
+        return result > 0;
+    }
+}
+
+std::size_t i3_message::readable_bytes(int a_socket)
+{
+    int bytes = 0;
+    if (ioctl(a_socket, FIONREAD, &bytes) == -1)
     {
         throw std::system_error(errno, std::generic_category());
     }
 
-    return { static_cast<i3_message::type>(header.type), std::string(buffer.data(), buffer.size()) };
+    return static_cast<std::size_t>(bytes);
+}
+
+i3_message::payload_stream::payload_stream(int a_socket, std::uint32_t a_payload_size)
+    : m_socket(a_socket),
+      m_remaining(a_payload_size),
+      m_consumed(0),
+      m_buffer(std::min(a_payload_size, CHUNK_SIZE)),
+      m_current(m_buffer.data()),
+      m_end(m_buffer.data())
+{
+    read_chunk();
+}
+
+void i3_message::payload_stream::discard()
+{
+    while (m_remaining > 0)
+    {
+        read_chunk();
+    }
+
+    m_current = m_end;
+}
+
+std::string i3_message::payload_stream::read_rest(std::size_t a_padding)
+{
+    std::string rest;
+    const std::size_t buffered_size = static_cast<std::size_t>(m_end - m_current);
+    rest.reserve(buffered_size + m_remaining + a_padding);
+    rest.assign(m_current, m_end);
+    rest.resize(buffered_size + m_remaining);
+    read_exactly(m_socket, rest.data() + buffered_size, m_remaining);
+
+    m_consumed += static_cast<std::size_t>(m_end - m_buffer.data()) + m_remaining;
+    m_remaining = 0;
+    m_current = m_end = m_buffer.data();
+
+    return rest;
+}
+
+void i3_message::payload_stream::read_chunk()
+{
+    m_consumed += static_cast<std::size_t>(m_end - m_buffer.data());
+
+    const std::uint32_t chunk_size = std::min(m_remaining, static_cast<std::uint32_t>(m_buffer.size()));
+    read_exactly(m_socket, m_buffer.data(), chunk_size);
+    m_remaining -= chunk_size;
+
+    m_current = m_buffer.data();
+    m_end = m_buffer.data() + chunk_size;
 }
@@ -30,12 +30,16 @@
 #include <i3/ipc.h>
 
 // C++ headers.
+#include <chrono>
+#include <vector>
 #include <string>
 #include <optional>
 #include <string_view>
 
 // C headers.
+#include <cstddef>
 #include <cstdint>
+#include <cassert>
 
 /**
  * \brief   Namespace with functions and types specialized for communication with i3.
@@ -81,6 +85,116 @@ namespace i3_message
         std::string payload; /**< Message payload. */
     };
 
+    /**
+     * \brief   Structure representing the header of i3's message.
+     */
+    struct header
+    {
+        type message_type;          /**< Message type.             */
+        std::uint32_t payload_size; /**< Size of message payload. */
+    };
+
+    /**
+     * \brief   Input stream which reads the payload of i3's message directly from the socket, chunk by chunk.<br>
+     *          It satisfies "RapidJSON" stream concept, so JSON can be parsed while the payload is still arriving.
+     */
+    // NOTE: Peek() returns '\0' once the whole payload is consumed, which is what "RapidJSON" expects at the end.
+    class payload_stream
+    {
+
+    public:
+
+        /// \cond DO_NOT_DOCUMENT
+        using Ch = char;
+        /// \endcond
+
+        /**
+         * \brief                       Constructs the stream and reads the first chunk of the payload.
+         *
+         * \param [in] a_socket         Socket from which the payload will be read.
+         *
+         * \param [in] a_payload_size   Size of the payload, as stated in message header.
+         *
+         * \throws std::system_error    When system error occurs while reading from "a_socket".
+         *
+         * \throws i3_ipc_bad_message   When socket is closed before the whole chunk is read.
+         */
+        payload_stream(int a_socket, std::uint32_t a_payload_size);
+
+        /// \cond DO_NOT_DOCUMENT
+        payload_stream(const payload_stream& a_stream) = delete;
+        payload_stream& operator=(const payload_stream& a_stream) = delete;
+
+        Ch Peek() const
+        {
+            return m_current != m_end ? *m_current : '\0';
+        }
+
+        Ch Take()
+        {
+            const Ch character = Peek();
+            if (m_current != m_end && ++m_current == m_end)
+            {
+                read_chunk();
+            }
+
+            return character;
+        }
+
+        std::size_t Tell() const
+        {
+            return m_consumed + static_cast<std::size_t>(m_current - m_buffer.data());
+        }
+
+        Ch* PutBegin() { assert("Stream is read-only!" && 0); return nullptr; }
+        void Put(Ch)   { assert("Stream is read-only!" && 0);                 }
+        void Flush()   { assert("Stream is read-only!" && 0);                 }
+        std::size_t PutEnd(Ch*) { assert("Stream is read-only!" && 0); return 0; }
+        /// \endcond
+
+        /**
+         * \brief                       Reads and drops the rest of the payload, so that the next message can be read.
+         *
+         * \throws std::system_error    When system error occurs while reading from the socket.
+         *
+         * \throws i3_ipc_bad_message   When socket is closed before the whole payload is read.
+         */
+        void discard();
+
+        /**
+         * \brief                       Reads the rest of the payload at once.
+         *
+         * \param [in] a_padding        Number of bytes which are reserved after the payload, so that parsers which
+         *                              read past the end of the input can use returned string without copying it.
+         *
+         * \return                      All characters of the payload which were not consumed yet.
+         *
+         * \throws std::system_error    When system error occurs while reading from the socket.
+         *
+         * \throws i3_ipc_bad_message   When socket is closed before the whole payload is read.
+         */
+        std::string read_rest(std::size_t a_padding = 0);
+
+    private:
+
+        /**
+         * \brief                       Reads the next chunk of the payload into the buffer.
+         *
+         * \throws std::system_error    When system error occurs while reading from the socket.
+         *
+         * \throws i3_ipc_bad_message   When socket is closed before the whole chunk is read.
+         */
+        void read_chunk();
+
+        int m_socket;               /**< Socket from which the payload is read.            */
+        std::uint32_t m_remaining;  /**< Number of payload bytes not yet read from socket. */
+        std::size_t m_consumed;     /**< Number of bytes consumed before current chunk.    */
+        std::vector<char> m_buffer; /**< Buffer with current chunk of the payload.         */
+        const char* m_current;      /**< Next character in the buffer.                     */
+        const char* m_end;          /**< End of the current chunk in the buffer.           */
+
+    }; // class payload_stream
+
     /**
      * \brief                      Constructs message from given arguments and sends it to i3.
      *
@@ -107,6 +221,58 @@ namespace i3_message
      */
     response receive(int a_socket);
 
+    /**
+     * \brief                       Receives header of i3's message, leaving its payload in the socket.
+     *
+     * \param [in] a_socket         Socket through which message will be received from i3.
+     *
+     * \return                      Type and payload size of the message.
+     *
+     * \throws std::system_error    When system error occurs while reading from "a_socket".
+     *
+     * \throws i3_ipc_bad_message   When magic string sent by i3 is not appropriate.
+     */
+    header receive_header(int a_socket);
+
+    /**
+     * \brief                       Receives the whole payload of the message whose header was already received.
+     *
+     * \param [in] a_socket         Socket through which payload will be received from i3.
+     *
+     * \param [in] a_payload_size   Size of the payload, as stated in message header.
+     *
+     * \return                      Message payload.
+     *
+     * \throws std::system_error    When system error occurs while reading from "a_socket".
+     *
+     * \throws i3_ipc_bad_message   When socket is closed before the whole payload is read.
+     */
+    std::string receive_payload(int a_socket, std::uint32_t a_payload_size);
+
+    /**
+     * \brief                       Waits until the next message can be read from the socket without blocking.
+     *
+     * \param [in] a_socket         Socket which is checked.
+     *
+     * \param [in] a_timeout        Maximum time to wait. Zero only checks whether data is already available.
+     *
+     * \return                      True if the socket is readable, false if the time ran out.
+     *
+     * \throws std::system_error    When system error occurs while waiting on "a_socket".
+     */
+    bool wait_readable(int a_socket, std::chrono::milliseconds a_timeout);
+
+    /**
+     * \brief                       Returns the number of bytes which were already received by the socket.
+     *
+     * \param [in] a_socket         Socket which is checked.
+     *
+     * \return                      Number of bytes which can be read from "a_socket" without blocking.
+     *
+     * \throws std::system_error    When system error occurs while checking "a_socket".
+     */
+    std::size_t readable_bytes(int a_socket);
+
 } // namespace i3_message.
 
 #endif // I3_MESSAGE_HPP
@@ -0,0 +1,215 @@
+/*
+    Copyright (C) 2019, Ivan Balević
+
+    This file is part of "i3-ipc++" library.
+
+    "i3-ipc++" is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    "i3-ipc++" is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with "i3-ipc++". If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+ * \file    i3_persistent_tree.cpp
+ *
+ * \brief   Defines member functions of "i3_containers::persistent_node" and "i3_containers::snapshot_store" classes.
+ */
+
+// Library headers.
+#include "i3_persistent_tree.hpp"
+#include "i3_containers.hpp"
+
+// C++ headers.
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <utility>
+#include <functional>
+
+// C headers.
+#include <cstddef>
+#include <cstdint>
+
+namespace i3_containers
+{
+    persistent_node::persistent_node(node a_info, std::vector<pointer> a_nodes, std::vector<pointer> a_floating_nodes)
+        : m_info(std::move(a_info)), m_nodes(std::move(a_nodes)), m_floating_nodes(std::move(a_floating_nodes))
+    {
+        // Child nodes are kept only as persistent nodes.
+        m_info.nodes.clear();
+        m_info.floating_nodes.clear();
+    }
+
+    persistent_node::pointer persistent_node::make(node a_tree)
+    {
+        const auto make_children = [](std::vector<node>& a_nodes) -> std::vector<pointer>
+        {
+            std::vector<pointer> children;
+            children.reserve(a_nodes.size());
+            for (auto& child_node : a_nodes)
+            {
+                children.push_back(make(std::move(child_node)));
+            }
+
+            return children;
+        };
+
+        std::vector<pointer> nodes = make_children(a_tree.nodes);
+        std::vector<pointer> floating_nodes = make_children(a_tree.floating_nodes);
+
+        // NOTE: Constructor is private, so "std::make_shared" can't be used.
+        return pointer(new persistent_node(std::move(a_tree), std::move(nodes), std::move(floating_nodes)));
+    }
+
+    const node& persistent_node::get_info() const
+    {
+        return m_info;
+    }
+
+    const std::vector<persistent_node::pointer>& persistent_node::get_nodes() const
+    {
+        return m_nodes;
+    }
+
+    const std::vector<persistent_node::pointer>& persistent_node::get_floating_nodes() const
+    {
+        return m_floating_nodes;
+    }
+
+    node persistent_node::to_node() const
+    {
+        node result = m_info;
+        result.nodes.reserve(m_nodes.size());
+        for (const auto& child_node : m_nodes)
+        {
+            result.nodes.push_back(child_node->to_node());
+        }
+        result.floating_nodes.reserve(m_floating_nodes.size());
+        for (const auto& floating_node : m_floating_nodes)
+        {
+            result.floating_nodes.push_back(floating_node->to_node());
+        }
+
+        return result;
+    }
+
+    persistent_node::pointer persistent_node::update(std::uint64_t a_id,
+                                                     const std::function<void(node&)>& a_update) const
+    {
+        return rebuild(a_id, [&](const persistent_node& a_node) -> pointer
+                             {
+                                 node info = a_node.m_info;
+                                 a_update(info);
+                                 return pointer(new persistent_node(std::move(info), a_node.m_nodes,
+                                                                    a_node.m_floating_nodes));
+                             });
+    }
+
+    persistent_node::pointer persistent_node::replace(std::uint64_t a_id, pointer a_subtree) const
+    {
+        return rebuild(a_id, [&](const persistent_node&) -> pointer
+                             {
+                                 return a_subtree;
+                             });
+    }
+
+    persistent_node::pointer persistent_node::insert(std::uint64_t a_parent_id,
+                                                     pointer a_subtree,
+                                                     bool a_floating) const
+    {
+        return rebuild(a_parent_id, [&](const persistent_node& a_node) -> pointer
+                                    {
+                                        std::vector<pointer> nodes = a_node.m_nodes;
+                                        std::vector<pointer> floating_nodes = a_node.m_floating_nodes;
+                                        (a_floating ? floating_nodes : nodes).push_back(a_subtree);
+                                        return pointer(new persistent_node(a_node.m_info, std::move(nodes),
+                                                                           std::move(floating_nodes)));
+                                    });
+    }
+
+    persistent_node::pointer persistent_node::rebuild(std::uint64_t a_id, const transformation& a_transform) const
+    {
+        if (m_info.id == a_id)
+        {
+            return a_transform(*this);
+        }
+
+        // Returns the copy of given child list with the transformed subtree, or nothing if subtree isn't there.
+        const auto rebuild_children = [&](const std::vector<pointer>& a_children,
+                                          std::vector<pointer>& a_result) -> bool
+        {
+            for (std::size_t i = 0; i < a_children.size(); ++i)
+            {
+                pointer child_node = a_children[i]->rebuild(a_id, a_transform);
+                if (child_node == a_children[i])
+                {
+                    continue;
+                }
+
+                // NOTE: Only the list of pointers is copied, every sibling subtree is shared.
+                a_result = a_children;
+                if (child_node)
+                {
+                    a_result[i] = std::move(child_node);
+                }
+                else
+                {
+                    a_result.erase(a_result.begin() + static_cast<std::ptrdiff_t>(i));
+                }
+                return true;
+            }
+
+            return false;
+        };
+
+        std::vector<pointer> children;
+        if (rebuild_children(m_nodes, children))
+        {
+            return pointer(new persistent_node(m_info, std::move(children), m_floating_nodes));
+        }
+        if (rebuild_children(m_floating_nodes, children))
+        {
+            return pointer(new persistent_node(m_info, m_nodes, std::move(children)));
+        }
+
+        return shared_from_this();
+    }
+
+    snapshot_store::snapshot_store(std::size_t a_history)
+        : m_current(), m_history_size(a_history), m_history_mutex(), m_history()
+    {
+    }
+
+    void snapshot_store::publish(persistent_node::pointer a_snapshot)
+    {
+        // NOTE: Publishers are serialized, so that the history is in the same order as the published versions.
+        const std::lock_guard<std::mutex> lock(m_history_mutex);
+
+        m_history.push_back(a_snapshot);
+        while (m_history.size() > m_history_size)
+        {
+            m_history.pop_front();
+        }
+
+        std::atomic_store(&m_current, std::move(a_snapshot));
+    }
+
+    persistent_node::pointer snapshot_store::get_current() const
+    {
+        return std::atomic_load(&m_current);
+    }
+
+    std::vector<persistent_node::pointer> snapshot_store::get_history() const
+    {
+        const std::lock_guard<std::mutex> lock(m_history_mutex);
+        return std::vector<persistent_node::pointer>(m_history.begin(), m_history.end());
+    }
+} // i3_containers namespace
@@ -0,0 +1,329 @@
+/*
+    Copyright (C) 2019, Ivan Balević
+
+    This file is part of "i3-ipc++" library.
+
+    "i3-ipc++" is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    "i3-ipc++" is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with "i3-ipc++". If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+ * \file    i3_pmr_containers.cpp
+ *
+ * \brief   Implements allocator-extended constructors of containers from "i3_containers::pmr" namespace.
+ */
+
+// Library headers.
+#include "i3_pmr_containers.hpp"
+
+// C++ headers.
+#include <string>
+#include <utility>
+#include <optional>
+#include <memory_resource>
+
+namespace
+{
+    /**
+     * \brief                   Copies optional string into memory provided by given allocator.
+     *
+     * \param [in] a_string     String to be copied.
+     *
+     * \param [in] a_allocator  Allocator used for the copy.
+     *
+     * \return                  Copy of "a_string" which uses "a_allocator".
+     */
+    std::optional<std::pmr::string> copy_string(const std::optional<std::pmr::string>& a_string,
+                                                 const i3_containers::pmr::allocator_type& a_allocator)
+    {
+        if (!a_string)
+        {
+            return std::nullopt;
+        }
+
+        return std::optional<std::pmr::string>(std::in_place, *a_string, a_allocator);
+    }
+
+    /**
+     * \brief                   Moves optional string into memory provided by given allocator.<br>
+     *                          Nothing is copied if string already uses equal allocator.
+     *
+     * \param [in] a_string     String to be moved.
+     *
+     * \param [in] a_allocator  Allocator used for the result.
+     *
+     * \return                  "a_string" which uses "a_allocator".
+     */
+    std::optional<std::pmr::string> move_string(std::optional<std::pmr::string>&& a_string,
+                                                const i3_containers::pmr::allocator_type& a_allocator)
+    {
+        if (!a_string)
+        {
+            return std::nullopt;
+        }
+
+        return std::optional<std::pmr::string>(std::in_place, std::move(*a_string), a_allocator);
+    }
+
+    /**
+     * \brief                   Assigns optional string without changing the allocator of the target string.
+     *
+     * \tparam Source           Type of the source optional string (const reference or rvalue reference).
+     *
+     * \param [out] a_target    String which will be assigned.
+     *
+     * \param [in] a_source     String whose value will be assigned.
+     *
+     * \param [in] a_allocator  Allocator of the object which owns "a_target".
+     */
+    template<typename Source>
+    void assign_string(std::optional<std::pmr::string>& a_target,
+                       Source&& a_source,
+                       const i3_containers::pmr::allocator_type& a_allocator)
+    {
+        // NOTE: Assignment of empty optional would construct the string with default memory resource.
+        if (!a_source)
+        {
+            a_target.reset();
+        }
+        else if (a_target)
+        {
+            *a_target = *std::forward<Source>(a_source);
+        }
+        else
+        {
+            a_target.emplace(*std::forward<Source>(a_source), a_allocator);
+        }
+    }
+
+    /**
+     * \brief                   Assigns optional window properties without changing the allocator of the target.
+     *
+     * \tparam Source           Type of the source optional window (const reference or rvalue reference).
+     *
+     * \param [out] a_target    Window properties which will be assigned.
+     *
+     * \param [in] a_source     Window properties whose value will be assigned.
+     *
+     * \param [in] a_allocator  Allocator of the node which owns "a_target".
+     */
+    template<typename Source>
+    void assign_window(std::optional<i3_containers::pmr::x11_window>& a_target,
+                       Source&& a_source,
+                       const i3_containers::pmr::allocator_type& a_allocator)
+    {
+        if (!a_source)
+        {
+            a_target.reset();
+        }
+        else if (a_target)
+        {
+            *a_target = *std::forward<Source>(a_source);
+        }
+        else
+        {
+            a_target.emplace(*std::forward<Source>(a_source), a_allocator);
+        }
+    }
+} // Unnamed namespace.
+
+namespace i3_containers::pmr
+{
+    x11_window::x11_window(const allocator_type& a_allocator)
+        : window_class(), window_instance(), window_role(), window_title(), transient_for(), m_allocator(a_allocator)
+    {
+    }
+
+    // NOTE: Like "std::pmr" containers, copy doesn't inherit the memory resource of the original.
+    x11_window::x11_window(const x11_window& a_window) : x11_window(a_window, allocator_type())
+    {
+    }
+
+    x11_window::x11_window(const x11_window& a_window, const allocator_type& a_allocator)
+        : window_class(copy_string(a_window.window_class, a_allocator)),
+          window_instance(copy_string(a_window.window_instance, a_allocator)),
+          window_role(copy_string(a_window.window_role, a_allocator)),
+          window_title(copy_string(a_window.window_title, a_allocator)),
+          transient_for(a_window.transient_for),
+          m_allocator(a_allocator)
+    {
+    }
+
+    x11_window::x11_window(x11_window&& a_window, const allocator_type& a_allocator)
+        : window_class(move_string(std::move(a_window.window_class), a_allocator)),
+          window_instance(move_string(std::move(a_window.window_instance), a_allocator)),
+          window_role(move_string(std::move(a_window.window_role), a_allocator)),
+          window_title(move_string(std::move(a_window.window_title), a_allocator)),
+          transient_for(a_window.transient_for),
+          m_allocator(a_allocator)
+    {
+    }
+
+    x11_window& x11_window::operator=(const x11_window& a_window)
+    {
+        assign_string(window_class, a_window.window_class, m_allocator);
+        assign_string(window_instance, a_window.window_instance, m_allocator);
+        assign_string(window_role, a_window.window_role, m_allocator);
+        assign_string(window_title, a_window.window_title, m_allocator);
+        transient_for = a_window.transient_for;
+
+        return *this;
+    }
+
+    x11_window& x11_window::operator=(x11_window&& a_window)
+    {
+        assign_string(window_class, std::move(a_window.window_class), m_allocator);
+        assign_string(window_instance, std::move(a_window.window_instance), m_allocator);
+        assign_string(window_role, std::move(a_window.window_role), m_allocator);
+        assign_string(window_title, std::move(a_window.window_title), m_allocator);
+        transient_for = a_window.transient_for;
+
+        return *this;
+    }
+
+    x11_window::allocator_type x11_window::get_allocator() const
+    {
+        return m_allocator;
+    }
+
+    node::node(const allocator_type& a_allocator)
+        : focus(a_allocator), marks(a_allocator), nodes(a_allocator), floating_nodes(a_allocator)
+    {
+    }
+
+    node::node(const node& a_node, const allocator_type& a_allocator)
+        : id(a_node.id),
+          name(copy_string(a_node.name, a_allocator)),
+          type(a_node.type),
+          border(a_node.border),
+          current_border_width(a_node.current_border_width),
+          layout(a_node.layout),
+          percent(a_node.percent),
+          rect(a_node.rect),
+          window_rect(a_node.window_rect),
+          deco_rect(a_node.deco_rect),
+          geometry(a_node.geometry),
+          window(a_node.window),
+          window_properties(),
+          is_urgent(a_node.is_urgent),
+          is_focused(a_node.is_focused),
+          focus(a_node.focus, a_allocator),
+          fullscreen_mode(a_node.fullscreen_mode),
+          marks(a_node.marks, a_allocator),
+          nodes(a_node.nodes, a_allocator),
+          floating_nodes(a_node.floating_nodes, a_allocator)
+    {
+        // NOTE: Optional is not allocator-aware, so allocator has to be passed to its value explicitly.
+        if (a_node.window_properties)
+        {
+            window_properties.emplace(*a_node.window_properties, a_allocator);
+        }
+    }
+
+    node::node(node&& a_node, const allocator_type& a_allocator)
+        : id(a_node.id),
+          name(move_string(std::move(a_node.name), a_allocator)),
+          type(a_node.type),
+          border(a_node.border),
+          current_border_width(a_node.current_border_width),
+          layout(a_node.layout),
+          percent(a_node.percent),
+          rect(a_node.rect),
+          window_rect(a_node.window_rect),
+          deco_rect(a_node.deco_rect),
+          geometry(a_node.geometry),
+          window(a_node.window),
+          window_properties(),
+          is_urgent(a_node.is_urgent),
+          is_focused(a_node.is_focused),
+          focus(std::move(a_node.focus), a_allocator),
+          fullscreen_mode(a_node.fullscreen_mode),
+          marks(std::move(a_node.marks), a_allocator),
+          nodes(std::move(a_node.nodes), a_allocator),
+          floating_nodes(std::move(a_node.floating_nodes), a_allocator)
+    {
+        if (a_node.window_properties)
+        {
+            window_properties.emplace(std::move(*a_node.window_properties), a_allocator);
+        }
+    }
+
+    node& node::operator=(const node& a_node)
+    {
+        // Cover self-assignment.
+        if (this == &a_node)
+        {
+            return *this;
+        }
+
+        id = a_node.id;
+        assign_string(name, a_node.name, get_allocator());
+        type = a_node.type;
+        border = a_node.border;
+        current_border_width = a_node.current_border_width;
+        layout = a_node.layout;
+        percent = a_node.percent;
+        rect = a_node.rect;
+        window_rect = a_node.window_rect;
+        deco_rect = a_node.deco_rect;
+        geometry = a_node.geometry;
+        window = a_node.window;
+        assign_window(window_properties, a_node.window_properties, get_allocator());
+        is_urgent = a_node.is_urgent;
+        is_focused = a_node.is_focused;
+        focus = a_node.focus;
+        fullscreen_mode = a_node.fullscreen_mode;
+        marks = a_node.marks;
+        nodes = a_node.nodes;
+        floating_nodes = a_node.floating_nodes;
+
+        return *this;
+    }
+
+    node& node::operator=(node&& a_node)
+    {
+        // Cover self-assignment.
+        if (this == &a_node)
+        {
+            return *this;
+        }
+
+        id = a_node.id;
+        assign_string(name, std::move(a_node.name), get_allocator());
+        type = a_node.type;
+        border = a_node.border;
+        current_border_width = a_node.current_border_width;
+        layout = a_node.layout;
+        percent = a_node.percent;
+        rect = a_node.rect;
+        window_rect = a_node.window_rect;
+        deco_rect = a_node.deco_rect;
+        geometry = a_node.geometry;
+        window = a_node.window;
+        assign_window(window_properties, std::move(a_node.window_properties), get_allocator());
+        is_urgent = a_node.is_urgent;
+        is_focused = a_node.is_focused;
+        focus = std::move(a_node.focus);
+        fullscreen_mode = a_node.fullscreen_mode;
+        marks = std::move(a_node.marks);
+        nodes = std::move(a_node.nodes);
+        floating_nodes = std::move(a_node.floating_nodes);
+
+        return *this;
+    }
+
+    node::allocator_type node::get_allocator() const
+    {
+        return focus.get_allocator();
+    }
+} // i3_containers::pmr namespace
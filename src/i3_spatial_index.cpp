@@ -0,0 +1,277 @@
+/*
+    Copyright (C) 2019, Ivan Balević
+
+    This file is part of "i3-ipc++" library.
+
+    "i3-ipc++" is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    "i3-ipc++" is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with "i3-ipc++". If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+ * \file    i3_spatial_index.cpp
+ *
+ * \brief   Defines member functions of "i3_containers::spatial_index" class.
+ */
+
+// Library headers.
+#include "i3_spatial_index.hpp"
+#include "i3_containers.hpp"
+
+// C++ headers.
+#include <vector>
+#include <algorithm>
+
+// C headers.
+#include <cstddef>
+#include <cstdint>
+
+namespace
+{
+    /**
+     * \brief               Checks whether two rectangles overlap.
+     *
+     * \param [in] a_first  First rectangle.
+     *
+     * \param [in] a_second Second rectangle.
+     *
+     * \return              True if they have at least one common pixel, false otherwise.
+     */
+    bool overlap(const i3_containers::rectangle& a_first, const i3_containers::rectangle& a_second)
+    {
+        // NOTE: Coordinates are widened, since the end of rectangle doesn't have to fit into 16 bits.
+        return std::uint32_t{ a_first.x } < std::uint32_t{ a_second.x } + a_second.width
+               && std::uint32_t{ a_second.x } < std::uint32_t{ a_first.x } + a_first.width
+               && std::uint32_t{ a_first.y } < std::uint32_t{ a_second.y } + a_second.height
+               && std::uint32_t{ a_second.y } < std::uint32_t{ a_first.y } + a_first.height;
+    }
+} // Unnamed namespace.
+
+namespace i3_containers
+{
+    template<typename Function>
+    void spatial_index::for_each_cell(const rectangle& a_rect, const Function& a_call)
+    {
+        const unsigned first_column = unsigned{ a_rect.x } >> cell_size_bits;
+        const unsigned first_row = unsigned{ a_rect.y } >> cell_size_bits;
+        const unsigned last_column = (unsigned{ a_rect.x } + a_rect.width - 1) >> cell_size_bits;
+        const unsigned last_row = (unsigned{ a_rect.y } + a_rect.height - 1) >> cell_size_bits;
+        for (unsigned column = first_column; column <= last_column; ++column)
+        {
+            for (unsigned row = first_row; row <= last_row; ++row)
+            {
+                a_call(static_cast<cell>(column << 16 | row));
+            }
+        }
+    }
+
+    spatial_index::spatial_index() : m_ids(), m_rects(), m_free_slots(), m_slots(), m_cells()
+    {
+    }
+
+    spatial_index::spatial_index(const node& a_tree) : spatial_index()
+    {
+        insert_visible(a_tree);
+    }
+
+    void spatial_index::insert_visible(const node& a_node)
+    {
+        if (a_node.window)
+        {
+            insert(a_node);
+        }
+
+        // Only the most recently focused tiling child is shown by tabbed and stacked containers, as well as by
+        // the content container of an output, whose children are workspaces.
+        const bool is_content = !a_node.nodes.empty() && a_node.nodes.front().type == node_type::workspace;
+        if (a_node.layout == node_layout::tabbed || a_node.layout == node_layout::stacked || is_content)
+        {
+            for (const std::uint64_t id : a_node.focus)
+            {
+                const auto child = std::find_if(a_node.nodes.begin(), a_node.nodes.end(),
+                                                [id](const node& a_child) -> bool
+                                                {
+                                                    return a_child.id == id;
+                                                });
+                if (child != a_node.nodes.end())
+                {
+                    insert_visible(*child);
+                    break;
+                }
+            }
+        }
+        else
+        {
+            for (const node& child : a_node.nodes)
+            {
+                // NOTE: Internal "__i3" output holds the scratchpad, which is never shown.
+                if (child.type != node_type::output || child.name != "__i3")
+                {
+                    insert_visible(child);
+                }
+            }
+        }
+
+        for (const node& child : a_node.floating_nodes)
+        {
+            insert_visible(child);
+        }
+    }
+
+    void spatial_index::insert(const node& a_window)
+    {
+        // Moved window gets new cells, so its old ones are cleared first.
+        erase(a_window.id);
+
+        // NOTE: Window with empty rectangle (e.g. not mapped yet) can't contain any point, so it is not indexed.
+        if (!a_window.window || a_window.rect.width == 0 || a_window.rect.height == 0)
+        {
+            return;
+        }
+
+        std::uint32_t slot;
+        if (m_free_slots.empty())
+        {
+            slot = static_cast<std::uint32_t>(m_ids.size());
+            m_ids.emplace_back();
+            m_rects.emplace_back();
+        }
+        else
+        {
+            slot = m_free_slots.back();
+            m_free_slots.pop_back();
+        }
+
+        m_ids[slot] = a_window.id;
+        m_rects[slot] = a_window.rect;
+        m_slots.emplace(a_window.id, slot);
+        for_each_cell(a_window.rect, [this, slot](cell a_cell) -> void
+                                     {
+                                         m_cells[a_cell].push_back(slot);
+                                     });
+    }
+
+    void spatial_index::erase(std::uint64_t a_id)
+    {
+        const auto slot_iterator = m_slots.find(a_id);
+        if (slot_iterator == m_slots.end())
+        {
+            return;
+        }
+
+        // NOTE: Order of slots in a cell doesn't matter, so the slot is removed by swapping it with the last one.
+        const std::uint32_t slot = slot_iterator->second;
+        for_each_cell(m_rects[slot], [this, slot](cell a_cell) -> void
+                                     {
+                                         const auto cell_iterator = m_cells.find(a_cell);
+                                         std::vector<std::uint32_t>& slots = cell_iterator->second;
+                                         *std::find(slots.begin(), slots.end(), slot) = slots.back();
+                                         slots.pop_back();
+                                         if (slots.empty())
+                                         {
+                                             m_cells.erase(cell_iterator);
+                                         }
+                                     });
+
+        m_ids[slot] = 0;
+        m_rects[slot] = rectangle{ };
+        m_free_slots.push_back(slot);
+        m_slots.erase(slot_iterator);
+    }
+
+    void spatial_index::handle_event(const window_event& a_event)
+    {
+        // NOTE: Tiling siblings which are resized by the change don't get their own events, so the index of a
+        //       tiling layout has to be rebuilt from new tree when exact rectangles of all windows are needed.
+        switch (a_event.change)
+        {
+            case window_change::create:
+            case window_change::move:
+            case window_change::floating:
+                insert(a_event.container);
+                break;
+
+            case window_change::close:
+                erase(a_event.container.id);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    std::vector<std::uint64_t> spatial_index::find_at(std::uint16_t a_x, std::uint16_t a_y) const
+    {
+        const auto cell_iterator = m_cells.find(static_cast<cell>((a_x >> cell_size_bits) << 16
+                                                                  | (a_y >> cell_size_bits)));
+        if (cell_iterator == m_cells.end())
+        {
+            return { };
+        }
+
+        const rectangle point = { a_x, a_y, 1, 1 };
+        std::vector<std::uint64_t> ids;
+        for (const std::uint32_t slot : cell_iterator->second)
+        {
+            if (overlap(m_rects[slot], point))
+            {
+                ids.push_back(m_ids[slot]);
+            }
+        }
+
+        return ids;
+    }
+
+    std::vector<std::uint64_t> spatial_index::find_in(const rectangle& a_region) const
+    {
+        if (a_region.width == 0 || a_region.height == 0)
+        {
+            return { };
+        }
+
+        std::vector<std::uint64_t> ids;
+        for_each_cell(a_region, [this, &a_region, &ids](cell a_cell) -> void
+                                {
+                                    const auto cell_iterator = m_cells.find(a_cell);
+                                    if (cell_iterator == m_cells.end())
+                                    {
+                                        return;
+                                    }
+
+                                    for (const std::uint32_t slot : cell_iterator->second)
+                                    {
+                                        const rectangle& rect = m_rects[slot];
+                                        if (!overlap(rect, a_region))
+                                        {
+                                            continue;
+                                        }
+
+                                        // NOTE: Window spanning several cells of the region is reported only from
+                                        //       the cell which holds the top left corner of their intersection.
+                                        const unsigned x = std::max(rect.x, a_region.x);
+                                        const unsigned y = std::max(rect.y, a_region.y);
+                                        if (static_cast<cell>((x >> cell_size_bits) << 16 | (y >> cell_size_bits))
+                                            == a_cell)
+                                        {
+                                            ids.push_back(m_ids[slot]);
+                                        }
+                                    }
+                                });
+
+        return ids;
+    }
+
+    std::size_t spatial_index::size() const
+    {
+        return m_slots.size();
+    }
+} // i3_containers namespace
@@ -0,0 +1,74 @@
+/*
+    Copyright (C) 2019, Ivan Balević
+
+    This file is part of "i3-ipc++" library.
+
+    "i3-ipc++" is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    "i3-ipc++" is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with "i3-ipc++". If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+ * \file    i3_string_pool.cpp
+ *
+ * \brief   Defines member functions of "i3_containers::string_pool" class.
+ */
+
+// Library headers.
+#include "i3_string_pool.hpp"
+
+// C++ headers.
+#include <mutex>
+#include <string>
+#include <string_view>
+
+// C headers.
+#include <cstddef>
+
+namespace i3_containers
+{
+    string_pool::string_pool() : m_mutex(), m_strings(), m_index()
+    {
+    }
+
+    std::string_view string_pool::intern(std::string_view a_string)
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+
+        const auto interned = m_index.find(a_string);
+        if (interned != m_index.end())
+        {
+            return *interned;
+        }
+
+        // NOTE: Deque never moves its elements on insertion at the end, so the characters of every interned string
+        //       (including short strings stored inside of the string object) stay where they are.
+        const std::string_view string = m_strings.emplace_back(a_string);
+        try
+        {
+            m_index.insert(string);
+        }
+        catch (...)
+        {
+            m_strings.pop_back();
+            throw;
+        }
+
+        return string;
+    }
+
+    std::size_t string_pool::size() const
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        return m_strings.size();
+    }
+} // i3_containers namespace
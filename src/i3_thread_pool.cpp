@@ -0,0 +1,121 @@
+/*
+    Copyright (C) 2019, Ivan Balević
+
+    This file is part of "i3-ipc++" library.
+
+    "i3-ipc++" is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    "i3-ipc++" is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with "i3-ipc++". If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+ * \file    i3_thread_pool.cpp
+ *
+ * \brief   Contains the implementation of the member functions of "i3_thread_pool" class.
+ */
+
+// Library headers.
+#include "i3_thread_pool.hpp"
+
+// C++ headers.
+#include <mutex>
+#include <future>
+#include <thread>
+#include <utility>
+#include <functional>
+
+// C headers.
+#include <cstddef>
+
+i3_thread_pool::i3_thread_pool(std::size_t a_workers) : m_mutex(),
+                                                        m_condition(),
+                                                        m_tasks(),
+                                                        m_is_stopping(false),
+                                                        m_workers()
+{
+    m_workers.reserve(a_workers);
+    try
+    {
+        for (std::size_t i = 0; i < a_workers; ++i)
+        {
+            m_workers.emplace_back(&i3_thread_pool::work, this);
+        }
+    }
+    catch (...)
+    {
+        // Workers that were already started must be joined, since destructor isn't called.
+        stop();
+        throw;
+    }
+}
+
+i3_thread_pool::~i3_thread_pool()
+{
+    stop();
+}
+
+std::size_t i3_thread_pool::get_workers() const
+{
+    return m_workers.size();
+}
+
+std::future<void> i3_thread_pool::submit(std::function<void()> a_task)
+{
+    std::packaged_task<void()> task(std::move(a_task));
+    std::future<void> result = task.get_future();
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+    }
+    m_condition.notify_one();
+
+    return result;
+}
+
+void i3_thread_pool::work()
+{
+    while (true)
+    {
+        std::packaged_task<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() -> bool { return m_is_stopping || !m_tasks.empty(); });
+
+            // NOTE: Queued tasks are finished even when stopping, since someone may be waiting for their futures.
+            if (m_tasks.empty())
+            {
+                return;
+            }
+
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+
+        // Exception thrown by the task is stored in its future.
+        task();
+    }
+}
+
+void i3_thread_pool::stop()
+{
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_is_stopping = true;
+    }
+    m_condition.notify_all();
+
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+    m_workers.clear();
+}
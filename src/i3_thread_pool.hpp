@@ -0,0 +1,106 @@
+/*
+    Copyright (C) 2019, Ivan Balević
+
+    This file is part of "i3-ipc++" library.
+
+    "i3-ipc++" is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    "i3-ipc++" is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with "i3-ipc++". If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+ * \file    i3_thread_pool.hpp
+ *
+ * \brief   Defines "i3_thread_pool" class which runs tasks on a fixed set of worker threads.
+ */
+
+#ifndef I3_THREAD_POOL_HPP
+#define I3_THREAD_POOL_HPP
+
+// C++ headers.
+#include <deque>
+#include <mutex>
+#include <future>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <condition_variable>
+
+// C headers.
+#include <cstddef>
+
+/**
+ * \brief   Fixed set of worker threads which run submitted tasks in the order of submission.<br>
+ *          Threads are started once by the constructor and reused for every task, until the pool is destroyed.
+ */
+class i3_thread_pool
+{
+
+public:
+
+    /**
+     * \brief                       Constructor which starts the worker threads.
+     *
+     * \param [in] a_workers        Number of worker threads.
+     *
+     * \throws std::system_error    When system error occurs while starting a thread.
+     */
+    explicit i3_thread_pool(std::size_t a_workers);
+
+    /// \cond DO_NOT_DOCUMENT
+    i3_thread_pool(const i3_thread_pool& a_pool) = delete;
+    i3_thread_pool& operator=(const i3_thread_pool& a_pool) = delete;
+    /// \endcond
+
+    /**
+     * \brief   Destructor which lets the workers finish already submitted tasks and joins them.
+     */
+    ~i3_thread_pool();
+
+    /**
+     * \brief    Returns the number of worker threads.
+     *
+     * \return   Number of worker threads.
+     */
+    std::size_t get_workers() const;
+
+    /**
+     * \brief               Queues the task for one of the worker threads.
+     *
+     * \param [in] a_task   Task which will be run.
+     *
+     * \return              Future which becomes ready once the task is finished and which rethrows the exception
+     *                      thrown by the task, if any.
+     */
+    std::future<void> submit(std::function<void()> a_task);
+
+private:
+
+    /**
+     * \brief   Runs queued tasks until the pool is destroyed.
+     */
+    void work();
+
+    /**
+     * \brief   Lets the workers finish already submitted tasks and joins them.
+     */
+    void stop();
+
+    std::mutex m_mutex;                             /**< Mutex which guards the queue and the stop flag. */
+    std::condition_variable m_condition;            /**< Condition signaled when task or stop is queued. */
+    std::deque<std::packaged_task<void()>> m_tasks; /**< Tasks waiting for a worker.                     */
+    bool m_is_stopping;                             /**< Whether the workers should stop once idle.      */
+    std::vector<std::thread> m_workers;             /**< Worker threads.                                 */
+
+}; // class i3_thread_pool
+
+#endif // I3_THREAD_POOL_HPP
@@ -0,0 +1,390 @@
+/*
+    Copyright (C) 2019, Ivan Balević
+
+    This file is part of "i3-ipc++" library.
+
+    "i3-ipc++" is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    "i3-ipc++" is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with "i3-ipc++". If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+ * \file    i3_tree_diff.cpp
+ *
+ * \brief   Defines "i3_containers::tree_diff" function.
+ */
+
+// Library headers.
+#include "i3_tree_diff.hpp"
+#include "i3_containers.hpp"
+#include "i3_hashed_tree.hpp"
+
+// C++ headers.
+#include <vector>
+#include <optional>
+#include <unordered_map>
+
+// C headers.
+#include <cstddef>
+#include <cstdint>
+
+namespace
+{
+    /**
+     * \brief   Structure used to store one node of the old tree in the index.
+     */
+    struct indexed_node
+    {
+        const i3_containers::node* node; /**< Node of the old tree.                       */
+        std::uint64_t parent_id;         /**< ID of its parent, 0 for the root.           */
+        bool is_matched;                 /**< Whether the new tree has node with same ID. */
+    };
+
+    /**
+     * \brief   Type used to find the nodes of the old tree by their IDs.
+     */
+    using tree_index = std::unordered_map<std::uint64_t, indexed_node>;
+
+    /**
+     * \brief               Counts all nodes in given tree.
+     *
+     * \param [in] a_node   Root node of the tree.
+     *
+     * \return              Number of nodes in the tree, including the root.
+     */
+    std::size_t count_nodes(const i3_containers::node& a_node)
+    {
+        std::size_t count = 1;
+        for (const auto& child_node : a_node.nodes)
+        {
+            count += count_nodes(child_node);
+        }
+        for (const auto& floating_node : a_node.floating_nodes)
+        {
+            count += count_nodes(floating_node);
+        }
+
+        return count;
+    }
+
+    /**
+     * \brief                   Adds every node of given tree to the index.
+     *
+     * \param [in] a_node       Root node of the tree.
+     *
+     * \param [in] a_parent_id  ID of the parent of "a_node", 0 for the root.
+     *
+     * \param [out] a_index     Index to which the nodes are added.
+     */
+    void index_nodes(const i3_containers::node& a_node, std::uint64_t a_parent_id, tree_index& a_index)
+    {
+        a_index.emplace(a_node.id, indexed_node{ &a_node, a_parent_id, false });
+        for (const auto& child_node : a_node.nodes)
+        {
+            index_nodes(child_node, a_node.id, a_index);
+        }
+        for (const auto& floating_node : a_node.floating_nodes)
+        {
+            index_nodes(floating_node, a_node.id, a_index);
+        }
+    }
+
+    /**
+     * \brief               Compares two rectangles.
+     *
+     * \param [in] a_first  First rectangle.
+     *
+     * \param [in] a_second Second rectangle.
+     *
+     * \return              True if rectangles are equal, false otherwise.
+     */
+    bool are_equal(const i3_containers::rectangle& a_first, const i3_containers::rectangle& a_second)
+    {
+        return a_first.x == a_second.x && a_first.y == a_second.y
+               && a_first.width == a_second.width && a_first.height == a_second.height;
+    }
+
+    /**
+     * \brief               Compares two optional sets of X11 window properties.
+     *
+     * \param [in] a_first  First window properties.
+     *
+     * \param [in] a_second Second window properties.
+     *
+     * \return              True if window properties are equal, false otherwise.
+     */
+    bool are_equal(const std::optional<i3_containers::x11_window>& a_first,
+                   const std::optional<i3_containers::x11_window>& a_second)
+    {
+        if (!a_first || !a_second)
+        {
+            return a_first.has_value() == a_second.has_value();
+        }
+
+        return a_first->window_class == a_second->window_class
+               && a_first->window_instance == a_second->window_instance
+               && a_first->window_role == a_second->window_role
+               && a_first->window_title == a_second->window_title
+               && a_first->transient_for == a_second->transient_for;
+    }
+
+    /**
+     * \brief               Compares the fields of two nodes, ignoring their child nodes.
+     *
+     * \param [in] a_old    Node from the old tree.
+     *
+     * \param [in] a_new    Node from the new tree.
+     *
+     * \return              Mask of "i3_containers::node_change::field" flags of the fields which differ.
+     */
+    std::uint32_t compare_fields(const i3_containers::node& a_old, const i3_containers::node& a_new)
+    {
+        using change = i3_containers::node_change;
+
+        std::uint32_t changed_fields = 0;
+        const auto compare = [&](bool a_is_equal, change::field a_field) -> void
+        {
+            if (!a_is_equal)
+            {
+                changed_fields |= a_field;
+            }
+        };
+
+        compare(a_old.name == a_new.name, change::name_field);
+        compare(a_old.type == a_new.type, change::type_field);
+        compare(a_old.border == a_new.border, change::border_field);
+        compare(a_old.current_border_width == a_new.current_border_width, change::current_border_width_field);
+        compare(a_old.layout == a_new.layout, change::layout_field);
+        compare(a_old.percent == a_new.percent, change::percent_field);
+        compare(are_equal(a_old.rect, a_new.rect), change::rect_field);
+        compare(are_equal(a_old.window_rect, a_new.window_rect), change::window_rect_field);
+        compare(are_equal(a_old.deco_rect, a_new.deco_rect), change::deco_rect_field);
+        compare(are_equal(a_old.geometry, a_new.geometry), change::geometry_field);
+        compare(a_old.window == a_new.window, change::window_field);
+        compare(are_equal(a_old.window_properties, a_new.window_properties), change::window_properties_field);
+        compare(a_old.is_urgent == a_new.is_urgent, change::urgent_field);
+        compare(a_old.is_focused == a_new.is_focused, change::focused_field);
+        compare(a_old.focus == a_new.focus, change::focus_field);
+        compare(a_old.fullscreen_mode == a_new.fullscreen_mode, change::fullscreen_mode_field);
+        compare(a_old.marks == a_new.marks, change::marks_field);
+
+        return changed_fields;
+    }
+
+    /**
+     * \brief                   Finds added, reparented and changed nodes in the subtree of the new tree.
+     *
+     * \param [in] a_node       Root node of the subtree of the new tree.
+     *
+     * \param [in] a_parent_id  ID of the parent of "a_node", 0 for the root.
+     *
+     * \param [in,out] a_index  Index of the old tree, whose matched nodes are marked.
+     *
+     * \param [out] a_changes   List to which the changes are appended.
+     */
+    void diff_new_nodes(const i3_containers::node& a_node,
+                        std::uint64_t a_parent_id,
+                        tree_index& a_index,
+                        std::vector<i3_containers::node_change>& a_changes)
+    {
+        using change = i3_containers::node_change;
+
+        const auto old_node = a_index.find(a_node.id);
+        if (old_node == a_index.end() || old_node->second.is_matched)
+        {
+            // NOTE: Duplicate ID in the new tree can't be matched twice, so it is reported as added.
+            a_changes.push_back(change{ change::type::added, a_node.id, a_parent_id, 0, 0 });
+        }
+        else
+        {
+            old_node->second.is_matched = true;
+
+            const std::uint32_t changed_fields = compare_fields(*old_node->second.node, a_node);
+            const std::uint64_t old_parent_id = old_node->second.parent_id;
+            if (old_parent_id != a_parent_id)
+            {
+                a_changes.push_back(change{ change::type::reparented, a_node.id, a_parent_id, old_parent_id,
+                                            changed_fields });
+            }
+            else if (changed_fields != 0)
+            {
+                a_changes.push_back(change{ change::type::changed, a_node.id, a_parent_id, 0, changed_fields });
+            }
+        }
+
+        for (const auto& child_node : a_node.nodes)
+        {
+            diff_new_nodes(child_node, a_node.id, a_index, a_changes);
+        }
+        for (const auto& floating_node : a_node.floating_nodes)
+        {
+            diff_new_nodes(floating_node, a_node.id, a_index, a_changes);
+        }
+    }
+
+    /**
+     * \brief                   Finds removed nodes in the subtree of the old tree.
+     *
+     * \param [in] a_node       Root node of the subtree of the old tree.
+     *
+     * \param [in] a_parent_id  ID of the parent of "a_node", 0 for the root.
+     *
+     * \param [in] a_index      Index of the old tree, with matched nodes marked.
+     *
+     * \param [out] a_changes   List to which the changes are appended.
+     */
+    void diff_old_nodes(const i3_containers::node& a_node,
+                        std::uint64_t a_parent_id,
+                        const tree_index& a_index,
+                        std::vector<i3_containers::node_change>& a_changes)
+    {
+        using change = i3_containers::node_change;
+
+        // NOTE: Only the first of nodes with duplicate IDs is in the index, so the node itself has to match as well.
+        const auto old_node = a_index.find(a_node.id);
+        if (old_node->second.node != &a_node || !old_node->second.is_matched)
+        {
+            a_changes.push_back(change{ change::type::removed, a_node.id, a_parent_id, 0, 0 });
+        }
+
+        for (const auto& child_node : a_node.nodes)
+        {
+            diff_old_nodes(child_node, a_node.id, a_index, a_changes);
+        }
+        for (const auto& floating_node : a_node.floating_nodes)
+        {
+            diff_old_nodes(floating_node, a_node.id, a_index, a_changes);
+        }
+    }
+
+    /**
+     * \brief   Enumeration of the states of old nodes while the hashed trees are compared.
+     */
+    enum class match_state : std::uint8_t
+    {
+        unmatched,      /**< New tree has no node with the same ID (yet).                    */
+        matched,        /**< New tree has node with the same ID.                             */
+        matched_subtree /**< New tree has the same subtree, so none of its nodes is removed. */
+    };
+
+    /**
+     * \brief                     Finds added, reparented and changed nodes in the subtree of the new hashed tree.
+     *
+     * \param [in] a_old          Old tree.
+     *
+     * \param [in] a_new          New tree.
+     *
+     * \param [in] a_position     Position of the root of the subtree in the flat index of the new tree.
+     *
+     * \param [in,out] a_states   State of every entry of the old tree.
+     *
+     * \param [out] a_changes     List to which the changes are appended.
+     *
+     * \return                    Position after the subtree in the flat index of the new tree.
+     */
+    std::size_t diff_new_entries(const i3_containers::hashed_tree& a_old,
+                                 const i3_containers::hashed_tree& a_new,
+                                 std::size_t a_position,
+                                 std::vector<match_state>& a_states,
+                                 std::vector<i3_containers::node_change>& a_changes)
+    {
+        using change = i3_containers::node_change;
+
+        const i3_containers::hashed_tree::entry& new_entry = a_new.get_entries()[a_position];
+        const i3_containers::node& new_node = *new_entry.tree_node;
+
+        const std::optional<std::size_t> old_position = a_old.find(new_node.id);
+        if (!old_position || a_states[*old_position] != match_state::unmatched)
+        {
+            a_changes.push_back(change{ change::type::added, new_node.id, new_entry.parent_id, 0, 0 });
+        }
+        else
+        {
+            const i3_containers::hashed_tree::entry& old_entry = a_old.get_entries()[*old_position];
+            if (old_entry.hash == new_entry.hash && old_entry.parent_id == new_entry.parent_id)
+            {
+                // Whole subtree is the same, so neither the node nor any of its descendants has changed.
+                a_states[*old_position] = match_state::matched_subtree;
+                return new_entry.subtree_end;
+            }
+
+            a_states[*old_position] = match_state::matched;
+
+            const std::uint32_t changed_fields = compare_fields(*old_entry.tree_node, new_node);
+            if (old_entry.parent_id != new_entry.parent_id)
+            {
+                a_changes.push_back(change{ change::type::reparented, new_node.id, new_entry.parent_id,
+                                            old_entry.parent_id, changed_fields });
+            }
+            else if (changed_fields != 0)
+            {
+                a_changes.push_back(change{ change::type::changed, new_node.id, new_entry.parent_id, 0,
+                                            changed_fields });
+            }
+        }
+
+        std::size_t position = a_position + 1;
+        while (position < new_entry.subtree_end)
+        {
+            position = diff_new_entries(a_old, a_new, position, a_states, a_changes);
+        }
+
+        return position;
+    }
+} // Unnamed namespace.
+
+namespace i3_containers
+{
+    std::vector<node_change> tree_diff(const node& a_old, const node& a_new)
+    {
+        tree_index index;
+        index.reserve(count_nodes(a_old));
+        index_nodes(a_old, 0, index);
+
+        std::vector<node_change> changes;
+        diff_new_nodes(a_new, 0, index, changes);
+        diff_old_nodes(a_old, 0, index, changes);
+
+        return changes;
+    }
+
+    std::vector<node_change> tree_diff(const hashed_tree& a_old, const hashed_tree& a_new)
+    {
+        const std::vector<hashed_tree::entry>& old_entries = a_old.get_entries();
+        std::vector<match_state> states(old_entries.size(), match_state::unmatched);
+
+        std::vector<node_change> changes;
+        diff_new_entries(a_old, a_new, 0, states, changes);
+
+        // Removed nodes are found in the flat index, jumping over the subtrees that are the same in both trees.
+        std::size_t position = 0;
+        while (position < old_entries.size())
+        {
+            const hashed_tree::entry& old_entry = old_entries[position];
+            if (states[position] == match_state::matched_subtree)
+            {
+                position = old_entry.subtree_end;
+                continue;
+            }
+
+            // NOTE: Only the first of nodes with duplicate IDs is in the index, so the others are never matched.
+            if (states[position] == match_state::unmatched)
+            {
+                changes.push_back(node_change{ node_change::type::removed, old_entry.tree_node->id,
+                                               old_entry.parent_id, 0, 0 });
+            }
+            ++position;
+        }
+
+        return changes;
+    }
+} // i3_containers namespace
@@ -0,0 +1,310 @@
+/*
+    Copyright (C) 2019, Ivan Balević
+
+    This file is part of "i3-ipc++" library.
+
+    "i3-ipc++" is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    "i3-ipc++" is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with "i3-ipc++". If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+ * \file    i3_tree_iterator.cpp
+ *
+ * \brief   Defines member functions of "i3_containers::tree_iterator" and "i3_containers::tree_range" classes.
+ */
+
+// Library headers.
+#include "i3_tree_iterator.hpp"
+#include "i3_containers.hpp"
+
+// C++ headers.
+#include <vector>
+#include <algorithm>
+
+// C headers.
+#include <cstddef>
+#include <cstdint>
+
+namespace
+{
+    /**
+     * \brief               Returns the number of children of the node.
+     *
+     * \param [in] a_node   Node whose children are counted.
+     *
+     * \return              Number of tiling and floating children.
+     */
+    std::size_t count_children(const i3_containers::node& a_node)
+    {
+        return a_node.nodes.size() + a_node.floating_nodes.size();
+    }
+
+    /**
+     * \brief                  Returns the child of the node at given position.
+     *
+     * \param [in] a_node      Parent node.
+     *
+     * \param [in] a_position  Position of the child, counting tiling children first and floating children after.
+     *
+     * \return                 Child at given position.
+     */
+    const i3_containers::node& get_child(const i3_containers::node& a_node, std::size_t a_position)
+    {
+        return a_position < a_node.nodes.size() ? a_node.nodes[a_position]
+                                                : a_node.floating_nodes[a_position - a_node.nodes.size()];
+    }
+
+    /**
+     * \brief               Finds the child of the node with given ID.
+     *
+     * \param [in] a_node   Parent node.
+     *
+     * \param [in] a_id     ID of the child.
+     *
+     * \return              Child with given ID, or null if there is no such child.
+     */
+    const i3_containers::node* find_child(const i3_containers::node& a_node, std::uint64_t a_id)
+    {
+        for (std::size_t position = 0; position < count_children(a_node); ++position)
+        {
+            if (get_child(a_node, position).id == a_id)
+            {
+                return &get_child(a_node, position);
+            }
+        }
+
+        return nullptr;
+    }
+} // Unnamed namespace.
+
+namespace i3_containers
+{
+    tree_iterator::tree_iterator()
+        : m_frames(), m_deep_frames(), m_size(0), m_current(nullptr), m_root(nullptr), m_level(0), m_has_deeper(false),
+          m_order(tree_order::pre_order)
+    {
+    }
+
+    tree_iterator::tree_iterator(const node& a_tree, tree_order a_order) : tree_iterator()
+    {
+        m_root = &a_tree;
+        m_order = a_order;
+        push(m_root);
+        m_current = m_root;
+
+        switch (m_order)
+        {
+            case tree_order::post_order:
+                descend_post_order();
+                break;
+
+            case tree_order::breadth_first:
+                m_has_deeper = count_children(a_tree) != 0;
+                break;
+
+            case tree_order::leaf_windows:
+                if (!a_tree.window)
+                {
+                    ++*this;
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    tree_iterator& tree_iterator::operator++()
+    {
+        switch (m_order)
+        {
+            case tree_order::post_order:
+                pop();
+                if (m_size == 0)
+                {
+                    m_current = nullptr;
+                }
+                else
+                {
+                    descend_post_order();
+                }
+                break;
+
+            case tree_order::breadth_first:
+                next_breadth_first();
+                break;
+
+            case tree_order::leaf_windows:
+                do
+                {
+                    next_pre_order();
+                }
+                while (m_current && !m_current->window);
+                break;
+
+            default:
+                next_pre_order();
+                break;
+        }
+
+        return *this;
+    }
+
+    tree_iterator tree_iterator::operator++(int)
+    {
+        tree_iterator previous = *this;
+        ++*this;
+
+        return previous;
+    }
+
+    std::size_t tree_iterator::get_depth() const
+    {
+        return m_size - 1;
+    }
+
+    void tree_iterator::push(const node* a_container)
+    {
+        if (m_size < inline_depth)
+        {
+            m_frames[m_size] = frame{ a_container, 0 };
+        }
+        else
+        {
+            m_deep_frames.push_back(frame{ a_container, 0 });
+        }
+        ++m_size;
+    }
+
+    void tree_iterator::pop()
+    {
+        if (m_size > inline_depth)
+        {
+            m_deep_frames.pop_back();
+        }
+        --m_size;
+    }
+
+    tree_iterator::frame& tree_iterator::top()
+    {
+        return m_size > inline_depth ? m_deep_frames.back() : m_frames[m_size - 1];
+    }
+
+    const node* tree_iterator::next_child()
+    {
+        frame& current = top();
+        const node& parent = *current.container;
+        if (m_order != tree_order::focus_order)
+        {
+            return current.next_child < count_children(parent) ? &get_child(parent, current.next_child++) : nullptr;
+        }
+
+        // NOTE: Positions first run through the focus list and then through the children, skipping the ones which
+        //       were already visited through the focus list.
+        const std::vector<std::uint64_t>& focus = parent.focus;
+        while (current.next_child < focus.size())
+        {
+            const node* child = find_child(parent, focus[current.next_child++]);
+            if (child)
+            {
+                return child;
+            }
+        }
+        while (current.next_child < focus.size() + count_children(parent))
+        {
+            const node& child = get_child(parent, current.next_child++ - focus.size());
+            if (std::find(focus.begin(), focus.end(), child.id) == focus.end())
+            {
+                return &child;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void tree_iterator::next_pre_order()
+    {
+        while (m_size != 0)
+        {
+            const node* child = next_child();
+            if (child)
+            {
+                push(child);
+                m_current = child;
+                return;
+            }
+            pop();
+        }
+
+        m_current = nullptr;
+    }
+
+    void tree_iterator::descend_post_order()
+    {
+        for (const node* child = next_child(); child; child = next_child())
+        {
+            push(child);
+        }
+
+        m_current = top().container;
+    }
+
+    void tree_iterator::next_breadth_first()
+    {
+        pop();
+        while (true)
+        {
+            // Current level is exhausted, so the walk starts again from the root, one level deeper.
+            if (m_size == 0)
+            {
+                if (!m_has_deeper)
+                {
+                    m_current = nullptr;
+                    return;
+                }
+                ++m_level;
+                m_has_deeper = false;
+                push(m_root);
+            }
+
+            const node* child = next_child();
+            if (!child)
+            {
+                pop();
+                continue;
+            }
+
+            push(child);
+            if (m_size - 1 == m_level)
+            {
+                m_has_deeper = m_has_deeper || count_children(*child) != 0;
+                m_current = child;
+                return;
+            }
+        }
+    }
+
+    tree_range::tree_range(const node& a_tree, tree_order a_order) : m_tree(&a_tree), m_order(a_order)
+    {
+    }
+
+    tree_iterator tree_range::begin() const
+    {
+        return tree_iterator(*m_tree, m_order);
+    }
+
+    tree_iterator tree_range::end() const
+    {
+        return tree_iterator();
+    }
+} // i3_containers namespace
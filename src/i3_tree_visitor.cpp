@@ -0,0 +1,45 @@
+/*
+    Copyright (C) 2019, Ivan Balević
+
+    This file is part of "i3-ipc++" library.
+
+    "i3-ipc++" is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    "i3-ipc++" is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with "i3-ipc++". If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+ * \file    i3_tree_visitor.cpp
+ *
+ * \brief   Implements default member functions of "i3_tree_visitor" class.
+ */
+
+// Library headers.
+#include "i3_tree_visitor.hpp"
+
+// C++ headers.
+#include <string_view>
+
+bool i3_tree_visitor::enter_node(std::string_view)
+{
+    return true;
+}
+
+bool i3_tree_visitor::field(std::string_view, std::string_view, const value&)
+{
+    return true;
+}
+
+bool i3_tree_visitor::leave_node()
+{
+    return true;
+}
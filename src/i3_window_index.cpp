@@ -0,0 +1,301 @@
+/*
+    Copyright (C) 2019, Ivan Balević
+
+    This file is part of "i3-ipc++" library.
+
+    "i3-ipc++" is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    "i3-ipc++" is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with "i3-ipc++". If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+ * \file    i3_window_index.cpp
+ *
+ * \brief   Defines member functions of "i3_containers::window_index" class.
+ */
+
+// Library headers.
+#include "i3_window_index.hpp"
+#include "i3_containers.hpp"
+#include "i3_tree_iterator.hpp"
+
+// C++ headers.
+#include <string>
+#include <vector>
+#include <optional>
+#include <algorithm>
+#include <string_view>
+
+// C headers.
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+
+namespace
+{
+    /**
+     * \brief   Character which separates the fields in the indexed text. Trigrams never span over it.
+     */
+    constexpr char field_separator = '\n';
+
+    /**
+     * \brief               Converts ASCII letters of the text to lowercase.
+     *
+     * \param [in] a_text   Text to be converted.
+     *
+     * \param [out] a_lower String to which the converted text is appended.
+     */
+    void append_lower(std::string_view a_text, std::string& a_lower)
+    {
+        for (const char character : a_text)
+        {
+            a_lower.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(character))));
+        }
+    }
+
+    /**
+     * \brief               Creates the text of the window which is indexed.
+     *
+     * \param [in] a_window Container of the window.
+     *
+     * \return              Lowercase name, class and title of the window, separated by "field_separator".
+     */
+    std::string make_text(const i3_containers::node& a_window)
+    {
+        std::string text;
+        append_lower(a_window.name.value_or(""), text);
+        if (a_window.window_properties)
+        {
+            text.push_back(field_separator);
+            append_lower(a_window.window_properties->window_class.value_or(""), text);
+            text.push_back(field_separator);
+            append_lower(a_window.window_properties->window_title.value_or(""), text);
+        }
+
+        return text;
+    }
+} // Unnamed namespace.
+
+namespace i3_containers
+{
+    window_index::window_index()
+        : m_ids(), m_texts(), m_trigrams(), m_trigram_counts(), m_free_slots(), m_slots(),
+          m_postings()
+    {
+    }
+
+    window_index::window_index(const node& a_tree) : window_index()
+    {
+        for (const node& window : leaf_windows(a_tree))
+        {
+            insert(window);
+        }
+    }
+
+    void window_index::insert(const node& a_window)
+    {
+        if (!a_window.window)
+        {
+            return;
+        }
+
+        // Updated window keeps its slot, only its trigrams are replaced.
+        erase(a_window.id);
+
+        std::uint32_t slot;
+        if (m_free_slots.empty())
+        {
+            slot = static_cast<std::uint32_t>(m_ids.size());
+            m_ids.emplace_back();
+            m_texts.emplace_back();
+            m_trigrams.emplace_back();
+            m_trigram_counts.emplace_back();
+        }
+        else
+        {
+            slot = m_free_slots.back();
+            m_free_slots.pop_back();
+        }
+
+        m_ids[slot] = a_window.id;
+        m_texts[slot] = make_text(a_window);
+        m_trigrams[slot] = split(m_texts[slot]);
+        m_trigram_counts[slot] = static_cast<float>(m_trigrams[slot].size());
+        m_slots.emplace(a_window.id, slot);
+        for (const trigram key : m_trigrams[slot])
+        {
+            m_postings[key].push_back(slot);
+        }
+    }
+
+    void window_index::erase(std::uint64_t a_id)
+    {
+        const auto slot_iterator = m_slots.find(a_id);
+        if (slot_iterator == m_slots.end())
+        {
+            return;
+        }
+
+        // NOTE: Order of posting lists doesn't matter, so the slot is removed by swapping it with the last one.
+        const std::uint32_t slot = slot_iterator->second;
+        for (const trigram key : m_trigrams[slot])
+        {
+            const auto posting = m_postings.find(key);
+            std::vector<std::uint32_t>& slots = posting->second;
+            *std::find(slots.begin(), slots.end(), slot) = slots.back();
+            slots.pop_back();
+            if (slots.empty())
+            {
+                m_postings.erase(posting);
+            }
+        }
+
+        // Slot is kept for reuse, only its data is cleared.
+        m_ids[slot] = 0;
+        m_texts[slot].clear();
+        m_trigrams[slot].clear();
+        m_trigram_counts[slot] = 0.0f;
+        m_free_slots.push_back(slot);
+        m_slots.erase(slot_iterator);
+    }
+
+    void window_index::handle_event(const window_event& a_event)
+    {
+        switch (a_event.change)
+        {
+            case window_change::create:
+            case window_change::title:
+                insert(a_event.container);
+                break;
+
+            case window_change::close:
+                erase(a_event.container.id);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    std::vector<window_index::match> window_index::search(std::string_view a_query, std::size_t a_limit) const
+    {
+        std::string query;
+        append_lower(a_query, query);
+        const std::vector<trigram> query_trigrams = split(query);
+
+        std::vector<match> matches;
+        if (query_trigrams.empty())
+        {
+            // Too short for trigrams, so every window is checked, but such queries match almost everything anyway.
+            if (query.empty())
+            {
+                return { };
+            }
+            for (const auto& window : m_slots)
+            {
+                const std::string& text = m_texts[window.second];
+                if (text.find(query) != std::string::npos)
+                {
+                    matches.push_back(match{ window.first,
+                                             static_cast<float>(query.size()) / static_cast<float>(text.size()) });
+                }
+            }
+        }
+        else
+        {
+            // Collect the slots of every window which shares a trigram with the query. Each slot appears once per
+            // common trigram, so equal neighbours after sorting give the number of common trigrams.
+            // NOTE: Counting is done in local arrays, so concurrent searches don't share any state.
+            std::vector<std::uint32_t> slots;
+            for (const trigram key : query_trigrams)
+            {
+                const auto posting = m_postings.find(key);
+                if (posting != m_postings.end())
+                {
+                    slots.insert(slots.end(), posting->second.begin(), posting->second.end());
+                }
+            }
+            std::sort(slots.begin(), slots.end());
+
+            std::vector<std::uint32_t> candidates;
+            std::vector<float> common_counts;
+            for (std::size_t i = 0; i < slots.size(); )
+            {
+                const std::size_t first = i;
+                while (i < slots.size() && slots[i] == slots[first])
+                {
+                    ++i;
+                }
+                candidates.push_back(slots[first]);
+                common_counts.push_back(static_cast<float>(i - first));
+            }
+
+            // Jaccard similarity of trigram sets, computed only for the candidates.
+            // NOTE: Scoring is a branch-free loop over contiguous arrays, which the compiler vectorizes.
+            std::vector<float> trigram_counts(candidates.size());
+            for (std::size_t i = 0; i < candidates.size(); ++i)
+            {
+                trigram_counts[i] = m_trigram_counts[candidates[i]];
+            }
+            const float query_count = static_cast<float>(query_trigrams.size());
+            std::vector<float> scores(candidates.size());
+            for (std::size_t i = 0; i < candidates.size(); ++i)
+            {
+                scores[i] = common_counts[i] / (query_count + trigram_counts[i] - common_counts[i]);
+            }
+
+            matches.reserve(candidates.size());
+            for (std::size_t i = 0; i < candidates.size(); ++i)
+            {
+                matches.push_back(match{ m_ids[candidates[i]], scores[i] });
+            }
+        }
+
+        const auto is_better = [](const match& a_first, const match& a_second) -> bool
+        {
+            return a_first.score > a_second.score || (a_first.score == a_second.score && a_first.id < a_second.id);
+        };
+        const std::size_t limit = std::min(a_limit, matches.size());
+        std::partial_sort(matches.begin(), matches.begin() + static_cast<std::ptrdiff_t>(limit), matches.end(),
+                          is_better);
+        matches.resize(limit);
+
+        return matches;
+    }
+
+    std::size_t window_index::size() const
+    {
+        return m_slots.size();
+    }
+
+    std::vector<window_index::trigram> window_index::split(std::string_view a_text)
+    {
+        std::vector<trigram> trigrams;
+        for (std::size_t i = 0; i + 3 <= a_text.size(); ++i)
+        {
+            const std::string_view characters = a_text.substr(i, 3);
+            if (characters.find(field_separator) != std::string_view::npos)
+            {
+                continue;
+            }
+
+            trigrams.push_back(static_cast<trigram>(static_cast<unsigned char>(characters[0])) << 16
+                               | static_cast<trigram>(static_cast<unsigned char>(characters[1])) << 8
+                               | static_cast<trigram>(static_cast<unsigned char>(characters[2])));
+        }
+
+        std::sort(trigrams.begin(), trigrams.end());
+        trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+
+        return trigrams;
+    }
+} // i3_containers namespace
@@ -0,0 +1,329 @@
+/*
+    Copyright (C) 2019, Ivan Balević
+
+    This file is part of "i3-ipc++" library.
+
+    "i3-ipc++" is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    "i3-ipc++" is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with "i3-ipc++". If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+ * \file    i3_workspace_state.cpp
+ *
+ * \brief   Defines member functions of "i3_containers::workspace_state" class.
+ */
+
+// Library headers.
+#include "i3_workspace_state.hpp"
+#include "i3_containers.hpp"
+
+// C++ headers.
+#include <string>
+#include <vector>
+#include <utility>
+#include <optional>
+#include <string_view>
+
+// C headers.
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+
+namespace
+{
+    /**
+     * \brief               Finds the logical number of the workspace, the same way as i3 does.
+     *
+     * \param [in] a_name   Name of the workspace.
+     *
+     * \return              Number from the beginning of the name, or std::nullopt if name doesn't start with one.
+     */
+    std::optional<std::uint8_t> to_workspace_number(std::string_view a_name)
+    {
+        unsigned number = 0;
+        std::size_t digits = 0;
+        for (; digits < a_name.size() && std::isdigit(static_cast<unsigned char>(a_name[digits])) != 0; ++digits)
+        {
+            number = number * 10 + static_cast<unsigned>(a_name[digits] - '0');
+            if (number > UINT8_MAX)
+            {
+                return std::nullopt;
+            }
+        }
+
+        return digits == 0 ? std::nullopt : std::make_optional(static_cast<std::uint8_t>(number));
+    }
+
+    /**
+     * \brief                   Checks whether the rectangle lies inside of another rectangle.
+     *
+     * \param [in] a_outer      Rectangle which should contain "a_inner".
+     *
+     * \param [in] a_inner      Rectangle which is checked.
+     *
+     * \return                  True if every pixel of "a_inner" is inside of "a_outer", false otherwise.
+     */
+    bool contains(const i3_containers::rectangle& a_outer, const i3_containers::rectangle& a_inner)
+    {
+        return a_inner.x >= a_outer.x && a_inner.y >= a_outer.y
+               && unsigned{ a_inner.x } + a_inner.width <= unsigned{ a_outer.x } + a_outer.width
+               && unsigned{ a_inner.y } + a_inner.height <= unsigned{ a_outer.y } + a_outer.height;
+    }
+} // Unnamed namespace.
+
+namespace i3_containers
+{
+    workspace_state::workspace_state(std::vector<workspace> a_workspaces, std::vector<output> a_outputs)
+        : m_workspaces(), m_outputs(), m_visible(), m_urgent(), m_focused()
+    {
+        reset(std::move(a_workspaces), std::move(a_outputs));
+    }
+
+    void workspace_state::reset(std::vector<workspace> a_workspaces, std::vector<output> a_outputs)
+    {
+        m_workspaces.clear();
+        m_outputs.clear();
+        m_visible.clear();
+        m_urgent.clear();
+        m_focused.reset();
+
+        for (output& display : a_outputs)
+        {
+            std::string name = display.name;
+            m_outputs.emplace(std::move(name), std::move(display));
+        }
+        for (workspace& space : a_workspaces)
+        {
+            if (space.is_visible)
+            {
+                m_visible[space.output] = space.id;
+            }
+            if (space.is_focused)
+            {
+                m_focused = space.id;
+            }
+            if (space.is_urgent)
+            {
+                m_urgent.insert(space.id);
+            }
+            m_workspaces.emplace(space.id, std::move(space));
+        }
+    }
+
+    bool workspace_state::handle_event(const workspace_event& a_event)
+    {
+        if (!a_event.current)
+        {
+            return a_event.change != workspace_change::reload && a_event.change != workspace_change::restored;
+        }
+
+        const node& current = *a_event.current;
+        const auto position = m_workspaces.find(current.id);
+        if (position == m_workspaces.end() && a_event.change != workspace_change::init)
+        {
+            // Workspace was created before the snapshot was taken, but after its workspaces were listed.
+            return a_event.change == workspace_change::empty;
+        }
+
+        switch (a_event.change)
+        {
+            case workspace_change::init:
+            {
+                // NOTE: Rectangle of new workspace is usually already laid out on its output, otherwise i3 has
+                //       created it on the focused output.
+                std::optional<std::string> output_name = find_output(current.rect);
+                if (!output_name && m_focused)
+                {
+                    output_name = m_workspaces.at(*m_focused).output;
+                }
+
+                const std::string name = current.name.value_or("");
+                workspace& space = m_workspaces[current.id];
+                space = workspace{ current.id, to_workspace_number(name), name, false, false, current.is_urgent,
+                                   current.rect, output_name.value_or("") };
+                if (space.is_urgent)
+                {
+                    m_urgent.insert(space.id);
+                }
+                return true;
+            }
+
+            case workspace_change::empty:
+                hide(position->second);
+                m_urgent.erase(current.id);
+                if (m_focused == current.id)
+                {
+                    m_focused.reset();
+                }
+                m_workspaces.erase(position);
+                return true;
+
+            case workspace_change::focus:
+                if (m_focused && *m_focused != current.id)
+                {
+                    m_workspaces.at(*m_focused).is_focused = false;
+                }
+                position->second.is_focused = true;
+                m_focused = current.id;
+                show(position->second);
+                return true;
+
+            case workspace_change::rename:
+            {
+                workspace& space = position->second;
+                space.name = current.name.value_or("");
+                space.num = to_workspace_number(space.name);
+                const auto display = m_outputs.find(space.output);
+                if (space.is_visible && display != m_outputs.end())
+                {
+                    display->second.current_workspace = space.name;
+                }
+                return true;
+            }
+
+            case workspace_change::move:
+            {
+                // NOTE: Output which loses visible workspace shows another one, which is not reported by this event,
+                //       so that output has no known visible workspace until the next focus event on it.
+                std::optional<std::string> output_name = find_output(current.rect);
+                if (!output_name)
+                {
+                    return false;
+                }
+
+                workspace& space = position->second;
+                const bool is_shown = space.is_visible || space.is_focused;
+                hide(space);
+                space.output = std::move(*output_name);
+                space.rect = current.rect;
+                if (is_shown)
+                {
+                    show(space);
+                }
+                return true;
+            }
+
+            case workspace_change::urgent:
+                position->second.is_urgent = current.is_urgent;
+                if (current.is_urgent)
+                {
+                    m_urgent.insert(current.id);
+                }
+                else
+                {
+                    m_urgent.erase(current.id);
+                }
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
+    bool workspace_state::handle_event(const output_event&)
+    {
+        return false;
+    }
+
+    const workspace* workspace_state::get_workspace(std::uint64_t a_id) const
+    {
+        const auto position = m_workspaces.find(a_id);
+        return position == m_workspaces.end() ? nullptr : &position->second;
+    }
+
+    const workspace* workspace_state::get_focused_workspace() const
+    {
+        return m_focused ? get_workspace(*m_focused) : nullptr;
+    }
+
+    const workspace* workspace_state::get_visible_workspace(std::string_view a_output) const
+    {
+        // NOTE: Lookup by "std::string_view" needs heterogeneous lookup, which unordered containers get in C++20.
+        const auto visible = m_visible.find(std::string(a_output));
+        return visible == m_visible.end() ? nullptr : get_workspace(visible->second);
+    }
+
+    const std::unordered_set<std::uint64_t>& workspace_state::get_urgent_workspaces() const
+    {
+        return m_urgent;
+    }
+
+    const std::unordered_map<std::uint64_t, workspace>& workspace_state::get_workspaces() const
+    {
+        return m_workspaces;
+    }
+
+    const std::unordered_map<std::string, output>& workspace_state::get_outputs() const
+    {
+        return m_outputs;
+    }
+
+    std::optional<std::string> workspace_state::find_output(const rectangle& a_rect) const
+    {
+        if (a_rect.width == 0 || a_rect.height == 0)
+        {
+            return std::nullopt;
+        }
+
+        for (const auto& display : m_outputs)
+        {
+            if (display.second.is_active && contains(display.second.rect, a_rect))
+            {
+                return display.first;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    void workspace_state::show(workspace& a_workspace)
+    {
+        const auto visible = m_visible.find(a_workspace.output);
+        if (visible != m_visible.end() && visible->second != a_workspace.id)
+        {
+            const auto hidden = m_workspaces.find(visible->second);
+            if (hidden != m_workspaces.end())
+            {
+                hidden->second.is_visible = false;
+            }
+        }
+
+        a_workspace.is_visible = true;
+        m_visible[a_workspace.output] = a_workspace.id;
+        const auto display = m_outputs.find(a_workspace.output);
+        if (display != m_outputs.end())
+        {
+            display->second.current_workspace = a_workspace.name;
+        }
+    }
+
+    void workspace_state::hide(workspace& a_workspace)
+    {
+        if (!a_workspace.is_visible)
+        {
+            return;
+        }
+
+        a_workspace.is_visible = false;
+        const auto visible = m_visible.find(a_workspace.output);
+        if (visible != m_visible.end() && visible->second == a_workspace.id)
+        {
+            m_visible.erase(visible);
+            const auto display = m_outputs.find(a_workspace.output);
+            if (display != m_outputs.end())
+            {
+                display->second.current_workspace.reset();
+            }
+        }
+    }
+} // i3_containers namespace
@@ -0,0 +1,44 @@
+/**
+ * \file    check.hpp
+ *
+ * \brief   Defines "CHECK" macro used by the tests to report failed expectations without stopping the test.
+ */
+
+#ifndef CHECK_HPP
+#define CHECK_HPP
+
+// C++ headers.
+#include <iostream>
+
+// C headers.
+#include <cstdlib>
+
+/**
+ * \brief   Number of failed checks in the test.
+ */
+inline int failed_checks = 0;
+
+/**
+ * \brief   Reports the location and the text of the condition if it is false.
+ */
+#define CHECK(condition)                                                                                 \
+    do                                                                                                   \
+    {                                                                                                    \
+        if (!(condition))                                                                                \
+        {                                                                                                \
+            std::cerr << __FILE__ << ':' << __LINE__ << ": Check failed: " << #condition << std::endl;  \
+            ++failed_checks;                                                                             \
+        }                                                                                                \
+    } while (false)
+
+/**
+ * \brief    Returns exit status of the test.
+ *
+ * \return   EXIT_SUCCESS if every check passed, EXIT_FAILURE otherwise.
+ */
+inline int test_result()
+{
+    return failed_checks == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#endif // CHECK_HPP
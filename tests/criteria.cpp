@@ -0,0 +1,109 @@
+// Test headers.
+#include "check.hpp"
+#include "fake_i3.hpp"
+
+// i3-ipc++ headers.
+#include "i3_ipc.hpp"
+#include "i3_criteria.hpp"
+#include "i3_containers.hpp"
+#include "i3_ipc_invalid_argument.hpp"
+
+// External library headers.
+#include <i3/ipc.h>
+
+// C++ headers.
+#include <vector>
+#include <cstdint>
+#include <string_view>
+
+namespace
+{
+    // Whether parsing of the criteria fails.
+    bool is_rejected(std::string_view a_criteria)
+    {
+        try
+        {
+            i3_containers::criteria parsed(a_criteria);
+        }
+        catch (const i3_ipc_invalid_argument&)
+        {
+            return true;
+        }
+
+        return false;
+    }
+
+    // Whether matching of single container fails.
+    bool is_rejected(const i3_containers::criteria& a_criteria, const i3_containers::node& a_container)
+    {
+        try
+        {
+            a_criteria.matches(a_container);
+        }
+        catch (const i3_ipc_invalid_argument&)
+        {
+            return true;
+        }
+
+        return false;
+    }
+} // Unnamed namespace.
+
+int main()
+{
+    fake_i3 server;
+    server.set_reply(I3_IPC_MESSAGE_TYPE_GET_TREE, read_fixture("tree.json"));
+    i3_ipc i3(server.get_socket_path());
+    const i3_containers::node tree = i3.get_tree();
+
+    using ids = std::vector<std::uint64_t>;
+    const auto find = [&tree](std::string_view a_criteria) -> ids
+    {
+        return i3_containers::criteria(a_criteria).find(tree);
+    };
+
+    // Brackets and surrounding spaces are optional, values are regular expressions, quoted if they contain spaces.
+    CHECK(find("[class=\"^Firefox$\"]") == ids{ 23 });
+    CHECK(find("  class=Firefox  ") == ids{ 23 });
+    CHECK(find("[title=\"Inbox - \"]") == ids{ 31 });
+    CHECK((find("[class=\"[Tt]erm|URxvt\"]") == ids{ 6, 21 }));
+    CHECK(find("[title=\"say \\\"hi\\\"\"]").empty());
+
+    // Every criterion has to match, and criteria other than "con_id" match only containers with X11 window.
+    CHECK(find("[window_role=browser class=Firefox]") == ids{ 23 });
+    CHECK(find("[window_role=browser class=Code]").empty());
+    CHECK(find("[con_mark=left]") == ids{ 21 });
+    CHECK(find("[con_id=24]") == ids{ 24 });
+    CHECK(find("[con_id=__focused__]") == ids{ 24 });
+    CHECK(find("[id=1048581]") == ids{ 31 });
+    CHECK(find("[urgent=latest]") == ids{ 31 });
+
+    // Position in the tree is known while searching the tree.
+    CHECK((find("[workspace=\"^1$\"]") == ids{ 21, 23, 24, 26 }));
+    CHECK(find("[workspace=__i3_scratch]") == ids{ 6 });
+    CHECK((find("[floating]") == ids{ 6, 26 }));
+    CHECK((find("[tiling workspace=\"^1$\"]") == ids{ 21, 23, 24 }));
+    CHECK((find("[all]") == ids{ 6, 12, 21, 23, 24, 26, 31, 43 }));
+
+    // Malformed, empty and unsupported criteria are rejected.
+    CHECK(is_rejected(""));
+    CHECK(is_rejected("[]"));
+    CHECK(is_rejected("[class=Firefox"));
+    CHECK(is_rejected("[class=\"Firefox]"));
+    CHECK(is_rejected("[class]"));
+    CHECK(is_rejected("[class=\"(\"]"));
+    CHECK(is_rejected("[con_id=abc]"));
+    CHECK(is_rejected("[urgent=newest]"));
+    CHECK(is_rejected("[title=__focused__]"));
+    CHECK(is_rejected("[machine=localhost]"));
+
+    // Single container can be matched only against the criteria which don't depend on its position.
+    const i3_containers::node& editor = tree.nodes[1].nodes[1].nodes[0].nodes[1].nodes[1];
+    CHECK(i3_containers::criteria("[class=Code]").matches(editor));
+    CHECK(!i3_containers::criteria("[class=Firefox]").matches(editor));
+    CHECK(is_rejected(i3_containers::criteria("[workspace=1]"), editor));
+    CHECK(is_rejected(i3_containers::criteria("[floating]"), editor));
+    CHECK(is_rejected(i3_containers::criteria("[class=Code tiling]"), editor));
+
+    return test_result();
+}
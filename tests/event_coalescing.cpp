@@ -0,0 +1,109 @@
+// Test headers.
+#include "check.hpp"
+#include "fake_i3.hpp"
+
+// i3-ipc++ headers.
+#include "i3_ipc.hpp"
+#include "i3_containers.hpp"
+
+// External library headers.
+#include <i3/ipc.h>
+
+// C++ headers.
+#include <chrono>
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+namespace
+{
+    const std::vector<std::string> window_events = read_fixture_lines("window_events.jsonl");
+
+    // Title event of the terminal with given title.
+    std::string retitle(const std::string& a_title)
+    {
+        std::string event = window_events[1];
+        const std::string old_title = "~/src/i3-ipc++";
+        for (std::size_t position = event.find(old_title); position != std::string::npos;
+             position = event.find(old_title, position + a_title.size()))
+        {
+            event.replace(position, old_title.size(), a_title);
+        }
+
+        return event;
+    }
+
+    // Burst of title and move events of the same containers, separated by events which are never coalesced.
+    void send_burst(fake_i3& a_server)
+    {
+        for (const std::string& event : { retitle("vim"), window_events[0], retitle("make"), window_events[6],
+                                          window_events[6], retitle("gdb") })
+        {
+            a_server.send_event(I3_IPC_EVENT_WINDOW, event);
+        }
+        a_server.send_event(I3_IPC_EVENT_WORKSPACE, read_fixture_lines("workspace_events.jsonl")[1]);
+    }
+} // Unnamed namespace.
+
+int main()
+{
+    fake_i3 server;
+    i3_ipc i3(server.get_socket_path());
+    std::vector<std::pair<std::uint64_t, std::string>> handled;
+    i3.on_window_event([&handled](const i3_containers::window_event& a_event)
+                       {
+                           handled.emplace_back(a_event.container.id, a_event.container.name.value_or(""));
+                       });
+    std::size_t workspace_events = 0;
+    i3.on_workspace_event([&workspace_events](const i3_containers::workspace_event&)
+                          {
+                              ++workspace_events;
+                          });
+
+    // Every event is handled by default.
+    CHECK(!i3.get_event_coalescing());
+    send_burst(server);
+    for (std::size_t i = 0; i < 7; ++i)
+    {
+        i3.handle_next_event();
+    }
+    CHECK(handled.size() == 6 && workspace_events == 1);
+
+    // Only the latest title and move of each container is kept, in its place among the other events.
+    using expected = std::vector<std::pair<std::uint64_t, std::string>>;
+    i3.set_event_coalescing(std::chrono::milliseconds(0));
+    CHECK(i3.get_event_coalescing() == std::chrono::milliseconds(0));
+    handled.clear();
+    send_burst(server);
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        i3.handle_next_event();
+    }
+    CHECK((handled == expected{ { 23, "Mozilla Firefox" }, { 43, "movie.mkv - mpv" }, { 21, "gdb" } }));
+    CHECK(workspace_events == 2);
+
+    // Batches are coalesced in the same way.
+    handled.clear();
+    send_burst(server);
+    std::size_t batch_size = 0;
+    CHECK(i3.handle_pending_events([&batch_size](const i3_containers::event_batch& a_batch)
+                                   {
+                                       batch_size = a_batch.window_events.size() + a_batch.workspace_events.size();
+                                   }) == 4);
+    CHECK(batch_size == 4 && handled.empty());
+
+    // Burst is bounded by the limits of event queue, so that coalescing can't read more than the queue holds.
+    // Bursts of three events are then coalesced separately, so the title set before the move is kept too.
+    i3.set_event_queue_limits(i3_ipc::event_queue_limits{ 3, 1 << 20, i3_ipc::overflow_policy::block, { } });
+    handled.clear();
+    send_burst(server);
+    for (std::size_t i = 0; i < 5; ++i)
+    {
+        i3.handle_next_event();
+    }
+    CHECK((handled == expected{ { 23, "Mozilla Firefox" }, { 21, "make" }, { 43, "movie.mkv - mpv" }, { 21, "gdb" } }));
+    CHECK(workspace_events == 3);
+
+    return test_result();
+}
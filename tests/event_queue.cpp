@@ -0,0 +1,164 @@
+// Test headers.
+#include "check.hpp"
+#include "fake_i3.hpp"
+
+// i3-ipc++ headers.
+#include "i3_ipc.hpp"
+#include "i3_containers.hpp"
+#include "i3_ipc_queue_overflow.hpp"
+
+// External library headers.
+#include <i3/ipc.h>
+
+// C++ headers.
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+namespace
+{
+    using event_type = i3_ipc::event_type;
+    using overflow_policy = i3_ipc::overflow_policy;
+    using event_queue_limits = i3_ipc::event_queue_limits;
+
+    const std::vector<std::string> window_events = read_fixture_lines("window_events.jsonl");
+    const std::vector<std::string> workspace_events = read_fixture_lines("workspace_events.jsonl");
+
+    // Connection to the fake, which records the container of every handled window event and the current workspace
+    // of every handled workspace event.
+    struct connection
+    {
+        fake_i3 server;
+        i3_ipc i3;
+        std::vector<std::uint64_t> handled;
+
+        explicit connection(const event_queue_limits& a_limits) : server(), i3(server.get_socket_path()), handled()
+        {
+            i3.on_window_event([this](const i3_containers::window_event& a_event)
+                               {
+                                   handled.push_back(a_event.container.id);
+                               });
+            i3.on_workspace_event([this](const i3_containers::workspace_event& a_event)
+                                  {
+                                      handled.push_back(a_event.current ? a_event.current->id : 0);
+                                  });
+            i3.set_event_queue_limits(a_limits);
+        }
+
+        // Events which come before the response of a request are queued.
+        void queue_window_events(std::size_t a_first, std::size_t a_last)
+        {
+            for (std::size_t i = a_first; i < a_last; ++i)
+            {
+                server.send_event(I3_IPC_EVENT_WINDOW, window_events[i]);
+            }
+            i3.execute_commands("nop");
+        }
+
+        // Handles given number of events, which must be already queued or sent.
+        void handle(std::size_t a_count)
+        {
+            for (std::size_t i = 0; i < a_count; ++i)
+            {
+                i3.handle_next_event();
+            }
+        }
+    };
+
+    void check_drop_oldest()
+    {
+        connection oldest({ 3, 1 << 20, overflow_policy::drop_oldest, { } });
+        oldest.queue_window_events(0, 7);
+        oldest.handle(3);
+        CHECK((oldest.handled == std::vector<std::uint64_t>{ 24, 43, 43 }));
+
+        // Size limit drops events in the same way.
+        const std::size_t largest = std::max_element(window_events.begin(), window_events.end(),
+                                                     [](const std::string& a_first, const std::string& a_second)
+                                                     {
+                                                         return a_first.size() < a_second.size();
+                                                     })->size();
+        connection smallest({ 100, largest, overflow_policy::drop_oldest, { } });
+        smallest.queue_window_events(0, 7);
+        smallest.handle(1);
+        CHECK(smallest.handled == std::vector<std::uint64_t>{ 43 });
+    }
+
+    void check_drop_by_type()
+    {
+        // New window events are dropped once the queue is full, and the queued ones make room for other events.
+        connection by_type({ 2, 1 << 20, overflow_policy::drop_by_type, { event_type::window } });
+        by_type.server.send_event(I3_IPC_EVENT_WORKSPACE, workspace_events[0]);
+        by_type.queue_window_events(0, 3);
+        by_type.server.send_event(I3_IPC_EVENT_WORKSPACE, workspace_events[2]);
+        by_type.i3.execute_commands("nop");
+        by_type.handle(2);
+        CHECK((by_type.handled == std::vector<std::uint64_t>{ 30, 50 }));
+
+        // Limits are exceeded if nothing can be dropped.
+        connection exceeded({ 2, 1 << 20, overflow_policy::drop_by_type, { event_type::window } });
+        for (const std::string& event : workspace_events)
+        {
+            exceeded.server.send_event(I3_IPC_EVENT_WORKSPACE, event);
+        }
+        exceeded.i3.execute_commands("nop");
+        exceeded.handle(workspace_events.size());
+        CHECK((exceeded.handled == std::vector<std::uint64_t>{ 30, 30, 50, 30, 30, 50 }));
+    }
+
+    void check_resync()
+    {
+        // Overflow drops every event and it is reported once, after which events are handled again.
+        connection resync({ 2, 1 << 20, overflow_policy::resync, { } });
+        resync.queue_window_events(0, 3);
+        bool is_thrown = false;
+        try
+        {
+            resync.handle(1);
+        }
+        catch (const i3_ipc_queue_overflow&)
+        {
+            is_thrown = true;
+        }
+        CHECK(is_thrown && resync.handled.empty());
+        resync.queue_window_events(3, 5);
+        resync.handle(2);
+        CHECK((resync.handled == std::vector<std::uint64_t>{ 27, 24 }));
+    }
+
+    void check_block()
+    {
+        // Events which come before the response have to be queued even over the limits.
+        connection block({ 2, 1 << 20, overflow_policy::block, { } });
+        block.queue_window_events(0, 4);
+        block.handle(4);
+        CHECK((block.handled == std::vector<std::uint64_t>{ 23, 21, 27, 27 }));
+
+        // Batches read ahead only up to the limits and leave the rest in the socket.
+        std::vector<std::size_t> batch_sizes;
+        const auto count = [&batch_sizes](const i3_containers::event_batch& a_batch)
+        {
+            batch_sizes.push_back(a_batch.window_events.size());
+        };
+        for (const std::string& event : window_events)
+        {
+            block.server.send_event(I3_IPC_EVENT_WINDOW, event);
+        }
+        // NOTE: Only the last batch is smaller than the limit, so no call waits for more events.
+        while (block.i3.handle_pending_events(count) == 2)
+        {
+        }
+        CHECK((batch_sizes == std::vector<std::size_t>{ 2, 2, 2, 1 }));
+    }
+} // Unnamed namespace.
+
+int main()
+{
+    check_drop_oldest();
+    check_drop_by_type();
+    check_resync();
+    check_block();
+
+    return test_result();
+}
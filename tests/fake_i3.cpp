@@ -0,0 +1,236 @@
+/**
+ * \file    fake_i3.cpp
+ *
+ * \brief   Defines member functions of "fake_i3" class and functions for reading fixtures.
+ */
+
+// Test headers.
+#include "fake_i3.hpp"
+
+// External library headers.
+#include <i3/ipc.h>
+
+// C++ headers.
+#include <mutex>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+
+// C headers.
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <unistd.h>
+#include <sys/un.h>
+#include <sys/socket.h>
+
+namespace
+{
+    /**
+     * \brief                   Reads exactly given number of bytes from the socket.
+     *
+     * \param [in] a_socket     Socket which is read.
+     *
+     * \param [out] a_buffer    Buffer which receives the bytes.
+     *
+     * \param [in] a_size       Number of bytes to read.
+     *
+     * \return                  True if all bytes were read, false if the socket was closed or broken before that.
+     */
+    bool read_exactly(int a_socket, char* a_buffer, std::size_t a_size)
+    {
+        while (a_size != 0)
+        {
+            const ssize_t result = read(a_socket, a_buffer, a_size);
+            if (result == -1 && errno == EINTR)
+            {
+                continue;
+            }
+            if (result <= 0)
+            {
+                return false;
+            }
+
+            a_buffer += result;
+            a_size -= static_cast<std::size_t>(result);
+        }
+
+        return true;
+    }
+} // Unnamed namespace.
+
+fake_i3::fake_i3()
+    : m_socket_path(), m_listener(-1), m_client(-1), m_is_closed(false), m_replies(), m_mutex(), m_connected(),
+      m_thread()
+{
+    static int instances = 0;
+    m_socket_path = "/tmp/i3-ipc++-test." + std::to_string(getpid()) + "." + std::to_string(instances++);
+    unlink(m_socket_path.c_str());
+
+    m_listener = socket(AF_LOCAL, SOCK_STREAM, 0);
+    if (m_listener == -1)
+    {
+        throw std::system_error(errno, std::generic_category());
+    }
+
+    sockaddr_un address = {};
+    address.sun_family = AF_LOCAL;
+    std::strncpy(address.sun_path, m_socket_path.c_str(), sizeof(address.sun_path) - 1);
+    if (bind(m_listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1 || listen(m_listener, 1) == -1)
+    {
+        const int error = errno;
+        close(m_listener);
+        throw std::system_error(error, std::generic_category());
+    }
+
+    m_thread = std::thread(&fake_i3::serve, this);
+}
+
+fake_i3::~fake_i3()
+{
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_client != -1)
+        {
+            shutdown(m_client, SHUT_RDWR);
+        }
+    }
+    shutdown(m_listener, SHUT_RDWR);
+    m_thread.join();
+
+    close(m_listener);
+    if (m_client != -1)
+    {
+        close(m_client);
+    }
+    unlink(m_socket_path.c_str());
+}
+
+const std::string& fake_i3::get_socket_path() const
+{
+    return m_socket_path;
+}
+
+void fake_i3::set_reply(std::uint32_t a_type, std::string a_payload)
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    m_replies[a_type] = std::move(a_payload);
+}
+
+void fake_i3::send_event(std::uint32_t a_type, std::string_view a_payload)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_connected.wait(lock, [this]() -> bool { return m_client != -1 || m_is_closed; });
+    if (m_client == -1)
+    {
+        throw std::system_error(ENOTCONN, std::generic_category());
+    }
+
+    send(a_type, a_payload);
+}
+
+void fake_i3::serve()
+{
+    const int client = accept(m_listener, nullptr, nullptr);
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_client = client;
+        m_is_closed = client == -1;
+    }
+    m_connected.notify_all();
+
+    i3_ipc_header_t header;
+    while (client != -1 && read_exactly(client, reinterpret_cast<char*>(&header), sizeof(header)))
+    {
+        std::string payload(header.size, '\0');
+        if (!read_exactly(client, payload.data(), payload.size()))
+        {
+            break;
+        }
+
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        const auto reply = m_replies.find(header.type);
+        try
+        {
+            if (reply != m_replies.end())
+            {
+                send(header.type, reply->second);
+            }
+            else
+            {
+                send(header.type, header.type == I3_IPC_MESSAGE_TYPE_RUN_COMMAND ? "[{\"success\":true}]"
+                                                                                 : "{\"success\":true}");
+            }
+        }
+        catch (const std::system_error&)
+        {
+            break;
+        }
+    }
+
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    m_is_closed = true;
+    m_connected.notify_all();
+}
+
+void fake_i3::send(std::uint32_t a_type, std::string_view a_payload)
+{
+    i3_ipc_header_t header;
+    std::memcpy(header.magic, I3_IPC_MAGIC, sizeof(header.magic));
+    header.size = static_cast<std::uint32_t>(a_payload.size());
+    header.type = a_type;
+
+    std::string message(reinterpret_cast<const char*>(&header), sizeof(header));
+    message.append(a_payload);
+
+    std::size_t written = 0;
+    while (written < message.size())
+    {
+        const ssize_t result = write(m_client, message.data() + written, message.size() - written);
+        if (result == -1 && errno == EINTR)
+        {
+            continue;
+        }
+        if (result == -1)
+        {
+            throw std::system_error(errno, std::generic_category());
+        }
+
+        written += static_cast<std::size_t>(result);
+    }
+}
+
+std::string read_fixture(std::string_view a_name)
+{
+    const std::string path = std::string(FIXTURES_DIR) + std::string(a_name);
+    std::ifstream file(path);
+    if (!file)
+    {
+        throw std::runtime_error("Fixture \"" + path + "\" can't be read!");
+    }
+
+    std::ostringstream content;
+    content << file.rdbuf();
+
+    return content.str();
+}
+
+std::vector<std::string> read_fixture_lines(std::string_view a_name)
+{
+    std::istringstream content(read_fixture(a_name));
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(content, line);)
+    {
+        if (!line.empty())
+        {
+            lines.push_back(std::move(line));
+        }
+    }
+
+    return lines;
+}
@@ -0,0 +1,130 @@
+/**
+ * \file    fake_i3.hpp
+ *
+ * \brief   Defines "fake_i3" class, which serves JSON fixtures over i3's IPC protocol, so that tests don't need i3.
+ */
+
+#ifndef FAKE_I3_HPP
+#define FAKE_I3_HPP
+
+// C++ headers.
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <string_view>
+#include <condition_variable>
+
+// C headers.
+#include <cstdint>
+
+/**
+ * \brief   Class used to stand in for i3 in tests.<br>
+ *          It listens on its own socket and accepts single connection, to which it sends the reply set for the
+ *          type of each request and every event which is sent by the test.
+ */
+class fake_i3
+{
+
+public:
+
+    /**
+     * \brief                       Creates the socket and starts serving it from separate thread.
+     *
+     * \throws std::system_error    When system error occurs while creating the socket.
+     */
+    fake_i3();
+
+    /**
+     * \brief   Closes the socket and waits for serving thread to finish.
+     */
+    ~fake_i3();
+
+    /// \cond DO_NOT_DOCUMENT
+    fake_i3(const fake_i3& a_fake_i3) = delete;
+    fake_i3& operator=(const fake_i3& a_fake_i3) = delete;
+    /// \endcond
+
+    /**
+     * \brief    Returns the path of the socket, which should be passed to "i3_ipc".
+     *
+     * \return   Path of the socket.
+     */
+    const std::string& get_socket_path() const;
+
+    /**
+     * \brief                  Sets the payload sent in reply to every request of given type.<br>
+     *                         Requests without reply get {"success":true} (or its array for commands).
+     *
+     * \param [in] a_type      Type of the request (e.g. "I3_IPC_MESSAGE_TYPE_GET_TREE").
+     *
+     * \param [in] a_payload   Payload of the reply.
+     */
+    void set_reply(std::uint32_t a_type, std::string a_payload);
+
+    /**
+     * \brief                       Sends the event to the connected client, waiting for it to connect if needed.<br>
+     *                              Event is written to the socket before this function returns, so it comes before
+     *                              the reply to any later request.
+     *
+     * \param [in] a_type           Type of the event (e.g. "I3_IPC_EVENT_WINDOW").
+     *
+     * \param [in] a_payload        Payload of the event.
+     *
+     * \throws std::system_error    When system error occurs while writing to the socket.
+     */
+    void send_event(std::uint32_t a_type, std::string_view a_payload);
+
+private:
+
+    /**
+     * \brief   Accepts the client and replies to its requests until it disconnects.
+     */
+    void serve();
+
+    /**
+     * \brief                       Writes one message to the client. "m_mutex" must be locked.
+     *
+     * \param [in] a_type           Type of the message.
+     *
+     * \param [in] a_payload        Payload of the message.
+     *
+     * \throws std::system_error    When system error occurs while writing to the socket.
+     */
+    void send(std::uint32_t a_type, std::string_view a_payload);
+
+    std::string m_socket_path;                      /**< Path of the listening socket.               */
+    int m_listener;                                 /**< Listening socket.                           */
+    int m_client;                                   /**< Socket of the connected client, or -1.      */
+    bool m_is_closed;                               /**< Whether serving has finished.               */
+    std::map<std::uint32_t, std::string> m_replies; /**< Reply to each type of request.              */
+    std::mutex m_mutex;                             /**< Mutex which guards the client and replies.  */
+    std::condition_variable m_connected;            /**< Notified once the client connects or fails. */
+    std::thread m_thread;                           /**< Thread which serves the client.             */
+
+}; // class fake_i3
+
+/**
+ * \brief                       Reads the whole fixture.
+ *
+ * \param [in] a_name           Name of the file in "fixtures" directory.
+ *
+ * \return                      Content of the file.
+ *
+ * \throws std::runtime_error   When the file can't be read.
+ */
+std::string read_fixture(std::string_view a_name);
+
+/**
+ * \brief                       Reads the fixture which holds one JSON payload per line (e.g. events).
+ *
+ * \param [in] a_name           Name of the file in "fixtures" directory.
+ *
+ * \return                      Non-empty lines of the file.
+ *
+ * \throws std::runtime_error   When the file can't be read.
+ */
+std::vector<std::string> read_fixture_lines(std::string_view a_name);
+
+#endif // FAKE_I3_HPP
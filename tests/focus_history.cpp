@@ -0,0 +1,82 @@
+// Test headers.
+#include "check.hpp"
+#include "fake_i3.hpp"
+
+// i3-ipc++ headers.
+#include "i3_ipc.hpp"
+#include "i3_containers.hpp"
+#include "i3_focus_history.hpp"
+
+// External library headers.
+#include <i3/ipc.h>
+
+// C++ headers.
+#include <list>
+#include <string>
+#include <cstdint>
+
+int main()
+{
+    fake_i3 server;
+    server.set_reply(I3_IPC_MESSAGE_TYPE_GET_TREE, read_fixture("tree.json"));
+    i3_ipc i3(server.get_socket_path());
+
+    // Initial order follows the focus lists of the tree: the editor tab is focused, then the browser tab behind it,
+    // the terminal and the floating volume control, followed by the other workspaces and outputs.
+    using ids = std::list<std::uint64_t>;
+    i3_containers::focus_history history(i3.get_tree());
+    CHECK(history.size() == 8);
+    CHECK((history.get_order() == ids{ 24, 23, 21, 26, 31, 12, 43, 6 }));
+    CHECK(history.get_current_workspace() == 20u);
+    CHECK((history.get_order(20) == ids{ 24, 23, 21, 26 }));
+    CHECK(history.get_order(30) == ids{ 31 });
+    CHECK(history.get_order(42) == ids{ 43 });
+    CHECK(history.get_order(99).empty());
+
+    // Focused windows move to the front, new windows are added once they are focused and closed ones are removed.
+    // Workspace isn't known from window events, so the video focused before moving is assigned to the current one.
+    i3.on_window_event([&history](const i3_containers::window_event& a_event)
+                       {
+                           history.handle_event(a_event);
+                       });
+    i3.on_workspace_event([&history](const i3_containers::workspace_event& a_event)
+                          {
+                              history.handle_event(a_event);
+                          });
+    for (const std::string& event : read_fixture_lines("window_events.jsonl"))
+    {
+        server.send_event(I3_IPC_EVENT_WINDOW, event);
+        i3.handle_next_event();
+    }
+    CHECK(history.size() == 8);
+    CHECK((history.get_order() == ids{ 43, 27, 23, 21, 26, 31, 12, 6 }));
+    CHECK((history.get_order(20) == ids{ 43, 27, 23, 21, 26 }));
+    CHECK(history.get_order(42).empty());
+
+    // Focused workspace becomes the current one, other workspace events don't change the history.
+    for (const std::string& event : read_fixture_lines("workspace_events.jsonl"))
+    {
+        server.send_event(I3_IPC_EVENT_WORKSPACE, event);
+        i3.handle_next_event();
+    }
+    CHECK(history.get_current_workspace() == 30u);
+    CHECK((history.get_order() == ids{ 43, 27, 23, 21, 26, 31, 12, 6 }));
+    CHECK(history.get_order(30) == ids{ 31 });
+    CHECK(history.get_order(50).empty());
+
+    // Window focused on the current workspace moves to the front of both lists.
+    i3_containers::window_event focus;
+    focus.change = i3_containers::window_change::focus;
+    focus.container.id = 31;
+    history.handle_event(focus);
+    CHECK((history.get_order() == ids{ 31, 43, 27, 23, 21, 26, 12, 6 }));
+    CHECK(history.get_order(30) == ids{ 31 });
+
+    // Window focused while another workspace is current is moved to that workspace.
+    focus.container.id = 26;
+    history.handle_event(focus);
+    CHECK((history.get_order(30) == ids{ 26, 31 }));
+    CHECK((history.get_order(20) == ids{ 43, 27, 23, 21 }));
+
+    return test_result();
+}
@@ -0,0 +1,106 @@
+// Test headers.
+#include "check.hpp"
+#include "fake_i3.hpp"
+
+// i3-ipc++ headers.
+#include "i3_ipc.hpp"
+#include "i3_tree_diff.hpp"
+#include "i3_containers.hpp"
+#include "i3_hashed_tree.hpp"
+
+// External library headers.
+#include <i3/ipc.h>
+
+// C++ headers.
+#include <tuple>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+namespace
+{
+    using i3_containers::node_change;
+
+    // Changes are compared as tuples of all of their fields, ordered by ID, since the order of changes is unspecified.
+    std::vector<std::tuple<node_change::type, std::uint64_t, std::uint64_t, std::uint64_t, std::uint32_t>>
+    sorted(const std::vector<node_change>& a_changes)
+    {
+        std::vector<std::tuple<node_change::type, std::uint64_t, std::uint64_t, std::uint64_t, std::uint32_t>> result;
+        for (const node_change& change : a_changes)
+        {
+            result.emplace_back(change.kind, change.id, change.parent_id, change.old_parent_id, change.changed_fields);
+        }
+        std::sort(result.begin(), result.end(), [](const auto& a_first, const auto& a_second) -> bool
+                                                {
+                                                    return std::get<1>(a_first) < std::get<1>(a_second);
+                                                });
+
+        return result;
+    }
+
+    // Hash of the subtree of the node with given ID, or 0 if the tree has no such node.
+    std::uint64_t get_hash(const i3_containers::hashed_tree& a_tree, std::uint64_t a_id)
+    {
+        const auto position = a_tree.find(a_id);
+
+        return position ? a_tree.get_entries()[*position].hash : 0;
+    }
+} // Unnamed namespace.
+
+int main()
+{
+    fake_i3 server;
+    i3_ipc i3(server.get_socket_path());
+
+    server.set_reply(I3_IPC_MESSAGE_TYPE_GET_TREE, read_fixture("tree.json"));
+    const i3_containers::node old_tree = i3.get_tree();
+    const i3_containers::hashed_tree old_hashed(old_tree);
+    server.set_reply(I3_IPC_MESSAGE_TYPE_GET_TREE, read_fixture("tree_changed.json"));
+    const i3_containers::node new_tree = i3.get_tree();
+    const i3_containers::hashed_tree new_hashed(new_tree);
+
+    // Index has one entry per node in pre-order, the root one spanning the whole index.
+    const auto& entries = old_hashed.get_entries();
+    CHECK(entries.size() == 23);
+    CHECK(entries[0].tree_node == &old_hashed.get_root() && entries[0].parent_id == 0);
+    CHECK(entries[0].subtree_end == entries.size() && entries[0].hash == old_hashed.get_hash());
+    CHECK(!old_hashed.find(27) && !new_hashed.find(24));
+
+    // Workspace "1" holds 21, the tabbed container 22 with 23 and 24, and the floating container 25 with 26.
+    const auto workspace = old_hashed.find(20);
+    CHECK(workspace.has_value());
+    if (workspace)
+    {
+        const auto& entry = entries[*workspace];
+        CHECK(entry.tree_node->id == 20 && entry.parent_id == 13);
+        CHECK(entry.subtree_end - *workspace == 7);
+        for (std::size_t position = *workspace + 1; position < entry.subtree_end; ++position)
+        {
+            CHECK(entries[position].tree_node->id > 20 && entries[position].tree_node->id < 27);
+        }
+    }
+
+    // Hashes depend only on the content of the tree, so the same tree gets the same hashes.
+    const i3_containers::hashed_tree same_hashed(i3.get_tree());
+    CHECK(same_hashed.get_hash() == new_hashed.get_hash());
+    CHECK(old_hashed.get_hash() != new_hashed.get_hash());
+
+    // Untouched subtrees keep their hash, while every ancestor of a change gets a new one.
+    for (const std::uint64_t id : { 2, 11, 26, 30 })
+    {
+        CHECK(get_hash(old_hashed, id) == get_hash(new_hashed, id));
+    }
+    for (const std::uint64_t id : { 1, 10, 13, 20, 21, 22, 40, 41, 42 })
+    {
+        CHECK(get_hash(old_hashed, id) != get_hash(new_hashed, id));
+    }
+
+    // Diff of hashed trees skips equal subtrees, but finds the same changes.
+    const auto expected = sorted(i3_containers::tree_diff(old_tree, new_tree));
+    const auto reversed = sorted(i3_containers::tree_diff(new_tree, old_tree));
+    CHECK(sorted(i3_containers::tree_diff(old_hashed, new_hashed)) == expected);
+    CHECK(sorted(i3_containers::tree_diff(new_hashed, old_hashed)) == reversed);
+    CHECK(i3_containers::tree_diff(new_hashed, same_hashed).empty());
+
+    return test_result();
+}
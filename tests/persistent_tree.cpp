@@ -0,0 +1,110 @@
+// Test headers.
+#include "check.hpp"
+#include "fake_i3.hpp"
+
+// i3-ipc++ headers.
+#include "i3_ipc.hpp"
+#include "i3_tree_diff.hpp"
+#include "i3_containers.hpp"
+#include "i3_persistent_tree.hpp"
+
+// External library headers.
+#include <i3/ipc.h>
+
+// C++ headers.
+#include <vector>
+#include <cstdint>
+
+namespace
+{
+    using i3_containers::node_change;
+    using i3_containers::persistent_node;
+
+    // Workspace "1" in the fixture, reached through output "eDP-1" and its content container.
+    const persistent_node& get_workspace(const persistent_node::pointer& a_root)
+    {
+        return *a_root->get_nodes()[1]->get_nodes()[1]->get_nodes()[0];
+    }
+
+    // Whether the diff has single change of given kind.
+    bool is_single_change(const std::vector<node_change>& a_changes, node_change::type a_kind, std::uint64_t a_id,
+                          std::uint64_t a_parent_id)
+    {
+        return a_changes.size() == 1 && a_changes[0].kind == a_kind && a_changes[0].id == a_id
+               && a_changes[0].parent_id == a_parent_id;
+    }
+} // Unnamed namespace.
+
+int main()
+{
+    fake_i3 server;
+    server.set_reply(I3_IPC_MESSAGE_TYPE_GET_TREE, read_fixture("tree.json"));
+    i3_ipc i3(server.get_socket_path());
+
+    const i3_containers::node tree = i3.get_tree();
+    const persistent_node::pointer root = persistent_node::make(tree);
+
+    // Conversion keeps the whole tree, with child nodes held only by persistent nodes.
+    CHECK(i3_containers::tree_diff(tree, root->to_node()).empty());
+    CHECK(root->get_info().nodes.empty() && root->get_info().floating_nodes.empty());
+    CHECK(get_workspace(root).get_info().name == "1");
+    CHECK(get_workspace(root).get_floating_nodes()[0]->get_nodes()[0]->get_info().id == 26);
+
+    // Update copies only the path to the root, every other subtree is shared with the previous version.
+    const persistent_node::pointer renamed = root->update(21, [](i3_containers::node& a_node)
+                                                               {
+                                                                   a_node.name = "~/src/i3-ipc++";
+                                                                   a_node.nodes.emplace_back();
+                                                               });
+    CHECK(renamed != root);
+    CHECK(get_workspace(root).get_nodes()[0]->get_info().name == "~/src");
+    CHECK(get_workspace(renamed).get_nodes()[0]->get_info().name == "~/src/i3-ipc++");
+    CHECK(get_workspace(renamed).get_nodes()[0]->get_nodes().empty());
+    CHECK(renamed->get_nodes()[0] == root->get_nodes()[0] && renamed->get_nodes()[2] == root->get_nodes()[2]);
+    CHECK(renamed->get_nodes()[1] != root->get_nodes()[1]);
+    CHECK(get_workspace(renamed).get_nodes()[1] == get_workspace(root).get_nodes()[1]);
+    CHECK(get_workspace(renamed).get_floating_nodes()[0] == get_workspace(root).get_floating_nodes()[0]);
+    const std::vector<node_change> rename_changes = i3_containers::tree_diff(tree, renamed->to_node());
+    CHECK(is_single_change(rename_changes, node_change::type::changed, 21, 20));
+    CHECK(!rename_changes.empty() && rename_changes[0].changed_fields == node_change::name_field);
+
+    // Removing the subtree drops it from its parent.
+    const persistent_node::pointer closed = root->replace(24, nullptr);
+    CHECK(get_workspace(closed).get_nodes()[1]->get_nodes().size() == 1);
+    CHECK(is_single_change(i3_containers::tree_diff(tree, closed->to_node()), node_change::type::removed, 24, 22));
+
+    // Replaced subtree is shared by both versions, so the same window may appear at two places.
+    const persistent_node::pointer replaced = root->replace(31, get_workspace(root).get_nodes()[0]);
+    const persistent_node& mail = *replaced->get_nodes()[1]->get_nodes()[1]->get_nodes()[1];
+    CHECK(mail.get_nodes()[0] == get_workspace(root).get_nodes()[0]);
+    CHECK(replaced->get_nodes()[0] == root->get_nodes()[0]);
+
+    // New subtree is added as the last tiling or floating child node.
+    i3_containers::node terminal;
+    terminal.id = 27;
+    terminal.type = i3_containers::node_type::con;
+    terminal.name = "alacritty";
+    const persistent_node::pointer opened = root->insert(20, persistent_node::make(terminal));
+    CHECK(get_workspace(opened).get_nodes().size() == 3 && get_workspace(opened).get_nodes()[2]->get_info().id == 27);
+    CHECK(is_single_change(i3_containers::tree_diff(tree, opened->to_node()), node_change::type::added, 27, 20));
+    const persistent_node::pointer floated = root->insert(20, persistent_node::make(terminal), true);
+    CHECK(get_workspace(floated).get_nodes().size() == 2 && get_workspace(floated).get_floating_nodes().size() == 2);
+
+    // Missing nodes leave the tree as it is, while removing the root leaves nothing.
+    CHECK(root->update(99, [](i3_containers::node&) {}) == root);
+    CHECK(root->replace(99, nullptr) == root);
+    CHECK(root->insert(99, persistent_node::make(terminal)) == root);
+    CHECK(root->replace(1, nullptr) == nullptr);
+
+    // Store keeps the latest versions and hands out the current one.
+    i3_containers::snapshot_store store(2);
+    CHECK(store.get_current() == nullptr && store.get_history().empty());
+    store.publish(root);
+    store.publish(renamed);
+    const persistent_node::pointer reader = store.get_current();
+    store.publish(closed);
+    CHECK(reader == renamed && store.get_current() == closed);
+    CHECK((store.get_history() == std::vector<persistent_node::pointer>{ renamed, closed }));
+
+    return test_result();
+}
@@ -0,0 +1,87 @@
+// Test headers.
+#include "check.hpp"
+#include "fake_i3.hpp"
+
+// i3-ipc++ headers.
+#include "i3_ipc.hpp"
+#include "i3_containers.hpp"
+#include "i3_spatial_index.hpp"
+
+// External library headers.
+#include <i3/ipc.h>
+
+// C++ headers.
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+namespace
+{
+    // Results are in no particular order, so they are sorted before comparison.
+    std::vector<std::uint64_t> sorted(std::vector<std::uint64_t> a_ids)
+    {
+        std::sort(a_ids.begin(), a_ids.end());
+
+        return a_ids;
+    }
+} // Unnamed namespace.
+
+int main()
+{
+    fake_i3 server;
+    server.set_reply(I3_IPC_MESSAGE_TYPE_GET_TREE, read_fixture("tree.json"));
+    i3_ipc i3(server.get_socket_path());
+
+    // Only visible windows are indexed: the bar, the terminal, the focused editor tab, the floating volume control
+    // and the video on the second output. The browser tab, the mail on hidden workspace and the scratchpad aren't.
+    i3_containers::spatial_index index(i3.get_tree());
+    CHECK(index.size() == 5);
+    CHECK(sorted(index.find_at(10, 10)) == std::vector<std::uint64_t>{ 12 });
+    CHECK(sorted(index.find_at(1000, 500)) == std::vector<std::uint64_t>{ 24 });
+    CHECK((sorted(index.find_at(200, 200)) == std::vector<std::uint64_t>{ 21, 26 }));
+    CHECK(sorted(index.find_at(600, 400)) == std::vector<std::uint64_t>{ 21 });
+    CHECK(sorted(index.find_at(2000, 100)) == std::vector<std::uint64_t>{ 43 });
+
+    // Regions return every overlapping window, including the ones crossing the border of the region.
+    CHECK((sorted(index.find_in({ 0, 0, 1920, 1080 })) == std::vector<std::uint64_t>{ 12, 21, 24, 26 }));
+    CHECK((sorted(index.find_in({ 1900, 500, 40, 10 })) == std::vector<std::uint64_t>{ 24, 43 }));
+    CHECK((sorted(index.find_in({ 0, 0, 4480, 1440 })) == std::vector<std::uint64_t>{ 12, 21, 24, 26, 43 }));
+
+    // New window is added and closed one is removed, but the tab focused after the close stays unknown until the
+    // index is rebuilt.
+    std::vector<i3_containers::window_event> events;
+    i3.on_window_event([&events](const i3_containers::window_event& a_event)
+                       {
+                           events.push_back(a_event);
+                       });
+    for (const std::string& event : read_fixture_lines("window_events.jsonl"))
+    {
+        server.send_event(I3_IPC_EVENT_WINDOW, event);
+        i3.handle_next_event();
+    }
+    for (const i3_containers::window_event& event : events)
+    {
+        index.handle_event(event);
+    }
+    CHECK(index.size() == 5);
+    CHECK((sorted(index.find_at(700, 500)) == std::vector<std::uint64_t>{ 21, 27 }));
+    CHECK(index.find_at(1000, 500).empty());
+
+    // Rebuilt index sees the browser tab and the video moved to the first output.
+    server.set_reply(I3_IPC_MESSAGE_TYPE_GET_TREE, read_fixture("tree_changed.json"));
+    index = i3_containers::spatial_index(i3.get_tree());
+    CHECK(index.size() == 6);
+    CHECK(sorted(index.find_at(1000, 500)) == std::vector<std::uint64_t>{ 23 });
+    CHECK((sorted(index.find_at(300, 500)) == std::vector<std::uint64_t>{ 21, 43 }));
+    CHECK((sorted(index.find_at(700, 500)) == std::vector<std::uint64_t>{ 21, 27 }));
+    CHECK(index.find_at(2000, 100).empty());
+
+    // Unknown IDs are ignored on removal.
+    index.erase(43);
+    index.erase(99);
+    CHECK(index.size() == 5);
+    CHECK(sorted(index.find_at(300, 500)) == std::vector<std::uint64_t>{ 21 });
+
+    return test_result();
+}
@@ -0,0 +1,84 @@
+// Test headers.
+#include "check.hpp"
+#include "fake_i3.hpp"
+
+// i3-ipc++ headers.
+#include "i3_ipc.hpp"
+#include "i3_tree_diff.hpp"
+#include "i3_containers.hpp"
+
+// External library headers.
+#include <i3/ipc.h>
+
+// C++ headers.
+#include <tuple>
+#include <vector>
+#include <algorithm>
+
+namespace
+{
+    using i3_containers::node_change;
+
+    // Changes are compared as tuples of all of their fields, ordered by ID, since the order of changes is unspecified.
+    std::vector<std::tuple<node_change::type, std::uint64_t, std::uint64_t, std::uint64_t, std::uint32_t>>
+    sorted(const std::vector<node_change>& a_changes)
+    {
+        std::vector<std::tuple<node_change::type, std::uint64_t, std::uint64_t, std::uint64_t, std::uint32_t>> result;
+        for (const node_change& change : a_changes)
+        {
+            result.emplace_back(change.kind, change.id, change.parent_id, change.old_parent_id, change.changed_fields);
+        }
+        std::sort(result.begin(), result.end(), [](const auto& a_first, const auto& a_second) -> bool
+                                                {
+                                                    return std::get<1>(a_first) < std::get<1>(a_second);
+                                                });
+
+        return result;
+    }
+} // Unnamed namespace.
+
+int main()
+{
+    fake_i3 server;
+    i3_ipc i3(server.get_socket_path());
+
+    server.set_reply(I3_IPC_MESSAGE_TYPE_GET_TREE, read_fixture("tree.json"));
+    const i3_containers::node old_tree = i3.get_tree();
+    server.set_reply(I3_IPC_MESSAGE_TYPE_GET_TREE, read_fixture("tree_changed.json"));
+    const i3_containers::node new_tree = i3.get_tree();
+
+    // Tree is equal to itself.
+    CHECK(i3_containers::tree_diff(old_tree, old_tree).empty());
+    CHECK(i3_containers::tree_diff(new_tree, new_tree).empty());
+
+    // Terminal got new title, editor tab was closed, so the browser tab got focus, video was moved from the monitor
+    // to the first workspace and new terminal was opened there.
+    using type = node_change::type;
+    const auto expected = sorted({
+        { type::changed,    20, 13, 0,  node_change::focus_field                                           },
+        { type::changed,    21, 20, 0,  node_change::name_field | node_change::window_properties_field     },
+        { type::changed,    22, 20, 0,  node_change::focus_field                                           },
+        { type::changed,    23, 22, 0,  node_change::focused_field                                         },
+        { type::removed,    24, 22, 0,  0                                                                  },
+        { type::added,      27, 20, 0,  0                                                                  },
+        { type::changed,    42, 41, 0,  node_change::focus_field                                           },
+        { type::reparented, 43, 20, 42, node_change::rect_field                                            }
+    });
+    CHECK(sorted(i3_containers::tree_diff(old_tree, new_tree)) == expected);
+
+    // Diff in the other direction swaps added and removed nodes.
+    const auto reversed = sorted(i3_containers::tree_diff(new_tree, old_tree));
+    CHECK(reversed.size() == expected.size());
+    CHECK((std::count_if(reversed.begin(), reversed.end(), [](const auto& a_change) -> bool
+                                                           {
+                                                               return std::get<0>(a_change) == type::added
+                                                                      && std::get<1>(a_change) == 24;
+                                                           }) == 1));
+    CHECK((std::count_if(reversed.begin(), reversed.end(), [](const auto& a_change) -> bool
+                                                           {
+                                                               return std::get<0>(a_change) == type::removed
+                                                                      && std::get<1>(a_change) == 27;
+                                                           }) == 1));
+
+    return test_result();
+}
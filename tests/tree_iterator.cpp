@@ -0,0 +1,107 @@
+// Test headers.
+#include "check.hpp"
+#include "fake_i3.hpp"
+
+// i3-ipc++ headers.
+#include "i3_ipc.hpp"
+#include "i3_containers.hpp"
+#include "i3_tree_iterator.hpp"
+
+// External library headers.
+#include <i3/ipc.h>
+
+// C++ headers.
+#include <vector>
+#include <cstdint>
+#include <iterator>
+#include <algorithm>
+
+namespace
+{
+    // IDs of the nodes in the order in which the range visits them.
+    std::vector<std::uint64_t> get_ids(const i3_containers::tree_range& a_range)
+    {
+        std::vector<std::uint64_t> ids;
+        for (const i3_containers::node& container : a_range)
+        {
+            ids.push_back(container.id);
+        }
+
+        return ids;
+    }
+} // Unnamed namespace.
+
+int main()
+{
+    fake_i3 server;
+    server.set_reply(I3_IPC_MESSAGE_TYPE_GET_TREE, read_fixture("tree.json"));
+    i3_ipc i3(server.get_socket_path());
+    const i3_containers::node tree = i3.get_tree();
+
+    using ids = std::vector<std::uint64_t>;
+    CHECK((get_ids(i3_containers::pre_order(tree)) == ids{ 1, 2, 3, 4, 5, 6, 10, 11, 12, 13, 20, 21, 22, 23, 24, 25,
+                                                           26, 30, 31, 40, 41, 42, 43 }));
+    CHECK((get_ids(i3_containers::post_order(tree)) == ids{ 6, 5, 4, 3, 2, 12, 11, 21, 23, 24, 22, 26, 25, 20, 31,
+                                                            30, 13, 10, 43, 42, 41, 40, 1 }));
+    CHECK((get_ids(i3_containers::breadth_first(tree)) == ids{ 1, 2, 10, 40, 3, 11, 13, 41, 4, 12, 20, 30, 42, 5,
+                                                               21, 22, 25, 31, 43, 6, 23, 24, 26 }));
+    CHECK((get_ids(i3_containers::leaf_windows(tree)) == ids{ 6, 12, 21, 23, 24, 26, 31, 43 }));
+
+    // Focus order follows the focus lists, so the focused editor comes first among the windows.
+    CHECK((get_ids(i3_containers::focus_order(tree)) == ids{ 1, 10, 13, 20, 22, 24, 23, 21, 25, 26, 30, 31, 11, 12,
+                                                             40, 41, 42, 43, 2, 3, 4, 5, 6 }));
+    const i3_containers::tree_range focus_order = i3_containers::focus_order(tree);
+    const auto has_window = [](const i3_containers::node& a_node) -> bool
+    {
+        return a_node.window.has_value();
+    };
+    const auto focused = std::find_if(focus_order.begin(), focus_order.end(), has_window);
+    CHECK(focused != focus_order.end() && focused->id == 24 && focused.get_depth() == 5);
+
+    // Depth is tracked in every order.
+    std::vector<std::size_t> depths;
+    const i3_containers::tree_iterator end;
+    for (i3_containers::tree_iterator it(tree, i3_containers::tree_order::pre_order); it != end; ++it)
+    {
+        depths.push_back(it.get_depth());
+    }
+    CHECK((depths == std::vector<std::size_t>{ 0, 1, 2, 3, 4, 5, 1, 2, 3, 2, 3, 4, 4, 5, 5, 4, 5, 3, 4, 1, 2, 3, 4 }));
+
+    // Iterators work with standard algorithms and the copies are independent.
+    const i3_containers::tree_range windows = i3_containers::leaf_windows(tree);
+    CHECK(std::distance(windows.begin(), windows.end()) == 8);
+    CHECK(std::count_if(windows.begin(), windows.end(), [](const i3_containers::node& a_node) -> bool
+                                                        {
+                                                            return a_node.is_urgent;
+                                                        }) == 1);
+    i3_containers::tree_iterator first = windows.begin();
+    const i3_containers::tree_iterator copy = first++;
+    CHECK(copy->id == 6 && first->id == 12);
+
+    // Single node is visited once in every order.
+    const i3_containers::node& video = tree.nodes[2].nodes[0].nodes[0].nodes[0];
+    for (const auto order : { i3_containers::tree_order::pre_order, i3_containers::tree_order::post_order,
+                              i3_containers::tree_order::breadth_first, i3_containers::tree_order::focus_order,
+                              i3_containers::tree_order::leaf_windows })
+    {
+        CHECK(get_ids(i3_containers::tree_range(video, order)) == ids{ 43 });
+    }
+
+    // Trees deeper than the stack inside of the iterator are still iterated in full.
+    i3_containers::node deep;
+    deep.id = 1;
+    i3_containers::node* last = &deep;
+    for (std::uint64_t id = 2; id <= 3 * i3_containers::tree_iterator::inline_depth; ++id)
+    {
+        last->nodes.emplace_back();
+        last = &last->nodes.back();
+        last->id = id;
+    }
+    const ids deep_ids = get_ids(i3_containers::post_order(deep));
+    CHECK(deep_ids.size() == 3 * i3_containers::tree_iterator::inline_depth);
+    CHECK(!deep_ids.empty() && deep_ids.front() == 3 * i3_containers::tree_iterator::inline_depth);
+    CHECK(!deep_ids.empty() && deep_ids.back() == 1);
+    CHECK(get_ids(i3_containers::breadth_first(deep)).size() == 3 * i3_containers::tree_iterator::inline_depth);
+
+    return test_result();
+}
@@ -0,0 +1,104 @@
+// Test headers.
+#include "check.hpp"
+#include "fake_i3.hpp"
+
+// i3-ipc++ headers.
+#include "i3_ipc.hpp"
+#include "i3_tree_diff.hpp"
+#include "i3_containers.hpp"
+#include "i3_hashed_tree.hpp"
+#include "i3_tree_iterator.hpp"
+
+// External library headers.
+#include <i3/ipc.h>
+
+// C++ headers.
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace
+{
+    // IDs of the nodes in pre-order, which also checks that order of child nodes is kept.
+    std::vector<std::uint64_t> get_ids(const i3_containers::node& a_tree)
+    {
+        std::vector<std::uint64_t> ids;
+        for (const i3_containers::node& container : i3_containers::pre_order(a_tree))
+        {
+            ids.push_back(container.id);
+        }
+
+        return ids;
+    }
+
+    // Trees are the same if they have the same nodes in the same order and every field of every node is equal.
+    bool are_same(const i3_containers::node& a_first, const i3_containers::node& a_second)
+    {
+        return get_ids(a_first) == get_ids(a_second) && i3_containers::tree_diff(a_first, a_second).empty()
+               && i3_containers::hashed_tree(a_first).get_hash() == i3_containers::hashed_tree(a_second).get_hash();
+    }
+
+    // Skips the internal "__i3" output (scratchpad) and dockareas of real outputs.
+    bool skip_internal(const i3_containers::node& a_node, const i3_containers::node&)
+    {
+        switch (a_node.type)
+        {
+            case i3_containers::node_type::output:
+                return a_node.name != "__i3";
+
+            case i3_containers::node_type::dockarea:
+                return false;
+
+            default:
+                return true;
+        }
+    }
+} // Unnamed namespace.
+
+int main()
+{
+    fake_i3 server;
+    server.set_reply(I3_IPC_MESSAGE_TYPE_GET_TREE, read_fixture("tree.json"));
+    i3_ipc i3(server.get_socket_path());
+
+    // Tree is parsed serially by default.
+    const i3_containers::node tree = i3.get_tree();
+    CHECK((get_ids(tree) == std::vector<std::uint64_t>{ 1, 2, 3, 4, 5, 6, 10, 11, 12, 13, 20, 21, 22, 23, 24, 25, 26,
+                                                        30, 31, 40, 41, 42, 43 }));
+    CHECK(tree.type == i3_containers::node_type::root);
+    CHECK((tree.focus == std::vector<std::uint64_t>{ 10, 40, 2 }));
+
+    const i3_containers::node& workspace = tree.nodes[1].nodes[1].nodes[0];
+    CHECK(workspace.type == i3_containers::node_type::workspace && workspace.name == "1");
+    CHECK(workspace.nodes[0].marks == std::vector<std::string>{ "left" });
+    CHECK(workspace.nodes[1].layout == i3_containers::node_layout::tabbed);
+    CHECK((workspace.nodes[1].focus == std::vector<std::uint64_t>{ 24, 23 }));
+    CHECK(workspace.nodes[1].nodes[0].window_properties->window_role == "browser");
+    CHECK(workspace.nodes[1].nodes[1].is_focused);
+    CHECK(workspace.floating_nodes[0].type == i3_containers::node_type::floating_con);
+    CHECK(workspace.floating_nodes[0].nodes[0].window == 0x100004u);
+
+    const i3_containers::node& video = tree.nodes[2].nodes[0].nodes[0].nodes[0];
+    CHECK(video.window_properties->window_class == "mpv");
+    CHECK(video.rect.x == 1920 && video.rect.y == 0 && video.rect.width == 2560 && video.rect.height == 1440);
+
+    // Existing tree is overwritten with the same result.
+    i3_containers::node reused = tree.nodes[1];
+    i3.get_tree(reused);
+    CHECK(are_same(reused, tree));
+
+    // Filtered subtrees are skipped while parsing.
+    const i3_containers::node filtered = i3.get_tree(skip_internal);
+    CHECK((get_ids(filtered) == std::vector<std::uint64_t>{ 1, 10, 13, 20, 21, 22, 23, 24, 25, 26, 30, 31, 40, 41, 42,
+                                                            43 }));
+
+    // Workspaces parsed by the pool are stitched back into the same tree, with or without filter.
+    for (const std::size_t threads : { 2, 4 })
+    {
+        i3.set_tree_parsing_threads(threads);
+        CHECK(are_same(i3.get_tree(), tree));
+        CHECK(are_same(i3.get_tree(skip_internal), filtered));
+    }
+
+    return test_result();
+}
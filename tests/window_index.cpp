@@ -0,0 +1,83 @@
+// Test headers.
+#include "check.hpp"
+#include "fake_i3.hpp"
+
+// i3-ipc++ headers.
+#include "i3_ipc.hpp"
+#include "i3_containers.hpp"
+#include "i3_window_index.hpp"
+
+// External library headers.
+#include <i3/ipc.h>
+
+// C++ headers.
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace
+{
+    // IDs of the results, from the best match.
+    std::vector<std::uint64_t> get_ids(const std::vector<i3_containers::window_index::match>& a_matches)
+    {
+        std::vector<std::uint64_t> ids;
+        for (const i3_containers::window_index::match& result : a_matches)
+        {
+            ids.push_back(result.id);
+        }
+
+        return ids;
+    }
+} // Unnamed namespace.
+
+int main()
+{
+    fake_i3 server;
+    server.set_reply(I3_IPC_MESSAGE_TYPE_GET_TREE, read_fixture("tree.json"));
+    i3_ipc i3(server.get_socket_path());
+
+    // Every container with X11 window is indexed, including the scratchpad and the bar.
+    i3_containers::window_index index(i3.get_tree());
+    CHECK(index.size() == 8);
+
+    // Query is matched case-insensitively against the name, class and title of the window.
+    const auto browser = index.search("FIREFOX");
+    CHECK(!browser.empty() && browser[0].id == 23);
+    CHECK(!browser.empty() && browser[0].score > 0.0f && browser[0].score <= 1.0f);
+    CHECK(get_ids(index.search("thunderbird inbox", 1)) == std::vector<std::uint64_t>{ 31 });
+    CHECK(get_ids(index.search("mp")) == std::vector<std::uint64_t>{ 43 });
+    CHECK(index.search("").empty() && index.search("qqqq").empty());
+
+    // Results are ordered by score and limited.
+    const auto terminals = index.search("term", 2);
+    CHECK(terminals.size() == 2 && terminals[0].score >= terminals[1].score);
+    CHECK(get_ids(index.search("~/src")) == std::vector<std::uint64_t>{ 21 });
+
+    // New windows and titles are indexed, while closed windows are removed.
+    std::vector<i3_containers::window_event> events;
+    i3.on_window_event([&events](const i3_containers::window_event& a_event)
+                       {
+                           events.push_back(a_event);
+                       });
+    for (const std::string& event : read_fixture_lines("window_events.jsonl"))
+    {
+        server.send_event(I3_IPC_EVENT_WINDOW, event);
+        i3.handle_next_event();
+    }
+    CHECK(events.size() == 7);
+    for (const i3_containers::window_event& event : events)
+    {
+        index.handle_event(event);
+    }
+    CHECK(index.size() == 8);
+    CHECK(get_ids(index.search("main.cpp")).empty());
+    CHECK(get_ids(index.search("alacritty", 1)) == std::vector<std::uint64_t>{ 27 });
+    CHECK(get_ids(index.search("i3-ipc++", 1)) == std::vector<std::uint64_t>{ 21 });
+
+    // Unknown IDs are ignored on removal.
+    index.erase(27);
+    index.erase(99);
+    CHECK(index.size() == 7 && index.search("alacritty").empty());
+
+    return test_result();
+}
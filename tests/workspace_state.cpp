@@ -0,0 +1,91 @@
+// Test headers.
+#include "check.hpp"
+#include "fake_i3.hpp"
+
+// i3-ipc++ headers.
+#include "i3_ipc.hpp"
+#include "i3_containers.hpp"
+#include "i3_workspace_state.hpp"
+
+// External library headers.
+#include <i3/ipc.h>
+
+// C++ headers.
+#include <string>
+#include <vector>
+#include <unordered_set>
+
+int main()
+{
+    fake_i3 server;
+    server.set_reply(I3_IPC_MESSAGE_TYPE_GET_WORKSPACES, read_fixture("workspaces.json"));
+    server.set_reply(I3_IPC_MESSAGE_TYPE_GET_OUTPUTS, read_fixture("outputs.json"));
+    i3_ipc i3(server.get_socket_path());
+
+    // Snapshot has workspace "1" focused on the laptop screen, urgent mail hidden behind it and "3" on the monitor.
+    i3_containers::workspace_state state(i3.get_workspaces(), i3.get_outputs());
+    CHECK(state.get_workspaces().size() == 3 && state.get_outputs().size() == 3);
+    CHECK(state.get_focused_workspace() && state.get_focused_workspace()->id == 20);
+    CHECK(state.get_visible_workspace("eDP-1") && state.get_visible_workspace("eDP-1")->id == 20);
+    CHECK(state.get_visible_workspace("HDMI-1") && state.get_visible_workspace("HDMI-1")->id == 42);
+    CHECK(!state.get_visible_workspace("xroot-0") && !state.get_visible_workspace("DP-2"));
+    CHECK(state.get_urgent_workspaces() == std::unordered_set<std::uint64_t>{ 30 });
+    CHECK(!state.get_workspace(50));
+
+    // Events are applied one by one, in the order i3 sends them.
+    std::vector<bool> results;
+    i3.on_workspace_event([&state, &results](const i3_containers::workspace_event& a_event)
+                          {
+                              results.push_back(state.handle_event(a_event));
+                          });
+    const std::vector<std::string> events = read_fixture_lines("workspace_events.jsonl");
+    const auto apply = [&server, &i3, &events](std::size_t a_index)
+    {
+        server.send_event(I3_IPC_EVENT_WORKSPACE, events[a_index]);
+        i3.handle_next_event();
+    };
+
+    // Mail is focused, which hides workspace "1", and then loses its urgency.
+    apply(0);
+    CHECK(state.get_focused_workspace() && state.get_focused_workspace()->id == 30);
+    CHECK(!state.get_workspace(20)->is_focused && !state.get_workspace(20)->is_visible);
+    CHECK(state.get_workspace(30)->is_visible);
+    CHECK(state.get_outputs().at("eDP-1").current_workspace == "2: mail");
+    CHECK(state.get_urgent_workspaces().count(30) == 1);
+    apply(1);
+    CHECK(state.get_urgent_workspaces().empty() && !state.get_workspace(30)->is_urgent);
+
+    // New workspace is placed on the output which contains its rectangle.
+    apply(2);
+    CHECK(state.get_workspace(50) && state.get_workspace(50)->output == "HDMI-1");
+    CHECK(state.get_workspace(50) && state.get_workspace(50)->num == 4 && !state.get_workspace(50)->is_visible);
+
+    // Renamed workspace gets new number, and its output shows the new name.
+    apply(3);
+    CHECK(state.get_workspace(30)->name == "5: mail" && state.get_workspace(30)->num == 5);
+    CHECK(state.get_outputs().at("eDP-1").current_workspace == "5: mail");
+
+    // Focused workspace moved to the monitor replaces the workspace shown there, while the laptop screen shows
+    // unknown workspace until the next focus event.
+    apply(4);
+    CHECK(state.get_workspace(30)->output == "HDMI-1" && state.get_workspace(30)->is_visible);
+    CHECK(state.get_visible_workspace("HDMI-1") && state.get_visible_workspace("HDMI-1")->id == 30);
+    CHECK(!state.get_workspace(42)->is_visible);
+    CHECK(!state.get_visible_workspace("eDP-1") && !state.get_outputs().at("eDP-1").current_workspace);
+    CHECK(state.get_outputs().at("HDMI-1").current_workspace == "5: mail");
+
+    // Empty workspace is destroyed.
+    apply(5);
+    CHECK(!state.get_workspace(50) && state.get_workspaces().size() == 3);
+    CHECK((results == std::vector<bool>{ true, true, true, true, true, true }));
+
+    // Events which don't tell what changed require new snapshot.
+    CHECK(!state.handle_event(i3_containers::output_event{ i3_containers::output_change::unspecified }));
+    CHECK(!state.handle_event(i3_containers::workspace_event{ i3_containers::workspace_change::reload, std::nullopt,
+                                                              std::nullopt }));
+    state.reset(i3.get_workspaces(), i3.get_outputs());
+    CHECK(state.get_focused_workspace() && state.get_focused_workspace()->id == 20);
+    CHECK(state.get_urgent_workspaces().count(30) == 1 && state.get_workspaces().size() == 3);
+
+    return test_result();
+}